@@ -23,7 +23,8 @@ El programa C++ genera archivos JSON con la siguiente estructura:
             "tiempo_busqueda_mili": float,
             "tiempo_construccion_mili": float,
             "memoria_busqueda_fin_kb": int,
-            "memoria_construccion_fin_kb": int
+            "memoria_construccion_fin_kb": int,
+            "memoria_estructura_bytes": int   (solo estructuras)
         },
         ...
     ]
@@ -202,6 +203,33 @@ class Graficos:
         plt.tight_layout()
         plt.show()
 
+    @staticmethod
+    def memoriaEstructuras(nombres_estructuras: List[str], memorias: List[float]) -> None:
+        """
+        Genera un gráfico de barras con la memoria que cada estructura reporta
+        para sus propios datos (por ejemplo, tabla de ocurrencias frente a
+        wavelet matrix en FM-Index).
+
+        Args:
+            nombres_estructuras: Lista con los nombres de las estructuras de datos.
+            memorias: Lista con la memoria de cada estructura en kilobytes.
+            
+        Returns:
+            None: Muestra el gráfico usando matplotlib.
+            
+        Note:
+            Las estructuras que no reportan su memoria aparecen con 0.
+        """
+        plt.figure(figsize=(10, 5))
+        plt.bar(nombres_estructuras, memorias, color='khaki', edgecolor='olive', alpha=0.7)
+        plt.title("Memoria Propia de cada Estructura", fontsize=14, fontweight='bold')
+        plt.ylabel("Memoria (KB)", fontsize=12)
+        plt.xlabel("Estructuras de Datos", fontsize=12)
+        plt.xticks(rotation=45, ha='right')
+        plt.grid(axis='y', linestyle='--', alpha=0.7)
+        plt.tight_layout()
+        plt.show()
+
     @staticmethod
     def comparacionMemoria(nombres: List[str], mem_busqueda: List[float], mem_construccion: List[float]) -> None:
         """
@@ -311,14 +339,15 @@ def main() -> None:
     nombres_algoritmos = []
     nombres_estructuras = []
     
-    # Arrays para acumular métricas (6 algoritmos/estructuras total)
-    # Índices: 0-2 = Algoritmos (Boyer-Moore, KMP, Robin-Karp)
-    # Índices: 3-5 = Estructuras (FM-Index, Suffix Arrays, Suffix Trees)
-    tiempos_busqueda_acumulados = [0.0] * 6
-    tiempos_construccion_acumulados = [0.0] * 6  
-    tiempos_construccion_estructuras_acumulados = [0.0] * 3  # Solo estructuras
-    memoria_busqueda_acumulada = [0.0] * 6
-    memoria_construccion_acumulada = [0.0] * 6
+    # Arrays para acumular métricas, dimensionados con la primera iteración:
+    # primero los algoritmos (Boyer-Moore, KMP, Robin-Karp) y luego las
+    # estructuras (FM-Index, Suffix Arrays, Suffix Trees, ...)
+    tiempos_busqueda_acumulados = []
+    tiempos_construccion_acumulados = []
+    tiempos_construccion_estructuras_acumulados = []  # Solo estructuras
+    memoria_busqueda_acumulada = []
+    memoria_construccion_acumulada = []
+    memoria_estructuras = []  # No varía entre iteraciones: se toma la última
     
     # Control para detectar cambio de archivo de prueba
     nombre_archivo_anterior = ""
@@ -358,14 +387,15 @@ def main() -> None:
                 Graficos.memoriaBusqueda(nombres_algoritmos, memoria_busqueda_promedio)
                 Graficos.memoriaConstruccion(nombres_algoritmos, memoria_construccion_promedio)
                 Graficos.comparacionMemoria(nombres_algoritmos, memoria_busqueda_promedio, memoria_construccion_promedio)
+                Graficos.memoriaEstructuras(nombres_estructuras, memoria_estructuras)
                 
                 # Reiniciar acumuladores para el nuevo archivo
                 nombre_archivo_anterior = nombre_archivo_actual
-                tiempos_busqueda_acumulados = [0.0] * 6
-                tiempos_construccion_acumulados = [0.0] * 6
-                tiempos_construccion_estructuras_acumulados = [0.0] * 3
-                memoria_busqueda_acumulada = [0.0] * 6
-                memoria_construccion_acumulada = [0.0] * 6
+                tiempos_busqueda_acumulados = [0.0] * len(nombres_algoritmos)
+                tiempos_construccion_acumulados = [0.0] * len(nombres_algoritmos)
+                tiempos_construccion_estructuras_acumulados = [0.0] * len(nombres_estructuras)
+                memoria_busqueda_acumulada = [0.0] * len(nombres_algoritmos)
+                memoria_construccion_acumulada = [0.0] * len(nombres_algoritmos)
 
             # Separar estructuras de datos de algoritmos simples
             metricas_estructuras = [m for m in metricas_algoritmos if m["Tipo"] == "Estructura"]
@@ -374,6 +404,11 @@ def main() -> None:
             if contador_iteraciones == 0:
                 nombres_algoritmos = [m["Nombre"] for m in metricas_algoritmos]
                 nombres_estructuras = [m["Nombre"] for m in metricas_estructuras]
+                tiempos_busqueda_acumulados = [0.0] * len(nombres_algoritmos)
+                tiempos_construccion_acumulados = [0.0] * len(nombres_algoritmos)
+                tiempos_construccion_estructuras_acumulados = [0.0] * len(nombres_estructuras)
+                memoria_busqueda_acumulada = [0.0] * len(nombres_algoritmos)
+                memoria_construccion_acumulada = [0.0] * len(nombres_algoritmos)
 
             # Extraer métricas actuales de todos los algoritmos/estructuras
             tiempos_busqueda_actuales = [m["tiempo_busqueda_mili"] for m in metricas_algoritmos]
@@ -381,17 +416,18 @@ def main() -> None:
             tiempos_construccion_estructuras_actuales = [m["tiempo_construccion_mili"] for m in metricas_estructuras]
             memoria_busqueda_actual = [m["memoria_busqueda_fin_kb"] for m in metricas_algoritmos]
             memoria_construccion_actual = [m["memoria_construccion_fin_kb"] for m in metricas_algoritmos]
+            memoria_estructuras = [m.get("memoria_estructura_bytes", 0) / 1024 for m in metricas_estructuras]
             
             # Acumular métricas para calcular promedios
-            for i in range(6):  # 6 algoritmos/estructuras en total
+            for i in range(len(nombres_algoritmos)):
                 tiempos_busqueda_acumulados[i] += tiempos_busqueda_actuales[i]
                 tiempos_construccion_acumulados[i] += tiempos_construccion_actuales[i]
                 memoria_busqueda_acumulada[i] += memoria_busqueda_actual[i]
                 memoria_construccion_acumulada[i] += memoria_construccion_actual[i]
                 
-                # Acumular tiempos de construcción solo para estructuras (primeras 3)
-                if i < 3:
-                    tiempos_construccion_estructuras_acumulados[i] += tiempos_construccion_estructuras_actuales[i]
+            # Acumular tiempos de construcción solo para estructuras
+            for i in range(len(nombres_estructuras)):
+                tiempos_construccion_estructuras_acumulados[i] += tiempos_construccion_estructuras_actuales[i]
                     
             contador_iteraciones += 1
             
@@ -417,6 +453,7 @@ def main() -> None:
         Graficos.memoriaBusqueda(nombres_algoritmos, memoria_busqueda_promedio)
         Graficos.memoriaConstruccion(nombres_algoritmos, memoria_construccion_promedio)
         Graficos.comparacionMemoria(nombres_algoritmos, memoria_busqueda_promedio, memoria_construccion_promedio)
+        Graficos.memoriaEstructuras(nombres_estructuras, memoria_estructuras)
     
     print("Análisis completado. Todos los gráficos han sido generados.")
 
@@ -0,0 +1,339 @@
+/**
+ * @file archivo_mapeado.hpp
+ * @brief Utilidades para guardar estructuras en disco y cargarlas con mmap.
+ * 
+ * Contiene el arreglo plano que puede ser dueño de sus datos o apuntar a una
+ * región mapeada en memoria, el envoltorio RAII del archivo mapeado y las
+ * clases para escribir y leer secciones binarias alineadas.
+ * 
+ * El formato de cada arreglo en disco es: cantidad de elementos (uint64_t),
+ * relleno hasta ALINEACION_ARCHIVO bytes y luego los elementos en crudo.
+ * Así, al mapear el archivo, cada arreglo queda alineado y puede usarse
+ * directamente sin copiar ni deserializar nada.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Alineación en bytes de cada arreglo dentro de un archivo de índice.
+ * 
+ * Coincide con el tamaño de una línea de caché, de modo que los bloques
+ * de las estructuras de rango queden alineados al mapearse.
+ */
+const size_t ALINEACION_ARCHIVO = 64;
+
+/**
+ * @class AsignadorAlineado
+ * @brief Asignador que entrega memoria alineada a ALINEACION_ARCHIVO bytes.
+ * 
+ * Los arreglos propios quedan alineados igual que los mapeados desde disco,
+ * de modo que un bloque de 64 bytes de una estructura de rango ocupa
+ * exactamente una línea de caché en ambos casos.
+ * 
+ * @tparam T Tipo de los elementos.
+ */
+template <typename T>
+class AsignadorAlineado {
+    public:
+        using value_type = T;
+
+        AsignadorAlineado() noexcept = default;
+
+        template <typename U>
+        AsignadorAlineado(const AsignadorAlineado<U>&) noexcept {}
+
+        T* allocate(size_t cantidad) {
+            return static_cast<T*>(::operator new(cantidad * sizeof(T), std::align_val_t(ALINEACION_ARCHIVO)));
+        }
+
+        void deallocate(T* puntero, size_t) noexcept {
+            ::operator delete(puntero, std::align_val_t(ALINEACION_ARCHIVO));
+        }
+
+        template <typename U>
+        bool operator==(const AsignadorAlineado<U>&) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const AsignadorAlineado<U>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Vector cuyos datos comienzan en una dirección alineada a ALINEACION_ARCHIVO.
+ */
+template <typename T>
+using VectorAlineado = std::vector<T, AsignadorAlineado<T>>;
+
+/**
+ * @class ArregloPlano
+ * @brief Arreglo de solo lectura que es dueño de sus datos o los toma de un archivo mapeado.
+ * 
+ * Las estructuras construidas en memoria usan un VectorAlineado propio; las
+ * cargadas desde disco apuntan directamente a la región mapeada. En ambos
+ * casos el acceso es un puntero plano alineado a ALINEACION_ARCHIVO, sin
+ * indirecciones adicionales.
+ * 
+ * @tparam T Tipo trivialmente copiable de los elementos.
+ * 
+ * @note La región mapeada debe sobrevivir al arreglo; quien lo mapea es
+ *       responsable de mantener vivo el ArchivoMapeado.
+ */
+template <typename T>
+class ArregloPlano {
+    static_assert(std::is_trivially_copyable<T>::value, "ArregloPlano requiere tipos trivialmente copiables");
+
+    public:
+        ArregloPlano() = default;
+
+        /**
+         * @brief Construye un arreglo dueño de los valores dados.
+         * @param valores Valores que pasan a pertenecer al arreglo.
+         */
+        explicit ArregloPlano(VectorAlineado<T> valores) : propio_(std::move(valores)) {
+            actualizarPropio();
+        }
+
+        /**
+         * @brief Construye un arreglo dueño de una copia alineada de los valores dados.
+         * @param valores Valores a copiar.
+         */
+        explicit ArregloPlano(const std::vector<T>& valores) : propio_(valores.begin(), valores.end()) {
+            actualizarPropio();
+        }
+
+        ArregloPlano(const ArregloPlano& otro) : propio_(otro.propio_), datos_(otro.datos_), tamanio_(otro.tamanio_), mapeado_(otro.mapeado_) {
+            if (!mapeado_) actualizarPropio();
+        }
+
+        ArregloPlano(ArregloPlano&& otro) noexcept : propio_(std::move(otro.propio_)), datos_(otro.datos_), tamanio_(otro.tamanio_), mapeado_(otro.mapeado_) {
+            if (!mapeado_) actualizarPropio();
+        }
+
+        ArregloPlano& operator=(const ArregloPlano& otro) {
+            ArregloPlano copia(otro);
+            *this = std::move(copia);
+            return *this;
+        }
+
+        ArregloPlano& operator=(ArregloPlano&& otro) noexcept {
+            propio_ = std::move(otro.propio_);
+            datos_ = otro.datos_;
+            tamanio_ = otro.tamanio_;
+            mapeado_ = otro.mapeado_;
+            if (!mapeado_) actualizarPropio();
+            return *this;
+        }
+
+        /**
+         * @brief Hace que el arreglo apunte a datos externos (región mapeada).
+         * @param datos Puntero al primer elemento.
+         * @param tamanio Cantidad de elementos.
+         */
+        void mapear(const T* datos, size_t tamanio) {
+            propio_.clear();
+            propio_.shrink_to_fit();
+            datos_ = datos;
+            tamanio_ = tamanio;
+            mapeado_ = true;
+        }
+
+        const T& operator[](size_t i) const { return datos_[i]; }
+        const T* data() const { return datos_; }
+        size_t size() const { return tamanio_; }
+        bool empty() const { return tamanio_ == 0; }
+        const T& back() const { return datos_[tamanio_ - 1]; }
+        const T* begin() const { return datos_; }
+        const T* end() const { return datos_ + tamanio_; }
+
+        /**
+         * @brief Indica si los datos provienen de un archivo mapeado.
+         */
+        bool estaMapeado() const { return mapeado_; }
+
+        /**
+         * @brief Bytes ocupados por los elementos (propios o mapeados).
+         */
+        size_t getMemoriaBytes() const { return tamanio_ * sizeof(T); }
+
+    private:
+        void actualizarPropio() {
+            datos_ = propio_.data();
+            tamanio_ = propio_.size();
+        }
+
+        VectorAlineado<T> propio_;
+        const T* datos_ = nullptr;
+        size_t tamanio_ = 0;
+        bool mapeado_ = false;
+};
+
+/**
+ * @class ArchivoMapeado
+ * @brief Envoltorio RAII de un archivo mapeado en memoria en modo solo lectura.
+ * 
+ * El mapeo es compartido: varios procesos que mapean el mismo archivo usan
+ * las mismas páginas del page cache, y las páginas se cargan de forma
+ * perezosa a medida que las consultas las tocan.
+ */
+class ArchivoMapeado {
+    public:
+        /**
+         * @brief Mapea el archivo completo en memoria.
+         * @param ruta Ruta del archivo a mapear.
+         * @throws std::runtime_error Si el archivo no puede abrirse o mapearse.
+         */
+        explicit ArchivoMapeado(const std::string& ruta);
+
+        /**
+         * @brief Libera el mapeo.
+         */
+        ~ArchivoMapeado();
+
+        ArchivoMapeado(const ArchivoMapeado&) = delete;
+        ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+        const char* getDatos() const { return datos_; }
+        size_t getTamanio() const { return tamanio_; }
+
+    private:
+        const char* datos_ = nullptr;
+        size_t tamanio_ = 0;
+#ifdef _WIN32
+        void* manejador_archivo_ = nullptr;
+        void* manejador_mapeo_ = nullptr;
+#endif
+};
+
+/**
+ * @class EscritorBinario
+ * @brief Escribe valores y arreglos alineados en un archivo de índice.
+ */
+class EscritorBinario {
+    public:
+        /**
+         * @brief Abre (o trunca) el archivo de salida.
+         * @param ruta Ruta del archivo.
+         * @throws std::runtime_error Si el archivo no puede abrirse.
+         */
+        explicit EscritorBinario(const std::string& ruta) : salida_(ruta, std::ios::binary | std::ios::trunc) {
+            if (!salida_) throw std::runtime_error("No se pudo abrir el archivo para escritura: " + ruta);
+        }
+
+        /**
+         * @brief Escribe un valor trivialmente copiable tal como está en memoria.
+         */
+        template <typename T>
+        void escribir(const T& valor) {
+            static_assert(std::is_trivially_copyable<T>::value, "Solo se escriben tipos trivialmente copiables");
+            salida_.write(reinterpret_cast<const char*>(&valor), sizeof(T));
+            posicion_ += sizeof(T);
+        }
+
+        /**
+         * @brief Escribe un arreglo: cantidad de elementos, relleno y datos.
+         */
+        template <typename T>
+        void escribirArreglo(const T* datos, size_t cantidad) {
+            escribir(static_cast<uint64_t>(cantidad));
+            rellenar();
+            salida_.write(reinterpret_cast<const char*>(datos), static_cast<std::streamsize>(cantidad * sizeof(T)));
+            posicion_ += cantidad * sizeof(T);
+            rellenar();
+        }
+
+        template <typename T>
+        void escribirArreglo(const ArregloPlano<T>& arreglo) {
+            escribirArreglo(arreglo.data(), arreglo.size());
+        }
+
+        /**
+         * @brief Vacía el archivo y verifica que todo se haya escrito.
+         * @throws std::runtime_error Si ocurrió un error de escritura.
+         */
+        void cerrar() {
+            salida_.flush();
+            if (!salida_) throw std::runtime_error("Error escribiendo el archivo de índice");
+            salida_.close();
+        }
+
+    private:
+        void rellenar() {
+            static const char ceros[ALINEACION_ARCHIVO] = {};
+            size_t resto = posicion_ % ALINEACION_ARCHIVO;
+            if (resto == 0) return;
+            salida_.write(ceros, static_cast<std::streamsize>(ALINEACION_ARCHIVO - resto));
+            posicion_ += ALINEACION_ARCHIVO - resto;
+        }
+
+        std::ofstream salida_;
+        size_t posicion_ = 0;
+};
+
+/**
+ * @class LectorMapeado
+ * @brief Recorre un archivo mapeado leyendo valores y enlazando arreglos sin copiarlos.
+ */
+class LectorMapeado {
+    public:
+        explicit LectorMapeado(const ArchivoMapeado& archivo)
+            : inicio_(archivo.getDatos()), fin_(archivo.getDatos() + archivo.getTamanio()), cursor_(archivo.getDatos()) {}
+
+        /**
+         * @brief Lee un valor trivialmente copiable.
+         * @throws std::runtime_error Si el archivo termina antes de tiempo.
+         */
+        template <typename T>
+        T leer() {
+            verificarDisponible(sizeof(T));
+            T valor;
+            std::memcpy(&valor, cursor_, sizeof(T));
+            cursor_ += sizeof(T);
+            return valor;
+        }
+
+        /**
+         * @brief Enlaza un arreglo escrito con EscritorBinario::escribirArreglo.
+         * @param[out] arreglo Arreglo que pasará a apuntar a la región mapeada.
+         * @throws std::runtime_error Si el arreglo excede el tamaño del archivo.
+         */
+        template <typename T>
+        void mapearArreglo(ArregloPlano<T>& arreglo) {
+            uint64_t cantidad = leer<uint64_t>();
+            saltarRelleno();
+            if (cantidad > static_cast<uint64_t>(fin_ - cursor_) / sizeof(T)) {
+                throw std::runtime_error("Archivo de índice corrupto: arreglo fuera de rango");
+            }
+            arreglo.mapear(reinterpret_cast<const T*>(cursor_), static_cast<size_t>(cantidad));
+            cursor_ += cantidad * sizeof(T);
+            saltarRelleno();
+        }
+
+    private:
+        void verificarDisponible(size_t bytes) const {
+            if (static_cast<size_t>(fin_ - cursor_) < bytes) {
+                throw std::runtime_error("Archivo de índice corrupto: fin de archivo inesperado");
+            }
+        }
+
+        void saltarRelleno() {
+            size_t resto = static_cast<size_t>(cursor_ - inicio_) % ALINEACION_ARCHIVO;
+            if (resto == 0) return;
+            verificarDisponible(ALINEACION_ARCHIVO - resto);
+            cursor_ += ALINEACION_ARCHIVO - resto;
+        }
+
+        const char* inicio_;
+        const char* fin_;
+        const char* cursor_;
+};
@@ -0,0 +1,247 @@
+/**
+ * @file benchmarks.hpp
+ * @brief Microbenchmarks de los componentes internos de las estructuras.
+ * 
+ * A diferencia de las mediciones de medidor.hpp, que comparan algoritmos y
+ * estructuras completas sobre los textos de prueba, estos benchmarks miden
+ * operaciones individuales (por ejemplo, rango y selección de BitVector)
+ * con muchas consultas aleatorias y reportan nanosegundos por operación.
+ * 
+ * Los resultados se guardan en test/json/<modo>/ para no mezclarse con los
+ * JSON que procesa analisis.py.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <cstdint>
+
+/**
+ * @brief Mide rango y selección de BitVector para tamaños de 1e6 bits hasta max_bits.
+ * 
+ * Los tamaños crecen en potencias de 10. Para cada tamaño se construye un
+ * vector aleatorio con densidad 1/2 y otro con densidad 1/16, y se miden
+ * rango1, seleccionar1 y seleccionar0 con consultas aleatorias precalculadas.
+ * 
+ * @param max_bits Tamaño máximo del vector en bits (1e10 ocupa ~1.6 GB).
+ * @throws std::runtime_error Si no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkBitVector(uint64_t max_bits);
+
+/**
+ * @brief Compara buscar() patrón por patrón con buscarLote() en FMIndex.
+ * 
+ * Construye un FMIndex (tabla de ocurrencias y wavelet matrix) sobre un
+ * texto aleatorio de alfabeto ACGT y cuenta CONSULTAS_MICROBENCHMARK
+ * patrones de 12 caracteres, la mitad tomados del texto. Reporta
+ * nanosegundos por patrón de ambas variantes; los conteos deben coincidir.
+ * 
+ * @param longitud_texto Largo del texto aleatorio.
+ * @throws std::runtime_error Si los conteos difieren o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkLote(size_t longitud_texto);
+
+/**
+ * @brief Mide CacheConsultas sobre FMIndex con consultas de distribución Zipf.
+ * 
+ * Construye un FMIndex sobre un texto aleatorio de alfabeto ACGT, arma un
+ * vocabulario de PATRONES_DISTINTOS_CACHE patrones (la mitad tomados del
+ * texto) y genera CONSULTAS_MICROBENCHMARK consultas donde el patrón de
+ * rango k aparece con probabilidad proporcional a 1/k^s. Compara el índice
+ * sin caché con cachés de distintas capacidades y una con vencimiento, y
+ * reporta nanosegundos por consulta y tasa de aciertos.
+ * 
+ * @param longitud_texto Largo del texto aleatorio.
+ * @param exponente_zipf Exponente s de la distribución (1 es el típico de consultas reales).
+ * @throws std::runtime_error Si los conteos con caché difieren o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkCache(size_t longitud_texto, double exponente_zipf);
+
+/**
+ * @brief Mide consultas por segundo con varios hilos sobre un mismo índice.
+ * 
+ * Construye FMIndex (tabla de ocurrencias y wavelet matrix) y SuffixArrays
+ * sobre un texto aleatorio de alfabeto ACGT y los comparte, sin copiarlos
+ * ni sincronizarlos, entre 1, 2, 4, ... hasta max_hilos hilos lectores que
+ * se reparten CONSULTAS_MICROBENCHMARK patrones. Reporta consultas por
+ * segundo, aceleración y eficiencia respecto de un hilo: cuando la
+ * eficiencia cae, el ancho de banda de memoria está saturado.
+ * 
+ * Cada hilo compara sus conteos con los de la ejecución secuencial, de modo
+ * que un estado mutable compartido oculto en una estructura aparece como
+ * diferencia.
+ * 
+ * Al final, max_hilos hilos llaman a la vez a medirEstructura y
+ * medirAlgoritmo sobre un prefijo del texto y se verifica que el medidor
+ * registre un resultado completo y propio por cada medición.
+ * 
+ * @param longitud_texto Largo del texto aleatorio.
+ * @param max_hilos Cantidad máxima de hilos (siempre se mide también este valor).
+ * @throws std::runtime_error Si algún hilo obtiene un conteo distinto, el medidor registra un resultado
+ *         erróneo o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkConcurrente(size_t longitud_texto, size_t max_hilos);
+
+/**
+ * @brief Mide el rendimiento de contarParalelo con 1, 2, 4, ... hasta max_hilos hilos.
+ * 
+ * Genera un texto aleatorio de alfabeto ACGT y cuenta un patrón de 12
+ * caracteres tomado del texto con Boyer-Moore, KMP (con tabla de fallas y
+ * con autómata), Robin-Karp y Two-Way, primero con el motor secuencial
+ * sobre todo el texto y luego por segmentos.
+ * Reporta GB/s de texto escaneado y la aceleración respecto del motor
+ * secuencial.
+ * 
+ * Antes de medir cada motor verifica que un mismo pool atienda a la vez a
+ * dos hilos que cuentan y a uno cuyas tareas fallan sin mezclar conteos ni
+ * excepciones, y que una tarea del pool pueda volver a usarlo.
+ * 
+ * @param longitud_texto Largo del texto aleatorio (varios GB para medir el ancho de banda).
+ * @param max_hilos Cantidad máxima de hilos (siempre se mide también este valor).
+ * @throws std::runtime_error Si un conteo por segmentos difiere del secuencial, el pool mezcla lotes
+ *         concurrentes o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkEscaneo(size_t longitud_texto, size_t max_hilos);
+
+/**
+ * @brief Mide cada fase de la construcción del FM-Index con 1 a max_hilos hilos.
+ * 
+ * Sobre un texto aleatorio de ADN mide, para 1, 2, 4, ..., max_hilos
+ * hilos, el arreglo de sufijos, la BWT, la tabla C, la tabla de
+ * ocurrencias y el FMIndex completo desde la transformada (tabla C,
+ * muestras y ocurrencias), con la aceleración respecto de un hilo.
+ * Verifica que la BWT sea la misma con cualquier cantidad de hilos.
+ * 
+ * @param longitud_texto Largo del texto.
+ * @param max_hilos Mayor cantidad de hilos medida.
+ * @throws std::runtime_error Si la BWT difiere o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkConstruccion(size_t longitud_texto, size_t max_hilos);
+
+/**
+ * @brief Compara la construcción del FM-Index en memoria externa con la construcción en memoria.
+ * 
+ * Escribe un texto aleatorio de ADN en la carpeta de temporales, lo indexa
+ * con FMIndex::construirExterno y luego leyéndolo completo con el
+ * constructor habitual. Informa el tiempo de cada una y cuánto creció el
+ * pico de memoria del proceso (primero la externa, porque el pico solo
+ * crece), y verifica que ambos índices cuenten igual.
+ * 
+ * Además construye la BWT de un texto de σ = 192 con un carácter dominante
+ * y un presupuesto de n/16 sufijos, y verifica que ninguna pasada lo exceda.
+ * 
+ * @param longitud_texto Largo del texto.
+ * @param memoria_mb Presupuesto de la construcción externa en MiB.
+ * @throws std::runtime_error Si los conteos o las BWT difieren, una pasada excede el presupuesto
+ *         o no se pueden escribir los archivos.
+ */
+void ejecutarBenchmarkExterna(size_t longitud_texto, size_t memoria_mb);
+
+/**
+ * @brief Compara la búsqueda estática con el patrón preprocesado en muchos textos cortos.
+ * 
+ * Genera cantidad_lineas líneas aleatorias de 100 bytes
+ * (como líneas de log) y cuenta en cada una un patrón corto con
+ * Boyer-Moore, KMP y Robin-Karp: primero con buscar(), que preprocesa el
+ * patrón en cada llamada, y luego con PatronBoyerMoore,
+ * PatronKnuthMorrisPratt y PatronRobinKarp construidos una sola vez.
+ * Reporta nanosegundos por línea y la aceleración: con textos cortos el
+ * preprocesamiento de cada llamada pesa tanto como el recorrido, por lo
+ * que conviene preprocesar una vez el patrón que se busca en muchos textos.
+ * 
+ * @param cantidad_lineas Cantidad de líneas en que se busca.
+ * @throws std::runtime_error Si los conteos difieren o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkLineas(size_t cantidad_lineas);
+
+/**
+ * @brief Mide los algoritmos en línea con entradas adversarias.
+ * 
+ * Sobre un texto de solo 'a' cuenta patrones periódicos de largo 10, 100 y
+ * 1000: a...ab (discrepancia al final), ba...a (discrepancia al comienzo,
+ * el peor caso de Boyer-Moore) y a...a (una ocurrencia en cada posición).
+ * Reporta nanosegundos por byte de texto: los algoritmos lineales en el
+ * peor caso (KMP, Two-Way) se mantienen constantes al crecer el patrón.
+ * 
+ * @param longitud_texto Largo del texto.
+ * @throws std::runtime_error Si los conteos difieren o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkPeorCaso(size_t longitud_texto);
+
+/**
+ * @brief Compara la búsqueda aproximada de Myers con la exacta sobre los textos de prueba.
+ * 
+ * Para cada archivo toma patrones de 16 y 100 caracteres del propio texto
+ * (el segundo ocupa dos bloques de 64 bits) y mide Knuth-Morris-Pratt,
+ * Boyer-Moore y PatronMyers con k = 0, 1, ..., maximo_ediciones. Reporta
+ * MB/s y las ocurrencias de cada k; con k = 0 el conteo debe coincidir con
+ * el exacto.
+ * 
+ * @param rutas Archivos de texto a recorrer.
+ * @param maximo_ediciones Mayor k medido.
+ * @throws std::runtime_error Si con k = 0 el conteo difiere del exacto o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkAproximada(const std::vector<std::string>& rutas, unsigned int maximo_ediciones);
+
+/**
+ * @brief Mide FMIndex con tablas de k-mers de distinto largo sobre los textos de prueba.
+ * 
+ * Para cada archivo construye el índice con k = 0, 3, 4, 6 y 8 y cuenta los
+ * mismos patrones tomados del texto. Reporta nanosegundos por patrón, la
+ * aceleración respecto de k = 0 y los bytes de la tabla, que guarda solo
+ * los k-mers que aparecen en el texto.
+ * 
+ * @param rutas Archivos de texto a indexar.
+ * @param largo_patron Largo de los patrones consultados.
+ * @throws std::invalid_argument Si un texto tiene más k-mers distintos de los que admite la tabla.
+ * @throws std::runtime_error Si una tabla cambia los conteos o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkKmer(const std::vector<std::string>& rutas, size_t largo_patron);
+
+/**
+ * @brief Compara la búsqueda aproximada del FM-Index bidireccional con recorrer el texto.
+ * 
+ * Construye FMIndexBidireccional sobre un texto aleatorio de ADN y busca
+ * 100 patrones de 32 caracteres con k = 0, 1, ..., maximo_errores
+ * sustituciones y ediciones. Reporta milisegundos por patrón del índice y
+ * de un recorrido del texto (Hamming directo y PatronMyers sobre el texto
+ * invertido), que además verifica los conteos de los primeros patrones.
+ * 
+ * @param longitud_texto Largo del texto.
+ * @param maximo_errores Mayor k medido (menor que 32).
+ * @throws std::runtime_error Si un conteo difiere del recorrido o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkBidireccional(size_t longitud_texto, uint32_t maximo_errores);
+
+/**
+ * @brief Mide la ingesta por bloques de FMIndexIncremental contra reconstruir el índice completo.
+ * 
+ * Agrega un texto aleatorio de ADN en bloques de tamano_bloque bytes y, cada
+ * vez que el texto duplica su largo, reporta los nanosegundos por byte de
+ * agregar() (incluida la espera de las fusiones), los bytes reconstruidos
+ * por byte y los segmentos, junto con lo que tardaría construir un FMIndex
+ * sobre todo el texto. Verifica buscar() contra Knuth-Morris-Pratt.
+ * 
+ * @param longitud_total Bytes agregados en total.
+ * @param tamano_bloque Bytes de cada llamada a agregar() (mayor que 0).
+ * @throws std::runtime_error Si un conteo difiere del recorrido o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkIncremental(size_t longitud_total, size_t tamano_bloque);
+
+/**
+ * @brief Consulta un patrón por documento en un único índice sobre todos los archivos.
+ * 
+ * Construye IndiceDocumentos sobre los archivos dados y mide el conteo por
+ * documento, el listado de documentos y los k documentos con más
+ * ocurrencias, contra recorrer cada archivo con Knuth-Morris-Pratt (que
+ * además verifica los conteos). Imprime los k documentos más frecuentes.
+ * 
+ * @param rutas Archivos que forman la colección (el índice de cada uno es su documento).
+ * @param patron Patrón a consultar.
+ * @param k Cantidad de documentos más frecuentes.
+ * @throws std::runtime_error Si los conteos difieren o no se puede escribir el archivo de resultados.
+ */
+void ejecutarBenchmarkDocumentos(const std::vector<std::string>& rutas, const std::string& patron, size_t k);
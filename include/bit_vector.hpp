@@ -0,0 +1,198 @@
+/**
+ * @file bit_vector.hpp
+ * @brief Vector de bits sucinto con rango y selección en tiempo constante.
+ * 
+ * Contiene la clase BitVector, base de las estructuras sucintas del
+ * proyecto (niveles de WaveletMatrix, marcas de muestreo del arreglo de
+ * sufijos, etc.).
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "archivo_mapeado.hpp"
+
+#include <cstdint>
+
+/**
+ * @brief Bits de cada superbloque del directorio de rango (una línea de caché de datos).
+ */
+const size_t BITS_POR_BLOQUE_RANGO = 512;
+
+/**
+ * @brief Cada cuántos unos (o ceros) se guarda una muestra para selección.
+ */
+const size_t MUESTREO_SELECCION = 4096;
+
+/**
+ * @class BitVector
+ * @brief Vector de bits estático con rango y selección.
+ * 
+ * Disposición rank9 (Vigna): los bits se agrupan en superbloques de
+ * BITS_POR_BLOQUE_RANGO bits, es decir, ocho palabras de 64 bits alineadas
+ * a una línea de caché. Por cada superbloque el directorio guarda dos
+ * palabras contiguas:
+ * - La cantidad absoluta de unos antes del superbloque.
+ * - Siete conteos relativos de 9 bits, uno por cada palabra del superbloque
+ *   salvo la primera.
+ * 
+ * Un rango lee una entrada del directorio, una palabra de datos y hace un
+ * popcount por hardware. La selección parte de una muestra cada
+ * MUESTREO_SELECCION unos (o ceros), busca el superbloque con los conteos
+ * absolutos, la palabra con los relativos y el bit dentro de la palabra
+ * (con pdep si el procesador tiene BMI2).
+ * 
+ * Complejidad temporal:
+ * - Construcción: O(n / 64)
+ * - Rango: O(1)
+ * - Selección: O(log b) donde b es la cantidad de superbloques entre dos muestras
+ * 
+ * Complejidad espacial: n bits + 25% de directorio de rango + una palabra
+ * cada MUESTREO_SELECCION unos y ceros
+ */
+class BitVector {
+    public:
+        BitVector() = default;
+
+        /**
+         * @brief Construye el vector a partir de sus palabras.
+         * 
+         * @param palabras Bits empaquetados; el bit i está en palabras[i / 64], posición i % 64.
+         * @param cantidad_bits Cantidad de bits válidos.
+         */
+        BitVector(VectorAlineado<uint64_t> palabras, size_t cantidad_bits);
+
+        /**
+         * @brief Retorna el bit en la posición i.
+         */
+        bool acceder(size_t i) const {
+            return (palabras_[i / 64] >> (i % 64)) & 1ULL;
+        }
+
+        /**
+         * @brief Cuenta los unos en las posiciones [0, i).
+         * 
+         * @param i Largo del prefijo (0 <= i <= n).
+         * @return Cantidad de unos.
+         * 
+         * @complexity
+         * - Tiempo: O(1)
+         */
+        size_t rango1(size_t i) const {
+            size_t palabra = i / 64;
+            size_t bloque = palabra / 8;
+
+            // En la primera palabra del bloque t + 8 = 7 desplaza 63 bits y el relativo es 0
+            uint64_t t = static_cast<uint64_t>(palabra % 8) - 1;
+            uint64_t relativo = (directorio_[2 * bloque + 1] >> ((t + ((t >> 60) & 8)) * 9)) & 0x1FF;
+
+            uint64_t mascara = (1ULL << (i % 64)) - 1;
+            return static_cast<size_t>(directorio_[2 * bloque] + relativo
+                                       + static_cast<uint64_t>(__builtin_popcountll(palabras_[palabra] & mascara)));
+        }
+
+        /**
+         * @brief Solicita al procesador las líneas de caché que leerá rango1(i).
+         * 
+         * Permite solapar la latencia de memoria de varias consultas
+         * independientes (ver FMIndex::buscarLote).
+         */
+        void precargar(size_t i) const {
+            __builtin_prefetch(directorio_.data() + 2 * (i / BITS_POR_BLOQUE_RANGO));
+            __builtin_prefetch(palabras_.data() + i / 64);
+        }
+
+        /**
+         * @brief Cuenta los ceros en las posiciones [0, i).
+         */
+        size_t rango0(size_t i) const { return i - rango1(i); }
+
+        /**
+         * @brief Posición del k-ésimo uno.
+         * 
+         * @param k Número del uno buscado (1 <= k <= contarUnos()).
+         * @return Posición p tal que acceder(p) es 1 y rango1(p) es k - 1.
+         * @throws std::out_of_range Si k está fuera de rango.
+         * 
+         * @complexity
+         * - Tiempo: O(1) en la práctica (ver la clase)
+         */
+        size_t seleccionar1(size_t k) const;
+
+        /**
+         * @brief Posición del k-ésimo cero.
+         * 
+         * @param k Número del cero buscado (1 <= k <= contarCeros()).
+         * @return Posición p tal que acceder(p) es 0 y rango0(p) es k - 1.
+         * @throws std::out_of_range Si k está fuera de rango.
+         */
+        size_t seleccionar0(size_t k) const;
+
+        /**
+         * @brief Cantidad de bits.
+         */
+        size_t size() const { return cantidad_bits_; }
+
+        /**
+         * @brief Cantidad total de unos.
+         */
+        size_t contarUnos() const { return cantidad_unos_; }
+
+        /**
+         * @brief Cantidad total de ceros.
+         */
+        size_t contarCeros() const { return cantidad_bits_ - cantidad_unos_; }
+
+        /**
+         * @brief Bytes ocupados por los bits, el directorio de rango y las muestras de selección.
+         */
+        size_t getMemoriaBytes() const;
+
+        /**
+         * @brief Escribe el vector en un archivo de índice.
+         */
+        void serializar(EscritorBinario& escritor) const;
+
+        /**
+         * @brief Enlaza el vector a un archivo de índice mapeado.
+         * @throws std::runtime_error Si la sección está corrupta.
+         */
+        void mapear(LectorMapeado& lector);
+
+    private:
+        /**
+         * @brief Unos en las primeras j palabras del superbloque (0 <= j < 8).
+         */
+        uint64_t unosRelativos(size_t bloque, size_t j) const {
+            return j == 0 ? 0 : (directorio_[2 * bloque + 1] >> ((j - 1) * 9)) & 0x1FF;
+        }
+
+        /**
+         * @brief Ceros antes del superbloque, contando el relleno final como ceros.
+         */
+        uint64_t cerosAntesDeBloque(size_t bloque) const {
+            return static_cast<uint64_t>(bloque) * BITS_POR_BLOQUE_RANGO - directorio_[2 * bloque];
+        }
+
+        ArregloPlano<uint64_t> palabras_;
+
+        /**
+         * @brief Por superbloque: unos absolutos y conteos relativos empaquetados.
+         */
+        ArregloPlano<uint64_t> directorio_;
+
+        /**
+         * @brief Superbloque del uno número k·MUESTREO_SELECCION + 1, más un centinela final.
+         */
+        ArregloPlano<uint64_t> muestras_unos_;
+
+        /**
+         * @brief Superbloque del cero número k·MUESTREO_SELECCION + 1, más un centinela final.
+         */
+        ArregloPlano<uint64_t> muestras_ceros_;
+
+        size_t cantidad_bits_ = 0;
+        size_t cantidad_unos_ = 0;
+};
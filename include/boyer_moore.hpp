@@ -4,7 +4,8 @@
  * 
  * Contiene la clase BoyerMoore que implementa el algoritmo de búsqueda
  * de patrones Boyer-Moore, conocido por su eficiencia en textos largos
- * y patrones de tamaño considerable.
+ * y patrones de tamaño considerable, y PatronBoyerMoore, el patrón ya
+ * preprocesado para buscarlo en muchos textos.
  * 
  * @date 2025
  */
@@ -12,6 +13,10 @@
 #pragma once
 
 #include "definiciones.hpp"
+#include "plegado_caso.hpp"
+
+#include <array>
+#include <string_view>
 
 /**
  * @class BoyerMoore
@@ -20,15 +25,17 @@
  * El algoritmo Boyer-Moore es uno de los algoritmos de búsqueda de cadenas
  * más eficientes, especialmente para patrones largos. Esta implementación
  * utiliza una versión simplificada que emplea principalmente:
- * - Bad Character Rule simplificada: salta caracteres basándose en discrepancias
+ * - Bad Character Rule con la última aparición de cada byte en el patrón
  * - Comparación de derecha a izquierda en el patrón
+ * - Conteo de todas las ocurrencias, incluidas las solapadas
+ * - Variante sin distinción de mayúsculas que compara caracteres plegados
  * 
  * Complejidad temporal:
  * - Mejor caso: O(n/m) donde n es el tamaño del texto y m del patrón
  * - Caso promedio: O(n)
  * - Peor caso: O(n*m)
  * 
- * Complejidad espacial: O(1) - no usa tablas de pre-cómputo extensas
+ * Complejidad espacial: O(σ) - una tabla de 256 posiciones
  */
 class BoyerMoore {
     public:
@@ -36,20 +43,83 @@ class BoyerMoore {
          * @brief Busca un patrón en un texto utilizando el algoritmo de Boyer-Moore.
          * 
          * Este método implementa una versión simplificada del algoritmo Boyer-Moore.
-         * Compara el patrón de derecha a izquierda y usa una heurística básica
-         * de salto cuando encuentra discrepancias.
+         * Compara el patrón de derecha a izquierda y, ante una discrepancia,
+         * alinea el byte discrepante del texto con su última aparición en el
+         * patrón.
          * 
          * @param texto Texto donde se realizará la búsqueda.
          * @param patron Patrón a buscar en el texto.
          * @return Cantidad de ocurrencias encontradas del patrón en el texto.
          * 
-         * @note Implementación simplificada sin tablas de pre-cómputo completas.
+         * @note Implementación simplificada sin la regla del buen sufijo.
+         * @note Cuenta las ocurrencias solapadas, igual que los demás algoritmos.
          * @note Es sensible a mayúsculas y minúsculas.
          * @note Más eficiente con patrones largos que con cortos.
          * 
          * @complexity
          * - Tiempo: O(n) en promedio, O(n*m) en el peor caso
-         * - Espacio: O(1) sin tablas de pre-cómputo
+         * - Espacio: O(σ) para la tabla de últimas apariciones
          */
         static unsigned int buscar(const std::string& texto, const std::string& patron);
+
+        /**
+         * @brief Igual que buscar(), sin distinguir mayúsculas de minúsculas (ASCII).
+         * 
+         * El patrón se pliega una vez y cada carácter del texto se pliega al
+         * compararlo, con el mismo costo que la búsqueda exacta.
+         * 
+         * @param texto Texto donde se realizará la búsqueda.
+         * @param patron Patrón a buscar en el texto.
+         * @return Cantidad de ocurrencias encontradas del patrón en el texto.
+         */
+        static unsigned int buscarSinMayusculas(const std::string& texto, const std::string& patron);
+
+        /**
+         * @brief Igual que buscar(), sobre un segmento del texto sin copiarlo (MotorSegmento).
+         */
+        static unsigned int buscarEnSegmento(std::string_view segmento, const std::string& patron);
+};
+
+/**
+ * @class PatronBoyerMoore
+ * @brief Patrón preprocesado para Boyer-Moore, reutilizable en muchos textos.
+ * 
+ * Guarda el patrón (plegado si corresponde) y la última aparición de cada
+ * byte en él, calculadas una vez en O(m + σ). buscar() solo alinea el
+ * patrón con el texto y salta según esa tabla, sin reservar memoria.
+ */
+class PatronBoyerMoore {
+    public:
+        /**
+         * @brief Preprocesa el patrón.
+         * 
+         * @param patron Patrón a buscar.
+         * @param ignorar_mayusculas Comparar sin distinguir mayúsculas de minúsculas (ASCII).
+         */
+        explicit PatronBoyerMoore(const std::string& patron, bool ignorar_mayusculas = false);
+
+        /**
+         * @brief Cantidad de ocurrencias del patrón en el texto, incluidas las solapadas.
+         * 
+         * @complexity
+         * - Tiempo: O(n) en promedio, O(n*m) en el peor caso
+         * - Espacio: O(1) adicional
+         */
+        unsigned int buscar(std::string_view texto) const;
+
+        /**
+         * @brief Patrón tal como se compara (plegado si ignorar_mayusculas).
+         */
+        const std::string& getPatron() const { return patron_; }
+
+    private:
+        /**
+         * @brief Búsqueda comparando el patrón con los caracteres del texto plegados por plegar.
+         */
+        template<typename Plegado>
+        unsigned int buscarCon(std::string_view texto, Plegado plegar) const;
+
+        std::string patron_;
+        bool ignorar_mayusculas_;
+        std::array<long long, 256> ultima_;     ///< Última aparición de cada byte en el patrón (-1 si no aparece)
 };
@@ -0,0 +1,170 @@
+/**
+ * @file busqueda_flujo.hpp
+ * @brief Búsqueda en flujos de datos por bloques, en memoria constante.
+ * 
+ * Los algoritmos en línea de boyer_moore.hpp, knuth_morris_pratt.hpp y
+ * robin_karp.hpp reciben el texto completo. Los buscadores de este archivo
+ * reciben bloques sucesivos y conservan su estado (autómata, máscara de
+ * bits o hash de la ventana) entre un bloque y el siguiente, de modo que
+ * una ocurrencia partida entre dos bloques se cuenta igual que si el texto
+ * estuviera completo. contarEnFlujo lee un archivo o la entrada estándar
+ * con un búfer fijo, por lo que la memoria no depende del tamaño de la
+ * entrada.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <string_view>
+
+/**
+ * @brief Tamaño del búfer de lectura de contarEnFlujo (1 MiB).
+ */
+const size_t TAMANO_BLOQUE_FLUJO = 1 << 20;
+
+/**
+ * @class BuscadorFlujo
+ * @brief Interfaz de un buscador reanudable que cuenta ocurrencias bloque a bloque.
+ * 
+ * Procesar los bloques b1, b2, ..., bk cuenta lo mismo que buscar en la
+ * concatenación b1 b2 ... bk, cualquiera sea la forma en que se corte.
+ */
+class BuscadorFlujo {
+    public:
+        virtual ~BuscadorFlujo() = default;
+
+        /**
+         * @brief Avanza el buscador sobre el siguiente bloque de la entrada.
+         * 
+         * @param bloque Bytes que siguen a los ya procesados (puede estar vacío).
+         */
+        virtual void procesar(std::string_view bloque) = 0;
+
+        /**
+         * @brief Vuelve al estado inicial para buscar en una entrada nueva.
+         */
+        virtual void reiniciar() = 0;
+
+        /**
+         * @brief Ocurrencias encontradas desde la construcción o el último reiniciar().
+         */
+        uint64_t getOcurrencias() const { return ocurrencias_; }
+
+        /**
+         * @brief Bytes procesados desde la construcción o el último reiniciar().
+         */
+        uint64_t getBytesProcesados() const { return bytes_procesados_; }
+
+    protected:
+        uint64_t ocurrencias_ = 0;
+        uint64_t bytes_procesados_ = 0;
+};
+
+/**
+ * @class BuscadorFlujoKMP
+ * @brief Knuth-Morris-Pratt reanudable: el estado es la posición en el patrón.
+ * 
+ * @complexity
+ * - Tiempo: O(n) amortizado sobre toda la entrada
+ * - Espacio: O(m) para la tabla de fallas
+ */
+class BuscadorFlujoKMP : public BuscadorFlujo {
+    public:
+        /**
+         * @param patron Patrón a buscar.
+         * @throws std::invalid_argument Si el patrón está vacío.
+         */
+        explicit BuscadorFlujoKMP(const std::string& patron);
+
+        void procesar(std::string_view bloque) override;
+        void reiniciar() override;
+
+    private:
+        std::string patron_;
+        vc tabla_de_saltos_;
+        size_t posicion_patron_ = 0;
+};
+
+/**
+ * @class BuscadorFlujoShiftAnd
+ * @brief Shift-And (Baeza-Yates y Gonnet) reanudable: el estado es una palabra de 64 bits.
+ * 
+ * El bit j del estado indica que los últimos j + 1 bytes leídos coinciden
+ * con el prefijo patron[0..j]. Cada byte actualiza el estado con un
+ * desplazamiento, un OR y un AND con la máscara del byte, sin saltos.
+ * 
+ * @complexity
+ * - Tiempo: O(n) sobre toda la entrada
+ * - Espacio: 256 máscaras de 64 bits
+ */
+class BuscadorFlujoShiftAnd : public BuscadorFlujo {
+    public:
+        /**
+         * @param patron Patrón a buscar (a lo más 64 bytes).
+         * @throws std::invalid_argument Si el patrón está vacío o tiene más de 64 bytes.
+         */
+        explicit BuscadorFlujoShiftAnd(const std::string& patron);
+
+        void procesar(std::string_view bloque) override;
+        void reiniciar() override;
+
+    private:
+        std::array<uint64_t, 256> mascaras_{};
+        uint64_t bit_final_ = 0;
+        uint64_t estado_ = 0;
+};
+
+/**
+ * @class BuscadorFlujoRobinKarp
+ * @brief Robin-Karp reanudable: el estado es el hash de la ventana y sus últimos m bytes.
+ * 
+ * Los últimos m bytes se guardan en un búfer circular, necesario para
+ * quitar del hash el byte que sale de la ventana y para verificar las
+ * coincidencias de hash aunque la ventana cruce el borde entre bloques.
+ * 
+ * @complexity
+ * - Tiempo: O(n) esperado sobre toda la entrada
+ * - Espacio: O(m) para el búfer circular
+ */
+class BuscadorFlujoRobinKarp : public BuscadorFlujo {
+    public:
+        /**
+         * @param patron Patrón a buscar.
+         * @throws std::invalid_argument Si el patrón está vacío.
+         */
+        explicit BuscadorFlujoRobinKarp(const std::string& patron);
+
+        void procesar(std::string_view bloque) override;
+        void reiniciar() override;
+
+    private:
+        /**
+         * @brief Compara el búfer circular con el patrón.
+         */
+        bool ventanaCoincide() const;
+
+        std::string patron_;
+        uint64_t hash_patron_ = 0;
+        uint64_t factor_potencia_ = 1;     ///< BASE^(m-1) mod MODULO, peso del byte que sale
+        uint64_t hash_ventana_ = 0;
+        std::string ventana_;              ///< Búfer circular con los últimos m bytes
+        size_t inicio_ventana_ = 0;        ///< Índice en ventana_ del byte más antiguo
+};
+
+/**
+ * @brief Lee la entrada en bloques de tamaño fijo y los entrega al buscador.
+ * 
+ * @param entrada Flujo de lectura (archivo abierto en modo binario, std::cin, ...).
+ * @param buscador Buscador que recibe los bloques; no se reinicia.
+ * @param tamano_bloque Bytes por lectura (mayor que 0).
+ * @return Ocurrencias acumuladas por el buscador.
+ * @throws std::invalid_argument Si tamano_bloque es 0.
+ * @throws std::ios_base::failure Si la lectura falla antes del fin de la entrada.
+ */
+uint64_t contarEnFlujo(std::istream& entrada, BuscadorFlujo& buscador, size_t tamano_bloque = TAMANO_BLOQUE_FLUJO);
@@ -0,0 +1,211 @@
+/**
+ * @file busqueda_paralela.hpp
+ * @brief Búsqueda en paralelo por segmentos con los algoritmos en línea.
+ * 
+ * Contiene PoolTrabajo, un conjunto fijo de hilos con robo de tareas, y
+ * contarParalelo, que divide el texto en segmentos solapados en m - 1 bytes
+ * y ejecuta en cada uno cualquier motor de búsqueda en línea (Boyer-Moore,
+ * KMP o Robin-Karp). Un escaneo de varios GB avanza así a la velocidad del
+ * ancho de banda de memoria y no a la de un núcleo.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+/**
+ * @brief Posiciones de inicio por segmento de contarParalelo (4 MiB).
+ * 
+ * Con segmentos de pocos MB el costo de repartirlos es despreciable y
+ * quedan suficientes para equilibrar la carga entre los hilos.
+ */
+const size_t TAMANO_SEGMENTO_PARALELO = 1 << 22;
+
+/**
+ * @brief Motor de búsqueda en línea que cuenta las ocurrencias en un segmento.
+ * 
+ * contarParalelo() lo aplica a cada segmento. Recibe una vista del texto,
+ * sin copiarla, que incluye los m - 1 bytes siguientes al segmento, y debe
+ * contar todas las ocurrencias completas dentro de la vista, incluidas las
+ * solapadas; no debe guardar estado entre llamadas, porque varios hilos lo
+ * usan a la vez (BoyerMoore::buscarEnSegmento, KnuthMorrisPratt::buscarEnSegmento,
+ * KnuthMorrisPratt::buscarAutomataEnSegmento, RobinKarp::buscarEnSegmento,
+ * TwoWay::buscarEnSegmento).
+ */
+using MotorSegmento = unsigned int(*)(std::string_view segmento, const std::string& patron);
+
+/**
+ * @class PoolTrabajo
+ * @brief Hilos persistentes con una cola de tareas por hilo y robo de tareas.
+ * 
+ * ejecutar() reparte las tareas en ronda entre las colas. Cada hilo toma
+ * tareas del final de su propia cola y, cuando se vacía, roba del inicio de
+ * las colas de los demás, de modo que un hilo que recibió segmentos más
+ * lentos no retrasa al resto.
+ * 
+ * Cada llamada a ejecutar() forma un lote con su propio contador de
+ * pendientes y su propia excepción, de modo que varios hilos pueden usar el
+ * mismo pool a la vez sin esperar las tareas ni recibir los errores de los
+ * demás.
+ */
+class PoolTrabajo {
+    public:
+        /**
+         * @brief Crea el pool con la cantidad de hilos dada.
+         * 
+         * @param hilos Cantidad de hilos (0 usa std::thread::hardware_concurrency()).
+         */
+        explicit PoolTrabajo(size_t hilos = 0);
+
+        /**
+         * @brief Detiene y espera a todos los hilos.
+         */
+        ~PoolTrabajo();
+
+        PoolTrabajo(const PoolTrabajo&) = delete;
+        PoolTrabajo& operator=(const PoolTrabajo&) = delete;
+
+        /**
+         * @brief Ejecuta las tareas en los hilos del pool y espera a que terminen todas.
+         * 
+         * Mientras espera, el hilo que llama también toma tareas de las colas,
+         * así que una tarea del pool puede llamar a ejecutar() sin bloquearlo.
+         * 
+         * @param tareas Tareas a ejecutar; se consumen.
+         * @throws La primera excepción lanzada por una de estas tareas, una vez terminadas todas.
+         */
+        void ejecutar(std::vector<std::function<void()>> tareas);
+
+        /**
+         * @brief Cantidad de hilos del pool.
+         */
+        size_t getCantidadHilos() const { return hilos_.size(); }
+
+    private:
+        /**
+         * @brief Tareas de una llamada a ejecutar(), que espera solo a estas.
+         */
+        struct Lote {
+            std::mutex candado;
+            std::condition_variable terminado;
+            size_t pendientes = 0;          ///< Tareas del lote no terminadas (protegido por candado)
+            std::exception_ptr error;       ///< Primera excepción de una tarea del lote
+        };
+
+        struct Tarea {
+            std::function<void()> funcion;
+            Lote* lote = nullptr;
+        };
+
+        struct Cola {
+            std::mutex candado;
+            std::deque<Tarea> tareas;
+        };
+
+        /**
+         * @brief Toma una tarea de la cola propia o roba una de otra cola.
+         * 
+         * @param hilo Cola propia; colas_.size() para un hilo ajeno al pool.
+         */
+        bool tomarTarea(size_t hilo, Tarea& tarea);
+
+        /**
+         * @brief Ejecuta una tarea ya tomada y la descuenta de su lote.
+         */
+        void ejecutarTarea(Tarea& tarea);
+
+        /**
+         * @brief Ciclo de cada hilo: espera tareas y las ejecuta.
+         */
+        void trabajar(size_t hilo);
+
+        std::vector<std::unique_ptr<Cola>> colas_;
+        std::vector<std::thread> hilos_;
+
+        std::mutex candado_;
+        std::condition_variable hay_tareas_;
+        size_t sin_tomar_ = 0;      ///< Tareas en las colas (protegido por candado_)
+        bool detener_ = false;
+};
+
+/**
+ * @brief Pool compartido del proceso, con un hilo por núcleo, creado en el primer uso.
+ */
+PoolTrabajo& poolCompartido();
+
+/**
+ * @brief Posiciones mínimas de cada tramo de paraCadaTramo (64 Ki).
+ * 
+ * Por debajo de este tamaño repartir el trabajo cuesta más que hacerlo en
+ * el hilo actual.
+ */
+const size_t TAMANO_MINIMO_TRAMO = 1 << 16;
+
+/**
+ * @brief Pool con que una construcción usa la cantidad de hilos pedida.
+ * 
+ * @param hilos 0 usa poolCompartido(), 1 construye en el hilo actual
+ *              (retorna nullptr) y otro valor crea un pool de ese tamaño.
+ * @param propio Recibe el pool creado; debe vivir mientras dure la construcción.
+ * @return Pool a usar, o nullptr para no usar hilos.
+ */
+PoolTrabajo* poolParaHilos(size_t hilos, std::unique_ptr<PoolTrabajo>& propio);
+
+/**
+ * @brief Cantidad de tramos en que paraCadaTramo divide n posiciones.
+ * 
+ * Cuatro por hilo del pool para equilibrar la carga, sin bajar de
+ * TAMANO_MINIMO_TRAMO posiciones por tramo; 1 si el pool es nulo.
+ */
+size_t cantidadTramos(size_t n, const PoolTrabajo* pool);
+
+/**
+ * @brief Ejecuta cuerpo(tramo, inicio, fin) sobre los tramos [k·n/t, (k+1)·n/t) de [0, n).
+ * 
+ * Los algoritmos de dos pasadas (contar por tramo, acumular y escribir)
+ * llaman dos veces con la misma cantidad de tramos para que ambas pasadas
+ * vean los mismos límites.
+ * 
+ * @param n Cantidad de posiciones.
+ * @param tramos Cantidad de tramos (t, mayor que 0).
+ * @param pool Hilos que procesan los tramos; nullptr los procesa en el hilo actual.
+ * @param cuerpo Función aplicada a cada tramo.
+ * @throws La primera excepción lanzada por cuerpo.
+ */
+void paraCadaTramo(size_t n, size_t tramos, PoolTrabajo* pool,
+                   const std::function<void(size_t tramo, size_t inicio, size_t fin)>& cuerpo);
+
+/**
+ * @brief Cuenta las ocurrencias del patrón repartiendo el texto en segmentos.
+ * 
+ * El segmento k abarca las posiciones de inicio [k·T, (k+1)·T) y se busca
+ * sobre texto[k·T, (k+1)·T + m - 1): cada ocurrencia que cruza el borde
+ * está completa en el segmento donde comienza y no empieza en el siguiente,
+ * así que se cuenta exactamente una vez. Los segmentos son vistas del
+ * texto, sin copias.
+ * 
+ * @param motor Algoritmo en línea aplicado a cada segmento.
+ * @param texto Texto completo.
+ * @param patron Patrón a buscar.
+ * @param pool Hilos que procesan los segmentos.
+ * @param tamano_segmento Posiciones de inicio por segmento (T, mayor que 0).
+ * @return Cantidad total de ocurrencias, incluidas las solapadas.
+ * @throws std::invalid_argument Si tamano_segmento es 0.
+ * 
+ * @complexity
+ * - Tiempo: O(n/p) por hilo con p hilos, más (n/T)·(m - 1) bytes releídos en los bordes
+ */
+uint64_t contarParalelo(MotorSegmento motor, std::string_view texto, const std::string& patron,
+                        PoolTrabajo& pool = poolCompartido(), size_t tamano_segmento = TAMANO_SEGMENTO_PARALELO);
@@ -0,0 +1,148 @@
+/**
+ * @file cache_consultas.hpp
+ * @brief Caché de resultados de búsqueda para cualquier estructura.
+ * 
+ * Contiene la clase CacheConsultas, que envuelve una BaseStructure y guarda
+ * la cantidad de ocurrencias de los patrones consultados recientemente. Con
+ * consultas repetidas (distribución Zipf) la mayoría se responde con una
+ * búsqueda en una tabla hash en lugar de recorrer el índice.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "class_base.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Cantidad de fragmentos por defecto de CacheConsultas.
+ */
+const size_t FRAGMENTOS_CACHE = 16;
+
+/**
+ * @brief Opciones de CacheConsultas.
+ */
+struct OpcionesCache {
+    size_t capacidad = 4096;                        ///< Máximo de patrones guardados (mayor o igual a 1)
+    std::chrono::milliseconds ttl{0};               ///< Vigencia de cada resultado (0 = sin vencimiento)
+    size_t fragmentos = FRAGMENTOS_CACHE;           ///< Fragmentos con candado propio (mayor o igual a 1)
+};
+
+/**
+ * @class CacheConsultas
+ * @brief Decorador de BaseStructure con caché LRU acotado y vencimiento.
+ * 
+ * Los patrones se reparten por hash entre fragmentos independientes, cada
+ * uno con su candado, su lista LRU y su tabla hash, de modo que hilos que
+ * consultan patrones distintos rara vez compiten por el mismo candado. La
+ * capacidad se reparte entre los fragmentos (la suma es exactamente la
+ * capacidad) y cada uno, al llenarse, descarta el patrón usado hace más
+ * tiempo.
+ * 
+ * Ante un fallo la búsqueda en la estructura se hace sin el candado; si dos
+ * hilos fallan a la vez con el mismo patrón ambos buscan y el resultado se
+ * guarda una vez.
+ * 
+ * Un resultado cuyo ttl venció se descarta al consultarlo y cuenta como
+ * fallo.
+ * 
+ * @note La estructura envuelta debe admitir buscar() concurrente si la
+ *       caché se usa desde varios hilos (todas las del proyecto lo admiten).
+ */
+class CacheConsultas : public BaseStructure {
+    public:
+        /**
+         * @brief Envuelve una estructura ya construida.
+         * 
+         * @param estructura Estructura cuyas búsquedas se guardan.
+         * @param opciones Capacidad, vigencia y fragmentos.
+         * @throws std::invalid_argument Si la estructura es nula o la capacidad o los fragmentos son 0.
+         */
+        CacheConsultas(std::unique_ptr<BaseStructure> estructura, const OpcionesCache& opciones = OpcionesCache());
+
+        /**
+         * @brief Cantidad de ocurrencias del patrón, desde la caché si está vigente.
+         */
+        unsigned int buscar(const std::string& patron) const override;
+
+        /**
+         * @brief Memoria de la estructura envuelta más la estimada de las entradas guardadas.
+         */
+        size_t getMemoriaBytes() const override;
+
+        /**
+         * @brief Consultas respondidas desde la caché.
+         */
+        size_t getAciertos() const { return aciertos_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Consultas que tuvieron que buscar en la estructura.
+         */
+        size_t getFallos() const { return fallos_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Proporción de aciertos sobre el total de consultas (0 sin consultas).
+         */
+        double getTasaAciertos() const;
+
+        /**
+         * @brief Patrones guardados actualmente.
+         */
+        size_t getCantidadEntradas() const;
+
+        /**
+         * @brief Descarta todas las entradas y reinicia los contadores.
+         */
+        void limpiar();
+
+        /**
+         * @brief Estructura envuelta.
+         */
+        const BaseStructure& getEstructura() const { return *estructura_; }
+
+    private:
+        using Reloj = std::chrono::steady_clock;
+
+        struct Entrada {
+            std::string patron;
+            unsigned int ocurrencias;
+            Reloj::time_point vencimiento;
+        };
+
+        /**
+         * @brief Fragmento de la caché: lista LRU (más reciente al frente) e índice por patrón.
+         */
+        struct Fragmento {
+            std::mutex candado;
+            std::list<Entrada> recientes;
+            std::unordered_map<std::string, std::list<Entrada>::iterator> posiciones;
+            size_t capacidad = 0;
+            size_t bytes = 0;
+        };
+
+        /**
+         * @brief Fragmento al que pertenece el patrón.
+         */
+        Fragmento& fragmentoDe(const std::string& patron) const;
+
+        /**
+         * @brief Bytes estimados de una entrada: el patrón dos veces (lista y tabla) más los nodos.
+         */
+        static size_t bytesEntrada(const std::string& patron);
+
+        std::unique_ptr<BaseStructure> estructura_;
+        std::chrono::milliseconds ttl_;
+        std::unique_ptr<Fragmento[]> fragmentos_;
+        size_t cantidad_fragmentos_;
+
+        mutable std::atomic<size_t> aciertos_{0};
+        mutable std::atomic<size_t> fallos_{0};
+};
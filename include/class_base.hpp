@@ -46,4 +46,13 @@ class BaseStructure {
          * @note La complejidad temporal depende de la implementación específica.
          */
         virtual unsigned int buscar(const std::string& patron) const = 0;
+
+        /**
+         * @brief Memoria ocupada por las estructuras que usan las consultas.
+         * 
+         * @return Cantidad de bytes.
+         * 
+         * @note Cada clase derivada la implementa para que el medidor no registre 0 bytes.
+         */
+        virtual size_t getMemoriaBytes() const = 0;
 };
\ No newline at end of file
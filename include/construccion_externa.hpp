@@ -0,0 +1,143 @@
+/**
+ * @file construccion_externa.hpp
+ * @brief Construcción de la BWT en memoria externa con un presupuesto de RAM.
+ * 
+ * Contiene construirTransformadaExterna, que ordena los sufijos de un texto
+ * (normalmente mapeado desde disco) por cubetas de sus primeros caracteres:
+ * cada pasada recorre el texto, junta los sufijos de tantas cubetas
+ * consecutivas como quepan en el presupuesto, los ordena y escribe su
+ * tramo de la BWT en un archivo temporal. Del arreglo de sufijos solo se
+ * conservan las muestras que usa FMIndex, así que nunca hay en memoria más
+ * que una pasada de sufijos.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "archivo_mapeado.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Presupuesto por defecto para los sufijos de cada pasada (1 GiB).
+ */
+const size_t MEMORIA_CONSTRUCCION_EXTERNA = 1ULL << 30;
+
+/**
+ * @brief Carpeta local por defecto de los archivos temporales, relativa al directorio de trabajo.
+ */
+const char* const DIRECTORIO_TEMPORAL_EXTERNO = "temporal";
+
+/**
+ * @brief Bits del código de cubeta: hasta 2^20 cubetas (4 MB de conteos).
+ * 
+ * Con σ = 4 cada cubeta corresponde a los primeros 6 caracteres del sufijo
+ * y con σ = 256, a los primeros 2.
+ */
+const uint32_t BITS_CUBETAS_EXTERNAS = 20;
+
+/**
+ * @brief Niveles de cubetas con que se subdivide una cubeta que no cabe en el presupuesto.
+ * 
+ * Cada nivel agrega los k caracteres siguientes del sufijo y cuesta un
+ * recorrido del texto y 4 MB de conteos. Solo más sufijos que el
+ * presupuesto con un prefijo común de 32·k caracteres (64 con σ = 256)
+ * hacen que una pasada lo exceda.
+ */
+const uint32_t MAX_NIVELES_CUBETAS_EXTERNAS = 32;
+
+/**
+ * @brief Opciones de la construcción en memoria externa.
+ */
+struct OpcionesConstruccionExterna {
+    size_t memoria_bytes = MEMORIA_CONSTRUCCION_EXTERNA;                ///< Presupuesto para los sufijos de una pasada (8 bytes por sufijo)
+    std::string directorio_temporal = DIRECTORIO_TEMPORAL_EXTERNO;     ///< Carpeta local donde se escriben los temporales
+};
+
+/**
+ * @class ArchivoTemporal
+ * @brief Ruta única dentro de una carpeta de temporales; el archivo se borra al destruir el objeto.
+ */
+class ArchivoTemporal {
+    public:
+        /**
+         * @brief Crea la carpeta si no existe y reserva un nombre que no usa ningún otro ArchivoTemporal.
+         * 
+         * @param directorio Carpeta de los temporales.
+         * @param prefijo Comienzo del nombre del archivo.
+         * @throws std::filesystem::filesystem_error Si la carpeta no puede crearse.
+         */
+        ArchivoTemporal(const std::string& directorio, const std::string& prefijo);
+
+        /**
+         * @brief Borra el archivo si llegó a crearse.
+         */
+        ~ArchivoTemporal();
+
+        ArchivoTemporal(const ArchivoTemporal&) = delete;
+        ArchivoTemporal& operator=(const ArchivoTemporal&) = delete;
+
+        const std::string& getRuta() const { return ruta_; }
+
+    private:
+        std::string ruta_;
+};
+
+/**
+ * @brief Resultado de construirTransformadaExterna: lo que FMIndex necesita del arreglo de sufijos.
+ * 
+ * La BWT (n bytes, sin el centinela) queda en el archivo indicado al construir.
+ */
+struct TransformadaExterna {
+    size_t longitud = 0;                        ///< Largo del texto (n)
+    size_t fila_centinela = 0;                  ///< Fila de la BWT que contiene el centinela
+    VectorAlineado<uint64_t> marcas;            ///< Bit por fila: su sufijo comienza en un múltiplo del paso
+    std::vector<uint32_t> muestras_sufijos;     ///< Posición de texto de cada fila marcada, en orden de fila
+    std::vector<uint32_t> muestras_inverso;     ///< Fila del sufijo que comienza en j·paso
+    size_t pasadas = 0;                         ///< Pasadas de ordenamiento sobre el texto
+    size_t max_sufijos_pasada = 0;              ///< Mayor cantidad de sufijos ordenados en una pasada
+};
+
+/**
+ * @brief Ordena los sufijos del texto por pasadas acotadas y escribe la BWT en un archivo.
+ * 
+ * Una primera pasada cuenta los sufijos de cada cubeta (sus primeros k
+ * caracteres empaquetados en BITS_CUBETAS_EXTERNAS bits). Luego agrupa
+ * cubetas consecutivas mientras sus sufijos quepan en memoria_bytes, y por
+ * cada grupo recorre el texto, junta sus sufijos, los ordena comparando el
+ * texto a partir del carácter k y emite sus filas en orden: el carácter
+ * anterior de cada sufijo va al archivo de la BWT y las filas muestreadas
+ * a las muestras.
+ * 
+ * Una cubeta con más sufijos que el presupuesto (con σ >= 128 las cubetas
+ * son de solo 2 caracteres, así que ocurre con texto común) se vuelve a
+ * contar por los k caracteres siguientes y sus subcubetas se agrupan igual,
+ * hasta MAX_NIVELES_CUBETAS_EXTERNAS niveles.
+ * 
+ * El texto solo se lee, así que puede venir de un archivo mapeado más
+ * grande que la RAM: el sistema carga y descarta sus páginas.
+ * 
+ * @param texto Texto (al menos un carácter y menos de 2^32 - 1).
+ * @param paso_muestreo Paso de muestreo de SA e ISA (mayor que 0).
+ * @param ruta_bwt Archivo donde se escribe la BWT.
+ * @param memoria_bytes Presupuesto para los sufijos de una pasada.
+ * @return Fila del centinela y muestras de SA e ISA.
+ * @throws std::length_error Si el texto no cabe en posiciones de 32 bits.
+ * @throws std::runtime_error Si no se puede escribir la BWT.
+ * 
+ * @note Solo si más sufijos que el presupuesto comparten sus primeros
+ *       MAX_NIVELES_CUBETAS_EXTERNAS·k caracteres (textos muy repetitivos)
+ *       se ordenan en una pasada propia que lo excede.
+ * 
+ * @complexity
+ * - Tiempo: O(p·n) de recorridos con p = 1 + 8n / memoria_bytes pasadas más
+ *   una por cada cubeta subdividida, más O(n log n) comparaciones de sufijos
+ *   (cada una hasta su prefijo común)
+ * - Espacio: memoria_bytes + n / 8 + 8n / paso_muestreo bytes, más 4 MB de
+ *   conteos por nivel de subdivisión
+ */
+TransformadaExterna construirTransformadaExterna(std::string_view texto, uint32_t paso_muestreo,
+                                                 const std::string& ruta_bwt, size_t memoria_bytes);
@@ -0,0 +1,61 @@
+/**
+ * @file contadores.hpp
+ * @brief Contadores de operaciones internas de los motores de búsqueda.
+ * 
+ * Contiene ContadoresMotor, los contadores del hilo que los algoritmos y
+ * estructuras incrementan con CONTAR_MOTOR en sus ciclos de búsqueda
+ * (comparaciones y saltos de Boyer-Moore, enlaces de falla de KMP,
+ * coincidencias de hash de Robin-Karp, consultas de rango del FM-Index,
+ * nodos visitados del árbol de sufijos). El medidor los reinicia antes de
+ * cada búsqueda y los agrega al resultado.
+ * 
+ * Los contadores solo se compilan con -DCONTADORES_MOTORES: sin esa
+ * bandera CONTAR_MOTOR no genera código y los ciclos quedan como sin
+ * instrumentar. A diferencia de TRAZAR_FASE, que marca unas pocas fases por
+ * construcción, estos incrementos están en los ciclos internos, por eso
+ * vienen desactivados.
+ * 
+ * Los contadores son del hilo: lo que cuentan las tareas de un PoolTrabajo
+ * (contarParalelo) no llega al hilo que mide.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <cstdint>
+
+/**
+ * @brief Operaciones contadas en el hilo actual desde el último reinicio.
+ */
+struct ContadoresMotor {
+    uint64_t comparaciones_boyer_moore = 0;             ///< Caracteres comparados contra el patrón
+    uint64_t desplazamientos_boyer_moore = 0;           ///< Veces que se desplazó la ventana
+    uint64_t caracteres_desplazados_boyer_moore = 0;    ///< Suma de los desplazamientos (dividida por los desplazamientos, el salto medio)
+    uint64_t enlaces_falla_kmp = 0;                     ///< Retrocesos por la tabla de fallas (sin autómata)
+    uint64_t coincidencias_hash_robin_karp = 0;         ///< Ventanas con el hash del patrón
+    uint64_t falsos_positivos_robin_karp = 0;           ///< Ventanas con el hash del patrón que no eran ocurrencias
+    uint64_t llamadas_rango_fm_index = 0;               ///< Consultas de rango sobre la BWT del FMIndex
+    uint64_t nodos_visitados_suffix_trees = 0;          ///< Nodos recorridos por las búsquedas del árbol de sufijos
+};
+
+/**
+ * @brief Contadores del hilo actual.
+ */
+extern thread_local ContadoresMotor contadores_motor;
+
+/**
+ * @brief Pone en cero los contadores del hilo actual.
+ */
+void reiniciarContadoresMotor();
+
+/**
+ * @brief Suma una cantidad al contador indicado del hilo actual (sin código si no se compiló con -DCONTADORES_MOTORES).
+ */
+#ifdef CONTADORES_MOTORES
+#define CONTAR_MOTOR(campo, cantidad) (contadores_motor.campo += static_cast<uint64_t>(cantidad))
+#else
+#define CONTAR_MOTOR(campo, cantidad) ((void)0)
+#endif
@@ -27,7 +27,7 @@
 #include <map> // Para typedef mcharvc
 
 // Includes condicionales para archivos específicos
-// <filesystem> - solo para main.cpp, utilities.cpp y medidor.cpp
+// <filesystem> - solo para main.cpp, utilities.cpp, medidor.cpp y construccion_externa.cpp
 // <fstream> - solo para archivos que leen/escriben archivos
 // <cctype> - solo para robin_karp.cpp
 // <map> - solo para fm_index.cpp
@@ -13,14 +13,82 @@
 
 #include "definiciones.hpp"
 #include "class_base.hpp"
+#include "archivo_mapeado.hpp"
+#include "bit_vector.hpp"
+#include "tabla_ocurrencias.hpp"
+#include "wavelet_matrix.hpp"
+#include "transformada_bwt.hpp"
+#include "construccion_externa.hpp"
+#include "contadores.hpp"
+#include "plegado_caso.hpp"
+#include "patron_comodin.hpp"
 
-#include <unordered_set>
-#include <map>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Versión del formato de archivo de FMIndex::guardar.
+ * 
+ * Debe incrementarse cada vez que cambia la disposición de las secciones;
+ * FMIndex::cargar rechaza archivos de otra versión.
+ */
+const uint32_t VERSION_ARCHIVO_FM_INDEX = 7;
+
+/**
+ * @brief Paso de muestreo por defecto del arreglo de sufijos y de su inverso.
+ * 
+ * Se guarda la posición de texto de cada fila cuyo sufijo comienza en un
+ * múltiplo del paso; localizar o extraer recorre a lo más paso - 1 pasos LF
+ * por resultado.
+ */
+const uint32_t PASO_MUESTREO_SUFIJOS = 32;
+
+/**
+ * @brief Máximo de k-mers distintos en la tabla de k-mers: 2^22, en a lo más 2^23 ranuras de 16 bytes (128 MB).
+ */
+const uint64_t MAX_KMERS_TABLA = 1ULL << 22;
+
+/**
+ * @brief Cantidad de búsquedas que FMIndex::buscarLote avanza intercaladas.
+ * 
+ * Entre la precarga de las filas de un patrón y su siguiente paso se
+ * procesan los demás patrones del lote, tiempo suficiente para que las
+ * líneas lleguen desde DRAM.
+ */
+const size_t TAMANO_LOTE_BUSQUEDA = 32;
+
+/**
+ * @brief Estructura que responde las consultas de rango sobre la BWT.
+ */
+enum class TipoRango : uint32_t {
+    Tabla = 0,      ///< TablaOcurrencias: conteos muestreados por símbolo, rango en O(1) con escaneo corto
+    Wavelet = 1     ///< WaveletMatrix: n·log σ bits, rango en O(log σ) con popcount
+};
+
+/**
+ * @brief Opciones de construcción de FMIndex.
+ */
+struct OpcionesFMIndex {
+    TipoRango tipo_rango = TipoRango::Tabla;
+    uint32_t paso_muestreo = PASO_MUESTREO_SUFIJOS;     ///< Paso de muestreo de SA e ISA (mayor o igual a 1)
+    uint32_t largo_kmer = 0;                            ///< Largo k de la tabla de k-mers (0 la desactiva)
+    bool ignorar_mayusculas = false;                    ///< Indexar el texto plegado y plegar los patrones
+    size_t hilos_construccion = 1;                      ///< Hilos de la construcción (1: sin hilos, 0: pool compartido)
+};
+
+/**
+ * @brief Transformada que indexa un FM-Index construido con estas opciones.
+ * 
+ * Pliega el texto si ignorar_mayusculas y construye el arreglo de sufijos y
+ * la BWT con hilos_construccion hilos.
+ * 
+ * @throws std::length_error Si el texto no cabe en posiciones de tipo int.
+ */
+TransformadaBWT construirTransformadaFM(const std::string& texto, const OpcionesFMIndex& opciones);
 
 /**
  * @class FMIndex
- * @brief Implementación de búsqueda de patrones mediante FM-Index con soporte
- *        para variaciones de capitalización.
+ * @brief Implementación de búsqueda de patrones mediante FM-Index.
  * 
  * FM-Index es una estructura de datos altamente eficiente que combina:
  * - Transformada de Burrows-Wheeler (BWT) para compresión
@@ -28,18 +96,45 @@
  * - Tablas auxiliares (C table y Occ table) para búsqueda rápida
  * 
  * Características de esta implementación:
+ * - BWT del texto terminado en un centinela único $ menor que todo carácter
  * - Búsqueda backward (de derecha a izquierda en el patrón)
- * - Búsqueda solo exacta (variaciones de capitalización comentadas)
- * - Muy eficiente en memoria para textos largos
- * - Construcción completa de BWT y tablas auxiliares
+ * - Búsqueda exacta o, con ignorar_mayusculas, sobre el texto plegado a minúsculas
+ * - Localización y extracción de subcadenas mediante LF sobre muestras de SA e ISA
+ * - Tras la construcción no se conservan ni el texto ni el arreglo de sufijos completo
+ * - Tabla C y tabla de ocurrencias muestreada como arreglos planos
+ * - Backend de rango seleccionable: tabla de ocurrencias o wavelet matrix
+ * - Tabla opcional de k-mers que reemplaza los primeros k pasos de la búsqueda
+ * - Persistencia en disco con formato versionado y carga mediante mmap
+ * 
+ * El centinela es virtual: la BWT almacenada tiene n caracteres (sin el $)
+ * y las posiciones posteriores a la fila del centinela se desplazan en uno
+ * antes de consultar el backend de rango. Así el texto puede contener
+ * cualquier byte, incluido '\0'.
  * 
  * Complejidad temporal:
  * - Construcción: O(n log n) donde n es el tamaño del texto
- * - Búsqueda: O(m) donde m es el tamaño del patrón
+ * - Búsqueda: O(m) donde m es el tamaño del patrón (m - k pasos de rango con tabla de k-mers)
+ * - Localización: O(m + occ·s) con s el paso de muestreo
+ * - Extracción de l caracteres: O(l + s)
+ * 
+ * Complejidad espacial: backend de rango + (n / s)·8 bytes de muestras +
+ * 1.25·n bits de marcas de filas muestreadas
+ * 
+ * Formato del archivo de índice (versión VERSION_ARCHIVO_FM_INDEX):
+ * - Cabecera: número mágico, versión, marca de endianness, TipoRango, paso
+ *   de muestreo, largo de k-mer, plegado de mayúsculas, largo del texto y
+ *   fila del centinela
+ * - Tabla C: 257 enteros de 64 bits
+ * - Backend de rango: tabla de ocurrencias (BWT, códigos de símbolos y filas
+ *   de conteos) o wavelet matrix (niveles de bits con su directorio de rango)
+ * - Marcas de filas muestreadas (BitVector), muestras de SA y muestras de ISA
+ * - Tabla de k-mers: códigos de símbolos y ranuras (k-mer, intervalo) de la
+ *   tabla hash (vacíos si k es 0)
  * 
- * Complejidad espacial: O(n) para las estructuras principales
+ * Cada arreglo va alineado a ALINEACION_ARCHIVO bytes, de modo que al cargar
+ * el índice las consultas leen directamente de las páginas mapeadas.
  * 
- * @note Las variaciones de capitalización están comentadas en la implementación actual.
+ * @note Con ignorar_mayusculas, extraer() retorna el texto plegado.
  */
 class FMIndex : public BaseStructure {
 public:
@@ -47,8 +142,30 @@ public:
      * @brief Constructor que inicializa la estructura FM-Index con el texto.
      * 
      * @param texto Texto donde se construirá el índice.
+     * @param opciones Opciones de construcción (backend de rango, paso de muestreo e hilos).
+     * @throws std::length_error Si el texto no cabe en posiciones de 32 bits.
+     * @throws std::invalid_argument Si el paso de muestreo es 0, σ^k no cabe en 64 bits
+     *         o el texto tiene más de MAX_KMERS_TABLA k-mers distintos.
      */
-    FMIndex(const std::string& texto);  // Constructor
+    FMIndex(const std::string& texto, const OpcionesFMIndex& opciones = OpcionesFMIndex());  // Constructor
+
+    /**
+     * @brief Constructor a partir de una BWT ya construida.
+     * 
+     * Permite reutilizar la transformada cuando se construyen varios índices
+     * sobre el mismo texto (por ejemplo, en crearIndiceFM). Con
+     * ignorar_mayusculas la transformada debe ser la de plegarCaso(texto).
+     * 
+     * La tabla C, las muestras y la tabla de ocurrencias se construyen por
+     * tramos con hilos_construccion hilos; la wavelet matrix, nivel por
+     * nivel en el hilo actual.
+     * 
+     * @param transformada Arreglo de sufijos y BWT del texto.
+     * @param opciones Opciones de construcción (backend de rango, paso de muestreo e hilos).
+     * @throws std::invalid_argument Si el paso de muestreo es 0, σ^k no cabe en 64 bits
+     *         o el texto tiene más de MAX_KMERS_TABLA k-mers distintos.
+     */
+    FMIndex(const TransformadaBWT& transformada, const OpcionesFMIndex& opciones = OpcionesFMIndex());
 
     /**
      * @brief Busca un patrón en el texto previamente procesado.
@@ -58,6 +175,23 @@ public:
      */
     unsigned int buscar(const std::string& patron) const override;  // Override
 
+    /**
+     * @brief Cuenta las ocurrencias de muchos patrones con sus búsquedas intercaladas.
+     * 
+     * Mantiene hasta TAMANO_LOTE_BUSQUEDA búsquedas backward activas y las
+     * avanza un carácter por turno. Tras cada paso precarga las líneas que
+     * necesitará el siguiente, de modo que los accesos a memoria de distintos
+     * patrones se solapan en lugar de esperarse uno a otro.
+     * 
+     * @param patrones Patrones a buscar.
+     * @return Cantidad de ocurrencias de cada patrón, en el mismo orden
+     *         (0 para los patrones vacíos).
+     * 
+     * @complexity
+     * - Tiempo: O(Σ m) pasos de rango, igual que buscar() por patrón
+     */
+    std::vector<unsigned int> buscarLote(const std::vector<std::string>& patrones) const;
+
     /**
      * @brief Versión estática de búsqueda para uso directo sin construir instancia.
      * 
@@ -67,53 +201,321 @@ public:
      */
     static unsigned int buscar(const std::string& texto, const std::string& patron);
 
-private:
     /**
-     * @brief Genera todas las variaciones de capitalización de un patrón,
-     *        excluyendo el patrón original.
+     * @brief Cuenta las ocurrencias de un patrón con comodines y clases de caracteres.
      * 
-     * @param patron Cadena patrón original.
-     * @return std::unordered_set<std::string> Conjunto con todas las variaciones.
+     * La búsqueda backward se ramifica en cada posición con los caracteres
+     * aceptados que aparecen en el texto y poda los intervalos vacíos, de
+     * modo que el costo depende de los intervalos visitados y no de la
+     * cantidad de cadenas que describe el patrón.
+     * 
+     * @param patron Patrón con comodines (plegado al buscar si el índice ignora mayúsculas).
+     * @param maximo_intervalos Intervalos no vacíos que se exploran antes de detenerse.
+     * @return Ocurrencias, intervalos explorados y si la búsqueda se truncó.
+     * 
+     * @complexity
+     * - Tiempo: O(intervalos explorados · σ) pasos de rango
      */
-    std::unordered_set<std::string> generarVariacionesCapitalizacion(const std::string& patron) const;
+    ResultadoComodin buscarComodin(const PatronComodin& patron, size_t maximo_intervalos = MAXIMO_INTERVALOS_COMODIN) const;
 
     /**
-     * @brief Construye el arreglo de sufijos de un texto.
+     * @brief Posiciones del texto en que aparece el patrón.
      * 
-     * @param texto Texto fuente.
-     * @return vc Vector con los índices del arreglo de sufijos.
+     * @param patron Patrón a buscar.
+     * @return Posiciones de inicio de cada ocurrencia, en orden creciente.
+     * 
+     * @complexity
+     * - Tiempo: O(m + occ·s + occ log occ)
      */
-    static vc construirArregloSufijos(const std::string& texto);
+    std::vector<size_t> localizar(const std::string& patron) const;
 
     /**
-     * @brief Construye la transformada de Burrows-Wheeler (BWT) a partir del texto y su arreglo de sufijos.
+     * @brief Intervalo [inicio, fin) de filas de la BWT cuyos sufijos comienzan con el patrón.
+     * 
+     * Permite asociar datos a cada fila fuera del índice, como el documento
+     * de cada sufijo en IndiceDocumentos. La fila 0 es la del sufijo vacío.
      * 
-     * @param texto Texto original.
-     * @param arreglo_sufijos Arreglo de sufijos construido sobre el texto.
-     * @return std::string Cadena resultante de la BWT.
+     * @return {0, 0} si el patrón está vacío o no aparece.
      */
-    static std::string construirTransformadaBWT(const std::string& texto, const vc& arreglo_sufijos);
+    std::pair<size_t, size_t> intervaloFilas(const std::string& patron) const;
 
     /**
-     * @brief Construye la tabla de inicio por carácter (tabla C) a partir de la BWT.
+     * @brief Extrae una subcadena del texto original a partir del índice.
+     * 
+     * @param inicio Posición inicial en el texto.
+     * @param longitud Cantidad de caracteres (se recorta al final del texto).
+     * @return Subcadena texto[inicio, inicio + longitud).
+     * @throws std::out_of_range Si inicio es mayor que el largo del texto.
      * 
-     * @param bwt Cadena BWT.
-     * @return Tabla C.
+     * @complexity
+     * - Tiempo: O(longitud + s)
      */
-    static std::map<char, int> construirTablaInicioCaracter(const std::string& bwt);
+    std::string extraer(size_t inicio, size_t longitud) const;
 
     /**
-     * @brief Construye la tabla de ocurrencias (Occ) para cada carácter y posición en la BWT.
+     * @brief Largo del texto indexado (sin el centinela).
+     */
+    size_t getLongitudTexto() const { return longitud_texto_; }
+
+    /**
+     * @brief Guarda el índice en disco con el formato versionado.
+     * 
+     * @param ruta Ruta del archivo de salida.
+     * @throws std::runtime_error Si el archivo no puede escribirse.
+     */
+    void guardar(const std::string& ruta) const;
+
+    /**
+     * @brief Carga un índice guardado con guardar() mapeando el archivo en memoria.
      * 
-     * @param bwt Cadena BWT.
-     * @return Tabla de ocurrencias.
+     * No se deserializa ni se copia nada: los arreglos del índice apuntan a
+     * la región mapeada y las páginas se cargan a medida que las consultas
+     * las tocan. Varios procesos que cargan el mismo archivo comparten las
+     * páginas del page cache.
+     * 
+     * @param ruta Ruta del archivo de índice.
+     * @return Índice listo para responder consultas.
+     * @throws std::runtime_error Si el archivo no existe, tiene otra versión o está corrupto.
+     * 
+     * @complexity
+     * - Tiempo: O(1) más el costo de mapear el archivo
+     * - Espacio: O(1) adicional en memoria anónima
      */
-    static mcharvc construirTablaOcurrencias(const std::string& bwt);
+    static std::unique_ptr<FMIndex> cargar(const std::string& ruta);
+
+    /**
+     * @brief Construye el índice de un archivo de texto sin tener el texto ni el arreglo de sufijos en memoria.
+     * 
+     * Mapea el archivo (con ignorar_mayusculas, una copia plegada en el
+     * directorio temporal), ordena los sufijos por pasadas acotadas por
+     * externa.memoria_bytes escribiendo la BWT en un archivo temporal
+     * (construirTransformadaExterna), libera el texto y construye la tabla C
+     * y el backend de rango sobre la BWT mapeada. Los temporales se borran
+     * al terminar.
+     * 
+     * El índice resultante es idéntico al de FMIndex(texto, opciones).
+     * 
+     * @param ruta_texto Archivo con el texto a indexar.
+     * @param opciones Opciones del índice.
+     * @param externa Presupuesto de memoria y carpeta de los temporales.
+     * @return Índice listo para responder consultas.
+     * @throws std::runtime_error Si el texto no puede leerse o los temporales no pueden escribirse.
+     * @throws std::length_error Si el texto no cabe en posiciones de 32 bits.
+     * @throws std::invalid_argument Si el paso de muestreo es 0.
+     * 
+     * @complexity
+     * - Espacio: externa.memoria_bytes durante el ordenamiento y luego el
+     *   índice final más la BWT mapeada
+     */
+    static std::unique_ptr<FMIndex> construirExterno(const std::string& ruta_texto,
+                                                     const OpcionesFMIndex& opciones = OpcionesFMIndex(),
+                                                     const OpcionesConstruccionExterna& externa = OpcionesConstruccionExterna());
+
+    /**
+     * @brief Backend de rango con el que se construyó o cargó el índice.
+     */
+    TipoRango getTipoRango() const { return tipo_rango_; }
+
+    /**
+     * @brief Largo k de la tabla de k-mers (0 si no tiene).
+     */
+    uint32_t getLargoKmer() const { return largo_kmer_; }
+
+    /**
+     * @brief Indica si el índice se construyó sobre el texto plegado a minúsculas.
+     */
+    bool getIgnorarMayusculas() const { return ignorar_mayusculas_; }
+
+    /**
+     * @brief Bytes ocupados por la tabla de k-mers (incluidos en getMemoriaBytes).
+     */
+    size_t getMemoriaTablaKmerBytes() const;
+
+    /**
+     * @brief Bytes ocupados por la tabla C, el backend de rango, las muestras y la tabla de k-mers.
+     */
+    size_t getMemoriaBytes() const override;
+
+private:
+    /**
+     * @brief Constructor vacío usado al cargar un índice desde disco.
+     */
+    FMIndex() = default;
+
+    /**
+     * @brief Invoca una función con el backend de rango concreto del índice.
+     * 
+     * Las consultas se instancian una vez por backend para que los ciclos
+     * internos no paguen un despacho por cada consulta de rango.
+     * 
+     * @param funcion Función genérica que recibe TablaOcurrencias o WaveletMatrix.
+     */
+    template<typename Funcion>
+    auto conRango(Funcion&& funcion) const {
+        if (tipo_rango_ == TipoRango::Wavelet) return funcion(wavelet_);
+        return funcion(tabla_ocurrencias_);
+    }
+
+    /**
+     * @brief Apariciones de c en las filas [0, i) de la BWT, sin contar el centinela.
+     */
+    template<typename Rango>
+    size_t rangoBWT(const Rango& rango, unsigned char c, size_t i) const {
+        CONTAR_MOTOR(llamadas_rango_fm_index, 1);
+        return rango.rango(c, i > fila_centinela_ ? i - 1 : i);
+    }
+
+    /**
+     * @brief Carácter del patrón tal como se busca en la BWT (plegado si corresponde).
+     */
+    unsigned char caracterPatron(char caracter) const {
+        unsigned char byte = static_cast<unsigned char>(caracter);
+        return ignorar_mayusculas_ ? plegarCaracter(byte) : byte;
+    }
+
+    /**
+     * @brief Precarga las líneas que leerá rangoBWT(rango, c, i).
+     */
+    template<typename Rango>
+    void precargarBWT(const Rango& rango, unsigned char c, size_t i) const {
+        rango.precargar(c, i > fila_centinela_ ? i - 1 : i);
+    }
+
+    /**
+     * @brief Búsquedas intercaladas de buscarLote sobre un backend concreto.
+     */
+    template<typename Rango>
+    std::vector<unsigned int> buscarLoteCon(const Rango& rango, const std::vector<std::string>& patrones) const;
+
+    /**
+     * @brief Intervalo [inicio, fin) de filas cuyos sufijos comienzan con el patrón.
+     */
+    template<typename Rango>
+    std::pair<size_t, size_t> intervaloPatron(const Rango& rango, const std::string& patron) const;
+
+    /**
+     * @brief Paso LF: fila del sufijo que comienza una posición antes.
+     * 
+     * @param fila Fila distinta de la del centinela.
+     * @param caracter Si no es nulo, recibe el carácter de la BWT en la fila.
+     */
+    template<typename Rango>
+    size_t pasoLF(const Rango& rango, size_t fila, unsigned char* caracter = nullptr) const;
+
+    /**
+     * @brief Posición de texto del sufijo de una fila, avanzando con LF hasta una fila muestreada.
+     */
+    template<typename Rango>
+    size_t posicionDeFila(const Rango& rango, size_t fila) const;
+
+    /**
+     * @brief Intervalo [inicio, fin) de filas cuyos sufijos comienzan con los k caracteres dados.
+     * 
+     * Sondeo lineal en tabla_kmer_ desde la ranura del k-mer; con la tabla a
+     * lo más a medio llenar, casi siempre basta una línea de caché. {0, 0} si
+     * el k-mer no aparece.
+     */
+    std::pair<size_t, size_t> intervaloKmer(const char* kmer) const;
+
+    /**
+     * @brief Extiende hacia la izquierda el intervalo [inicio, fin) con cada carácter
+     *        aceptado en la posición restantes - 1 del patrón.
+     */
+    template<typename Rango>
+    void expandirComodin(const Rango& rango, const PatronComodin& patron, size_t restantes, size_t inicio, size_t fin,
+                         size_t maximo_intervalos, ResultadoComodin& resultado) const;
+
+    /**
+     * @brief Construye la tabla de k-mers recorriendo en profundidad las extensiones hacia la izquierda.
+     * @throws std::invalid_argument Si σ^k no cabe en 64 bits o hay más de MAX_KMERS_TABLA k-mers distintos.
+     */
+    void construirTablaKmer(uint32_t largo_kmer);
+
+    /**
+     * @brief Extiende el intervalo de un sufijo de k-mer con cada símbolo y baja un nivel.
+     * 
+     * @param profundidad Caracteres ya procesados del k-mer (desde la derecha).
+     * @param clave Parte de la clave del k-mer aportada por esos caracteres.
+     * @param peso σ^profundidad, peso del siguiente carácter en la clave.
+     * @param kmers Pares (clave, inicio | fin << 32) de los k-mers encontrados.
+     * @throws std::invalid_argument Si se encuentran más de MAX_KMERS_TABLA k-mers.
+     */
+    template<typename Rango>
+    void llenarTablaKmer(const Rango& rango, size_t inicio, size_t fin, uint32_t profundidad,
+                         uint64_t clave, uint64_t peso, std::vector<std::pair<uint64_t, uint64_t>>& kmers) const;
+
+    /**
+     * @brief Ranura inicial de una clave en la tabla de k-mers (hash multiplicativo).
+     */
+    size_t ranuraKmer(uint64_t clave) const {
+        return static_cast<size_t>((clave * 0x9E3779B97F4A7C15ULL) >> (64 - bits_ranuras_kmer_));
+    }
+
+    /**
+     * @brief Construye las marcas de filas muestreadas y las muestras de SA e ISA.
+     */
+    void construirMuestras(const TransformadaBWT& transformada, PoolTrabajo* pool);
 
     // Miembros de instancia
-    std::string texto_;
-    vc arreglo_sufijos_;
-    std::string bwt_;
-    std::map<char, int> tabla_inicio_caracter_;
-    mcharvc tabla_ocurrencias_;
+    size_t longitud_texto_ = 0;
+    size_t fila_centinela_ = 0;
+    uint32_t paso_muestreo_ = PASO_MUESTREO_SUFIJOS;
+    ArregloPlano<uint64_t> tabla_inicio_caracter_;
+    TipoRango tipo_rango_ = TipoRango::Tabla;
+    TablaOcurrencias tabla_ocurrencias_;
+    WaveletMatrix wavelet_;
+
+    /**
+     * @brief Marca las filas cuyo sufijo comienza en un múltiplo de paso_muestreo_.
+     */
+    BitVector filas_muestreadas_;
+
+    /**
+     * @brief Posición de texto de cada fila marcada, en orden de fila.
+     */
+    ArregloPlano<uint32_t> muestras_sufijos_;
+
+    /**
+     * @brief Fila del sufijo que comienza en la posición j·paso_muestreo_.
+     */
+    ArregloPlano<uint32_t> muestras_inverso_;
+
+    /**
+     * @brief Largo k de la tabla de k-mers (0 si no tiene).
+     */
+    uint32_t largo_kmer_ = 0;
+
+    /**
+     * @brief Cantidad de símbolos del texto (base de la clave de la tabla de k-mers).
+     */
+    uint32_t simbolos_kmer_ = 0;
+
+    /**
+     * @brief log2 de la cantidad de ranuras de la tabla de k-mers.
+     */
+    uint32_t bits_ranuras_kmer_ = 1;
+
+    /**
+     * @brief Si el texto indexado está plegado a minúsculas (los patrones se pliegan al buscar).
+     */
+    bool ignorar_mayusculas_ = false;
+
+    /**
+     * @brief Código compacto de cada byte para la tabla de k-mers, o SIN_CODIGO_KMER.
+     */
+    ArregloPlano<uint16_t> codigos_kmer_;
+
+    /**
+     * @brief Tabla hash de los k-mers que aparecen: la ranura j ocupa las entradas
+     *        2·j (clave del k-mer por Horner sobre sus códigos) y 2·j + 1
+     *        (inicio | fin << 32, 0 si la ranura está libre).
+     */
+    ArregloPlano<uint64_t> tabla_kmer_;
+
+    static constexpr uint16_t SIN_CODIGO_KMER = 0xFFFF;
+
+    /**
+     * @brief Archivo mapeado del que provienen los arreglos, si el índice fue cargado.
+     */
+    std::shared_ptr<ArchivoMapeado> archivo_;
 };
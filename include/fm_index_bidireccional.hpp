@@ -0,0 +1,223 @@
+/**
+ * @file fm_index_bidireccional.hpp
+ * @brief FM-Index bidireccional para búsqueda aproximada con esquemas de búsqueda.
+ * 
+ * Contiene la clase FMIndexBidireccional, que guarda la BWT del texto y la
+ * del texto invertido con intervalos sincronizados, de modo que un patrón
+ * puede extenderse carácter a carácter hacia la izquierda o hacia la
+ * derecha. Sobre esa extensión se ejecutan esquemas de búsqueda
+ * (Kucherov, Salikhov y Tsur) que encuentran las ocurrencias con a lo más
+ * k sustituciones o k ediciones sin recorrer el texto.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "class_base.hpp"
+#include "archivo_mapeado.hpp"
+#include "bit_vector.hpp"
+#include "tabla_ocurrencias.hpp"
+#include "transformada_bwt.hpp"
+#include "fm_index.hpp"
+
+#include <cstdint>
+
+/**
+ * @brief Intervalos de filas con que se avanza sin escanear, en lugar de contar con rango.
+ * 
+ * Con pocas filas es más barato leer la BWT del intervalo que consultar el
+ * rango de cada símbolo del alfabeto.
+ */
+const size_t UMBRAL_ESCANEO_BIDIRECCIONAL = 64;
+
+/**
+ * @brief Errores que admite la búsqueda aproximada.
+ */
+enum class TipoError {
+    Sustituciones,  ///< Distancia de Hamming: la ocurrencia tiene el largo del patrón
+    Ediciones       ///< Distancia de edición: sustituciones, inserciones y borrados
+};
+
+/**
+ * @class FMIndexBidireccional
+ * @brief FM-Index del texto y del texto invertido con búsqueda aproximada.
+ * 
+ * Cada cadena X se representa con su intervalo en la BWT del texto (filas
+ * cuyos sufijos comienzan con X) y su intervalo en la BWT del texto
+ * invertido (filas que comienzan con X invertida), de igual tamaño. Al
+ * extender X a cX el primero avanza con el paso backward usual y el
+ * segundo se desplaza en la cantidad de caracteres menores que c dentro
+ * del intervalo del primero (tabla de ocurrencias, rangoMenores); Xc es
+ * simétrico.
+ * 
+ * La búsqueda aproximada divide el patrón en partes y ejecuta un esquema
+ * de búsqueda: cada búsqueda recorre las partes en un orden que siempre
+ * extiende el bloque ya procesado por uno de sus extremos, con cotas
+ * inferior y superior de errores acumulados al terminar cada parte. Las
+ * ramas que superan la cota superior o quedan con intervalo vacío se
+ * podan. Se usan los esquemas óptimos de Kucherov et al. para k = 1 y
+ * k = 2, y el de palomar (k + 1 partes, una sin errores) para k mayor.
+ * 
+ * Una posición es ocurrencia si alguna subcadena que comienza en ella está
+ * a distancia a lo más k del patrón; las ocurrencias encontradas por
+ * varias búsquedas del esquema se cuentan una vez.
+ * 
+ * Complejidad temporal:
+ * - Construcción: dos arreglos de sufijos, O(n log n)
+ * - Búsqueda exacta: O(m) pasos de rango
+ * - Búsqueda aproximada: proporcional a los nodos visitados, que con k
+ *   pequeño no depende de n; con ediciones se suma la localización de las
+ *   filas encontradas (O(s) pasos LF cada una)
+ * 
+ * Complejidad espacial: dos tablas de ocurrencias más (n / s)·4 bytes de
+ * muestras y 1.25·n bits de marcas
+ */
+class FMIndexBidireccional : public BaseStructure {
+    public:
+        /**
+         * @brief Construye la BWT del texto, la del texto invertido y las muestras de SA.
+         * 
+         * @param texto Texto a indexar.
+         * @param paso_muestreo Paso de muestreo del arreglo de sufijos (mayor o igual a 1).
+         * @throws std::invalid_argument Si el paso de muestreo es 0.
+         * @throws std::length_error Si el texto no cabe en posiciones de 32 bits.
+         */
+        explicit FMIndexBidireccional(const std::string& texto, uint32_t paso_muestreo = PASO_MUESTREO_SUFIJOS);
+
+        /**
+         * @brief Cantidad de ocurrencias exactas del patrón.
+         */
+        unsigned int buscar(const std::string& patron) const override;
+
+        /**
+         * @brief Cantidad de posiciones donde comienza una ocurrencia con a lo más k errores.
+         * 
+         * @param patron Patrón a buscar.
+         * @param maximo_errores Cantidad máxima de errores k (menor que el largo del patrón).
+         * @param tipo Sustituciones (Hamming) o ediciones (Levenshtein).
+         * @return Cantidad de posiciones de inicio distintas.
+         * @throws std::invalid_argument Si k no es menor que el largo del patrón.
+         */
+        size_t buscarAproximado(const std::string& patron, uint32_t maximo_errores, TipoError tipo) const;
+
+        /**
+         * @brief Posiciones donde comienza una ocurrencia con a lo más k errores, en orden creciente.
+         * 
+         * @throws std::invalid_argument Si k no es menor que el largo del patrón.
+         */
+        std::vector<size_t> localizarAproximado(const std::string& patron, uint32_t maximo_errores, TipoError tipo) const;
+
+        /**
+         * @brief Largo del texto indexado.
+         */
+        size_t getLongitudTexto() const { return longitud_texto_; }
+
+        /**
+         * @brief Bytes de la tabla C, las dos tablas de ocurrencias y las muestras.
+         */
+        size_t getMemoriaBytes() const override;
+
+    private:
+        /**
+         * @brief Intervalo de una cadena en ambas BWT (filas [directo, directo + tamano) y [inverso, inverso + tamano)).
+         */
+        struct Intervalo {
+            size_t directo;
+            size_t inverso;
+            size_t tamano;
+        };
+
+        /**
+         * @brief Una BWT (sin el centinela) con su tabla de ocurrencias.
+         */
+        struct LadoBWT {
+            TablaOcurrencias rango;
+            size_t fila_centinela = 0;
+
+            /**
+             * @brief Apariciones de c en las filas [0, i), sin contar el centinela.
+             */
+            size_t rangoFilas(unsigned char c, size_t i) const { return rango.rango(c, i > fila_centinela ? i - 1 : i); }
+
+            /**
+             * @brief Caracteres menores que c en las filas [0, i), contando el centinela.
+             */
+            size_t menoresFilas(unsigned char c, size_t i) const {
+                return rango.rangoMenores(c, i > fila_centinela ? i - 1 : i) + (i > fila_centinela ? 1 : 0);
+            }
+
+            /**
+             * @brief Carácter de la BWT en una fila distinta de la del centinela.
+             */
+            unsigned char caracterDeFila(size_t fila) const { return rango.acceder(fila > fila_centinela ? fila - 1 : fila); }
+        };
+
+        /**
+         * @brief Parte del patrón y su dirección en una búsqueda del esquema.
+         */
+        struct PasoBusqueda {
+            size_t posicion;        ///< Carácter del patrón que se procesa
+            bool hacia_derecha;     ///< Extender la cadena por la derecha (si no, por la izquierda)
+            size_t parte;           ///< Índice de la parte en el orden de la búsqueda
+            bool fin_de_parte;      ///< Último carácter de la parte: se verifica la cota inferior
+        };
+
+        /**
+         * @brief Estado compartido por la recursión de una búsqueda del esquema.
+         */
+        struct EstadoBusqueda;
+
+        /**
+         * @brief Extiende el intervalo con un carácter por la izquierda o la derecha.
+         * 
+         * @return Intervalo resultante (tamano 0 si la cadena no aparece).
+         */
+        Intervalo extender(const Intervalo& intervalo, unsigned char c, bool hacia_derecha) const;
+
+        /**
+         * @brief Llama a visitar(c, intervalo_extendido) con cada carácter que extiende la cadena.
+         */
+        template<typename Visitar>
+        void extenderTodos(const Intervalo& intervalo, bool hacia_derecha, Visitar visitar) const;
+
+        /**
+         * @brief Avanza una búsqueda del esquema desde el paso indicado.
+         * 
+         * @param paso Índice del paso actual en el plan de la búsqueda.
+         * @param intervalo Intervalo de la cadena alineada hasta ahora.
+         * @param errores Errores acumulados.
+         * @param tras_insercion El último movimiento fue una inserción en este mismo hueco.
+         */
+        void avanzar(EstadoBusqueda& estado, size_t paso, const Intervalo& intervalo, uint32_t errores, bool tras_insercion) const;
+
+        /**
+         * @brief Ejecuta el esquema de búsqueda y agrupa los intervalos encontrados.
+         * 
+         * @return Intervalos distintos en la BWT del texto con el menor error de cada uno.
+         */
+        std::vector<std::pair<Intervalo, uint32_t>> intervalosAproximados(const std::string& patron, uint32_t maximo_errores, TipoError tipo) const;
+
+        /**
+         * @brief Posición de texto del sufijo de una fila de la BWT del texto.
+         */
+        size_t posicionDeFila(size_t fila) const;
+
+        size_t longitud_texto_ = 0;
+        uint32_t paso_muestreo_ = PASO_MUESTREO_SUFIJOS;
+        ArregloPlano<uint64_t> tabla_inicio_caracter_;
+        LadoBWT directo_;               ///< BWT del texto
+        LadoBWT inverso_;               ///< BWT del texto invertido
+        std::vector<unsigned char> simbolos_;  ///< Caracteres presentes, en orden
+
+        /**
+         * @brief Marca las filas cuyo sufijo comienza en un múltiplo de paso_muestreo_.
+         */
+        BitVector filas_muestreadas_;
+
+        /**
+         * @brief Posición de texto de cada fila marcada, en orden de fila.
+         */
+        ArregloPlano<uint32_t> muestras_sufijos_;
+};
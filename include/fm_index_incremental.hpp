@@ -0,0 +1,210 @@
+/**
+ * @file fm_index_incremental.hpp
+ * @brief FM-Index que admite agregar texto al final sin reconstruirse completo.
+ * 
+ * Contiene la clase FMIndexIncremental, organizada como un árbol LSM: el
+ * texto recién agregado queda en un delta pequeño que se recorre
+ * directamente, cada delta lleno se sella como un segmento FMIndex y los
+ * segmentos de tamaño parecido se fusionan en uno mayor en un hilo de
+ * fondo. Las consultas suman las ocurrencias de cada parte y las que
+ * cruzan los bordes entre partes.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "class_base.hpp"
+#include "fm_index.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+/**
+ * @brief Bytes del delta antes de sellarlo como segmento (64 KiB).
+ * 
+ * Acota el recorrido que cada consulta hace del delta y el costo de
+ * construir el segmento más pequeño.
+ */
+const size_t CAPACIDAD_DELTA_INCREMENTAL = 1 << 16;
+
+/**
+ * @brief Dos segmentos contiguos se fusionan si el anterior es menor que este factor por el último.
+ * 
+ * Con 2 los tamaños de los segmentos forman una sucesión al menos geométrica
+ * de razón 2, como un contador binario: hay O(log(n / delta)) segmentos y
+ * cada byte se reconstruye O(log(n / delta)) veces en total.
+ */
+const size_t FACTOR_FUSION_INCREMENTAL = 2;
+
+/**
+ * @brief Opciones de FMIndexIncremental.
+ */
+struct OpcionesIncremental {
+    size_t capacidad_delta = CAPACIDAD_DELTA_INCREMENTAL;   ///< Bytes del delta antes de sellarlo (mayor que 0)
+    size_t factor_fusion = FACTOR_FUSION_INCREMENTAL;       ///< Factor de tamaño para fusionar segmentos (mayor que 1)
+    bool en_segundo_plano = true;                           ///< Construir y fusionar segmentos en un hilo propio
+    OpcionesFMIndex opciones_indice;                        ///< Opciones de cada segmento
+};
+
+/**
+ * @class FMIndexIncremental
+ * @brief FM-Index por segmentos con delta dinámico y fusiones en segundo plano.
+ * 
+ * El texto es la concatenación de los tramos (segmentos FMIndex o textos
+ * sellados que esperan su índice) seguida del delta. agregar() solo copia
+ * bytes al delta; al llenarse, el delta pasa a ser un tramo sellado y el
+ * hilo de mantenimiento construye un FMIndex con todos los tramos sellados
+ * que encuentre pendientes (si agregar() va más rápido que la construcción,
+ * se acumulan y se indexan juntos) y fusiona los segmentos finales
+ * mientras el anterior sea menor que factor_fusion por el último.
+ * Cada fusión recupera el texto de ambos segmentos con extraer() y
+ * construye un índice nuevo; las consultas siguen usando los tramos
+ * anteriores hasta que el nuevo reemplaza a los dos.
+ * 
+ * Una consulta toma una instantánea de los tramos (punteros compartidos e
+ * inmutables) y cuenta:
+ * - las ocurrencias dentro de cada tramo (FMIndex::buscar o un recorrido
+ *   para los textos sellados y el delta), y
+ * - las que comienzan en los últimos m - 1 bytes de un tramo y terminan en
+ *   los siguientes, extrayendo m - 1 bytes a cada lado de cada borde.
+ * 
+ * Complejidad temporal:
+ * - agregar(): O(1) amortizado por byte en el hilo que agrega; el hilo de
+ *   mantenimiento reconstruye cada byte O(log(n / delta)) veces
+ * - buscar(): O(t·(m + s) + delta) con t = O(log(n / delta)) tramos y s el
+ *   paso de muestreo de extraer()
+ * 
+ * Complejidad espacial: la suma de los segmentos más el delta y los textos
+ * sellados pendientes.
+ * 
+ * @note agregar() no debe llamarse desde varios hilos a la vez; buscar() sí,
+ *       incluso mientras otro hilo agrega.
+ */
+class FMIndexIncremental : public BaseStructure {
+    public:
+        /**
+         * @brief Crea un índice vacío.
+         * 
+         * @throws std::invalid_argument Si capacidad_delta es 0 o factor_fusion es menor que 2.
+         */
+        explicit FMIndexIncremental(const OpcionesIncremental& opciones = OpcionesIncremental());
+
+        /**
+         * @brief Crea el índice, agrega el texto y espera a que terminen las fusiones.
+         */
+        explicit FMIndexIncremental(const std::string& texto, const OpcionesIncremental& opciones = OpcionesIncremental());
+
+        /**
+         * @brief Detiene el hilo de mantenimiento (espera la construcción en curso).
+         */
+        ~FMIndexIncremental();
+
+        FMIndexIncremental(const FMIndexIncremental&) = delete;
+        FMIndexIncremental& operator=(const FMIndexIncremental&) = delete;
+
+        /**
+         * @brief Agrega bytes al final del texto indexado.
+         * 
+         * Con en_segundo_plano = false, construye y fusiona los segmentos
+         * antes de retornar.
+         * 
+         * @throws La excepción de una construcción fallida en segundo plano.
+         */
+        void agregar(std::string_view bloque);
+
+        /**
+         * @brief Espera a que se construyan los segmentos sellados y terminen las fusiones.
+         * 
+         * @throws La excepción de una construcción fallida en segundo plano.
+         */
+        void esperarFusiones();
+
+        /**
+         * @brief Cantidad de ocurrencias del patrón en todo el texto agregado.
+         */
+        unsigned int buscar(const std::string& patron) const override;
+
+        /**
+         * @brief Bytes agregados hasta ahora.
+         */
+        size_t getLongitudTexto() const;
+
+        /**
+         * @brief Cantidad de segmentos FMIndex ya construidos.
+         */
+        size_t getCantidadSegmentos() const;
+
+        /**
+         * @brief Bytes indexados por todas las construcciones (sellos y fusiones).
+         * 
+         * Dividido por getLongitudTexto() es la cantidad de veces que se
+         * reconstruyó cada byte en promedio.
+         */
+        uint64_t getBytesReconstruidos() const { return bytes_reconstruidos_.load(); }
+
+        /**
+         * @brief Bytes de los segmentos, los textos sellados pendientes y el delta.
+         */
+        size_t getMemoriaBytes() const override;
+
+    private:
+        /**
+         * @brief Parte del texto: un segmento FMIndex o un texto sellado que espera su índice.
+         */
+        struct Tramo {
+            std::shared_ptr<const FMIndex> indice;
+            std::shared_ptr<const std::string> texto;
+            size_t longitud = 0;
+        };
+
+        using Tramos = std::vector<Tramo>;
+
+        /**
+         * @brief Subcadena [inicio, inicio + largo) del tramo.
+         */
+        static std::string extraerTramo(const Tramo& tramo, size_t inicio, size_t largo);
+
+        /**
+         * @brief Ocurrencias del patrón completamente dentro del tramo.
+         */
+        static size_t contarEnTramo(const Tramo& tramo, const std::string& patron);
+
+        /**
+         * @brief Sella el delta como tramo pendiente (con candado_ tomado).
+         */
+        void sellarDelta();
+
+        /**
+         * @brief Construye un segmento con los tramos sellados pendientes o fusiona los dos últimos.
+         * 
+         * @return false si no había nada que hacer.
+         */
+        bool avanzarMantenimiento();
+
+        /**
+         * @brief Ciclo del hilo de mantenimiento.
+         */
+        void trabajar();
+
+        OpcionesIncremental opciones_;
+
+        mutable std::mutex candado_;
+        std::condition_variable hay_trabajo_;
+        std::condition_variable sin_trabajo_;
+        std::shared_ptr<const Tramos> tramos_;      ///< Instantánea actual (protegido por candado_)
+        std::string delta_;                         ///< Bytes aún no sellados (protegido por candado_)
+        size_t longitud_texto_ = 0;                 ///< Protegido por candado_
+        bool pendiente_ = false;                    ///< Hay tramos sellados sin procesar (protegido por candado_)
+        bool ocupado_ = false;                      ///< El hilo está construyendo o fusionando (protegido por candado_)
+        bool detener_ = false;
+        std::exception_ptr error_;
+        std::atomic<uint64_t> bytes_reconstruidos_{0};
+        std::thread hilo_;
+};
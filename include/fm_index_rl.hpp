@@ -0,0 +1,221 @@
+/**
+ * @file fm_index_rl.hpp
+ * @brief FM-Index sobre la BWT comprimida por runs (r-index).
+ * 
+ * Contiene la clase FMIndexRL, cuyo tamaño es proporcional a la cantidad r
+ * de runs de la BWT y no al largo del texto, y la fábrica crearIndiceFM,
+ * que elige entre FMIndex y FMIndexRL según la proporción r/n medida.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "class_base.hpp"
+#include "archivo_mapeado.hpp"
+#include "wavelet_matrix.hpp"
+#include "transformada_bwt.hpp"
+#include "fm_index.hpp"
+
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Proporción r/n bajo la cual crearIndiceFM elige FMIndexRL.
+ * 
+ * FMIndexRL ocupa cerca de 50 bytes por run y FMIndex entre 0.7 y 1.7
+ * bytes por carácter, de modo que la versión por runs conviene cuando hay
+ * al menos ~50 caracteres por run.
+ */
+const double UMBRAL_PROPORCION_RUNS = 0.02;
+
+/**
+ * @class FMIndexRL
+ * @brief FM-Index por runs con conteo y localización en espacio O(r).
+ * 
+ * La BWT de textos muy repetitivos (versiones de un documento, genomas de
+ * una misma especie, logs) tiene pocos runs de caracteres iguales. Esta
+ * clase guarda solo la información de cada run:
+ * - Fila de inicio de cada run (búsqueda binaria para ubicar una fila)
+ * - Carácter de cada run, en una wavelet matrix para contar runs por carácter
+ * - Por carácter, los índices de sus runs y los largos acumulados
+ * - La posición de texto de la última fila de cada run
+ * - La función phi muestreada en los bordes de runs
+ * 
+ * El rango de c en [0, i) es la suma de los largos de los runs de c
+ * anteriores al run que contiene i, más la parte de ese run si es de c.
+ * 
+ * La localización sigue al r-index (Gagie, Navarro y Prezza): durante la
+ * búsqueda backward se mantiene la posición de texto de la última fila del
+ * intervalo (toehold). Si la BWT en esa fila no es el carácter buscado, la
+ * última aparición del carácter en el intervalo es el final de un run y su
+ * posición está muestreada. Al terminar, las demás filas del intervalo se
+ * obtienen hacia arriba con phi(SA[i]) = SA[i - 1], que se desplaza en uno
+ * junto con la posición mientras no se cruce el inicio de un run.
+ * 
+ * El centinela es un run propio de código 0; el carácter c usa el código c + 1.
+ * 
+ * Complejidad temporal:
+ * - Construcción: O(n log n) (arreglo de sufijos completo)
+ * - Búsqueda: O(m·(log r + log σ))
+ * - Localización: O(m·(log r + log σ) + occ·log r)
+ * 
+ * Complejidad espacial: O(r) palabras.
+ * 
+ * @note No admite extracción de subcadenas ni persistencia en disco.
+ */
+class FMIndexRL : public BaseStructure {
+public:
+    /**
+     * @brief Construye el índice sobre un texto.
+     * 
+     * @param texto Texto a indexar.
+     * @param ignorar_mayusculas Indexar el texto plegado a minúsculas y plegar los patrones.
+     * @throws std::length_error Si el texto no cabe en posiciones de tipo int.
+     */
+    explicit FMIndexRL(const std::string& texto, bool ignorar_mayusculas = false);
+
+    /**
+     * @brief Construye el índice a partir de una BWT ya construida.
+     * 
+     * @param transformada Arreglo de sufijos y BWT del texto (de plegarCaso(texto)
+     *        si ignorar_mayusculas es true).
+     * @param ignorar_mayusculas Plegar los patrones a minúsculas al buscar.
+     */
+    explicit FMIndexRL(const TransformadaBWT& transformada, bool ignorar_mayusculas = false);
+
+    /**
+     * @brief Cantidad de ocurrencias del patrón (0 para el patrón vacío).
+     */
+    unsigned int buscar(const std::string& patron) const override;
+
+    /**
+     * @brief Posiciones del texto en que aparece el patrón.
+     * 
+     * @param patron Patrón a buscar.
+     * @return Posiciones de inicio de cada ocurrencia, en orden creciente.
+     * 
+     * @complexity
+     * - Tiempo: O(m·(log r + log σ) + occ·log r + occ log occ)
+     */
+    std::vector<size_t> localizar(const std::string& patron) const;
+
+    /**
+     * @brief Largo del texto indexado (sin el centinela).
+     */
+    size_t getLongitudTexto() const { return longitud_texto_; }
+
+    /**
+     * @brief Cantidad de runs de la BWT, contando el del centinela.
+     */
+    size_t getCantidadRuns() const { return codigos_runs_.size(); }
+
+    /**
+     * @brief Bytes ocupados por las estructuras de runs y las muestras.
+     */
+    size_t getMemoriaBytes() const override;
+
+private:
+    /**
+     * @brief Run que contiene la fila (0 <= fila <= n).
+     */
+    size_t runDeFila(size_t fila) const;
+
+    /**
+     * @brief Apariciones del código en las filas [0, i) de la BWT.
+     */
+    size_t rango(uint32_t codigo, size_t i) const;
+
+    /**
+     * @brief Posición de texto del sufijo de la fila anterior a la del sufijo en posicion.
+     */
+    size_t phi(size_t posicion) const;
+
+    /**
+     * @brief Carácter del patrón tal como se busca en la BWT (plegado si corresponde).
+     */
+    unsigned char caracterPatron(char caracter) const {
+        unsigned char byte = static_cast<unsigned char>(caracter);
+        return ignorar_mayusculas_ ? plegarCaracter(byte) : byte;
+    }
+
+    /**
+     * @brief Índice del k-ésimo run (desde 0) del código en runs_por_codigo_.
+     */
+    size_t indiceRunDeCodigo(uint32_t codigo, size_t k) const {
+        return static_cast<size_t>(desplazamiento_codigo_[codigo]) + k;
+    }
+
+    /**
+     * @brief Largo total de los primeros k runs del código.
+     */
+    size_t largoAcumulado(uint32_t codigo, size_t k) const {
+        return static_cast<size_t>(largos_acumulados_[desplazamiento_codigo_[codigo] + codigo + k]);
+    }
+
+    size_t longitud_texto_ = 0;
+    bool ignorar_mayusculas_ = false;
+    ArregloPlano<uint64_t> tabla_inicio_caracter_;
+
+    /**
+     * @brief Fila de inicio de cada run, más n + 1 al final.
+     */
+    ArregloPlano<uint64_t> inicios_runs_;
+
+    /**
+     * @brief Código de cada run (0 para el centinela, c + 1 para el carácter c).
+     */
+    ArregloPlano<uint16_t> codigos_runs_;
+
+    /**
+     * @brief Códigos de los runs, para contar los runs de un código antes de otro run.
+     */
+    WaveletMatrix cabezas_runs_;
+
+    /**
+     * @brief Por código, inicio de sus runs en runs_por_codigo_ (258 entradas).
+     */
+    ArregloPlano<uint64_t> desplazamiento_codigo_;
+
+    /**
+     * @brief Índices de runs agrupados por código, en orden de fila.
+     */
+    ArregloPlano<uint64_t> runs_por_codigo_;
+
+    /**
+     * @brief Por código, sumas prefijas de los largos de sus runs (una entrada extra por código).
+     */
+    ArregloPlano<uint64_t> largos_acumulados_;
+
+    /**
+     * @brief Posición de texto del sufijo de la última fila de cada run.
+     */
+    ArregloPlano<uint64_t> muestras_fin_run_;
+
+    /**
+     * @brief Posiciones SA[p] - 1 para cada inicio de run p, en orden creciente.
+     */
+    ArregloPlano<uint64_t> claves_phi_;
+
+    /**
+     * @brief phi de cada clave de claves_phi_.
+     */
+    ArregloPlano<uint64_t> valores_phi_;
+};
+
+/**
+ * @brief Construye el FM-Index más conveniente para el texto.
+ * 
+ * Construye la BWT una sola vez, mide la proporción de runs r/n y devuelve
+ * un FMIndexRL si es menor que el umbral o un FMIndex en otro caso.
+ * 
+ * @param texto Texto a indexar.
+ * @param umbral_runs Proporción r/n bajo la cual se usa la versión por runs.
+ * @param opciones Opciones del FMIndex si se elige la versión no comprimida
+ *        (ignorar_mayusculas se aplica a ambas variantes).
+ * @return Índice construido.
+ */
+std::unique_ptr<BaseStructure> crearIndiceFM(const std::string& texto,
+                                             double umbral_runs = UMBRAL_PROPORCION_RUNS,
+                                             const OpcionesFMIndex& opciones = OpcionesFMIndex());
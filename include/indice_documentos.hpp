@@ -0,0 +1,114 @@
+/**
+ * @file indice_documentos.hpp
+ * @brief Índice generalizado sobre una colección de documentos.
+ * 
+ * Contiene la clase IndiceDocumentos, un único FMIndex sobre la
+ * concatenación de todos los documentos (separados por un byte reservado)
+ * junto con el arreglo de documentos: el documento de cada fila de la BWT,
+ * guardado en una wavelet matrix. Responde cuántas veces aparece un patrón
+ * en cada documento, qué documentos lo contienen y cuáles son los k
+ * documentos donde más aparece sin recorrer los archivos.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "class_base.hpp"
+#include "fm_index.hpp"
+#include "wavelet_matrix.hpp"
+
+#include <memory>
+
+/**
+ * @brief Byte que separa los documentos en el texto indexado; no puede aparecer en ellos.
+ */
+const char SEPARADOR_DOCUMENTOS = '\0';
+
+/**
+ * @brief Apariciones de un patrón en un documento.
+ */
+struct OcurrenciasDocumento {
+    size_t documento;       ///< Índice del documento en la colección
+    size_t ocurrencias;     ///< Apariciones del patrón en el documento
+};
+
+/**
+ * @class IndiceDocumentos
+ * @brief FM-Index generalizado con arreglo de documentos para consultas por documento.
+ * 
+ * Las filas de la BWT cuyos sufijos comienzan con el patrón forman un
+ * intervalo; el documento de cada una está en la misma posición del
+ * arreglo de documentos. Sobre ese rango la wavelet matrix enumera los
+ * documentos distintos con su frecuencia, o los k más frecuentes, en
+ * tiempo proporcional a los documentos reportados y no a las ocurrencias
+ * ni a la cantidad de documentos de la colección.
+ * 
+ * Como cada documento termina en SEPARADOR_DOCUMENTOS, un patrón sin ese
+ * byte nunca cruza de un documento al siguiente.
+ * 
+ * Complejidad temporal:
+ * - Construcción: O(N log N) con N el largo total de la colección
+ * - Conteo total: O(m) pasos de rango
+ * - Conteo por documento y listado: O(m + d·log D) con d los documentos
+ *   que contienen el patrón y D el total de documentos
+ * - k más frecuentes: O(m + k·log D·log(k·log D)) en el caso usual
+ * 
+ * Complejidad espacial: el FMIndex de la concatenación más N·⌈log2 D⌉ bits
+ * del arreglo de documentos
+ */
+class IndiceDocumentos : public BaseStructure {
+    public:
+        /**
+         * @brief Construye el índice sobre la concatenación de los documentos.
+         * 
+         * @param documentos Contenido de cada documento; su posición es su identificador.
+         * @param opciones Opciones del FMIndex subyacente.
+         * @throws std::invalid_argument Si no hay documentos o alguno contiene SEPARADOR_DOCUMENTOS.
+         * @throws std::length_error Si la colección no cabe en posiciones de 32 bits.
+         */
+        explicit IndiceDocumentos(const std::vector<std::string>& documentos, const OpcionesFMIndex& opciones = OpcionesFMIndex());
+
+        /**
+         * @brief Ocurrencias del patrón sumadas sobre todos los documentos.
+         */
+        unsigned int buscar(const std::string& patron) const override;
+
+        /**
+         * @brief Ocurrencias del patrón en cada documento que lo contiene, en orden de documento.
+         */
+        std::vector<OcurrenciasDocumento> contarPorDocumento(const std::string& patron) const;
+
+        /**
+         * @brief Documentos que contienen el patrón, en orden creciente (listado de documentos).
+         */
+        std::vector<size_t> listarDocumentos(const std::string& patron) const;
+
+        /**
+         * @brief Los k documentos donde más aparece el patrón, de mayor a menor frecuencia.
+         * 
+         * A igual frecuencia va primero el documento de menor índice.
+         */
+        std::vector<OcurrenciasDocumento> documentosMasFrecuentes(const std::string& patron, size_t k) const;
+
+        /**
+         * @brief Cantidad de documentos de la colección.
+         */
+        size_t getCantidadDocumentos() const { return cantidad_documentos_; }
+
+        /**
+         * @brief Bytes del FMIndex y del arreglo de documentos.
+         */
+        size_t getMemoriaBytes() const override;
+
+    private:
+        /**
+         * @brief Filas de la BWT del patrón; vacío si el patrón contiene el separador.
+         */
+        std::pair<size_t, size_t> intervalo(const std::string& patron) const;
+
+        std::unique_ptr<FMIndex> indice_;
+        WaveletMatrix documentos_;      ///< Documento del sufijo de cada fila de la BWT
+        size_t cantidad_documentos_ = 0;
+};
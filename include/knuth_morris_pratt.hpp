@@ -3,7 +3,8 @@
  * @brief Implementación del algoritmo de búsqueda Knuth-Morris-Pratt (KMP).
  * 
  * Contiene la clase KnuthMorrisPratt que implementa el algoritmo KMP,
- * conocido por su búsqueda lineal eficiente sin retroceso en el texto.
+ * conocido por su búsqueda lineal eficiente sin retroceso en el texto, y
+ * PatronKnuthMorrisPratt, el patrón con su tabla de fallas ya calculada.
  * 
  * @date 2025
  */
@@ -11,6 +12,16 @@
 #pragma once
 
 #include "definiciones.hpp"
+#include "plegado_caso.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Tamaño máximo por defecto del autómata de PatronKnuthMorrisPratt (32 KiB, una caché L1 de datos).
+ */
+const size_t PRESUPUESTO_AUTOMATA_KMP = 32 * 1024;
 
 /**
  * @class KnuthMorrisPratt
@@ -24,6 +35,7 @@
  * - Preprocesa el patrón para crear la tabla de fallas
  * - Nunca retrocede en el texto durante la búsqueda
  * - Garantiza complejidad lineal en todos los casos
+ * - Variante sin distinción de mayúsculas que compara caracteres plegados
  * 
  * Complejidad temporal:
  * - Preprocesamiento: O(m) donde m es el tamaño del patrón
@@ -53,7 +65,36 @@ class KnuthMorrisPratt {
          */
         static unsigned int buscar(const std::string& texto, const std::string& patron);
 
-    private:
+        /**
+         * @brief Igual que buscar(), sin distinguir mayúsculas de minúsculas (ASCII).
+         * 
+         * La tabla de fallas se calcula sobre el patrón plegado y cada
+         * carácter del texto se pliega al leerlo.
+         * 
+         * @param texto Texto donde se realizará la búsqueda.
+         * @param patron Patrón a buscar en el texto.
+         * @return Cantidad de ocurrencias encontradas del patrón en el texto.
+         */
+        static unsigned int buscarSinMayusculas(const std::string& texto, const std::string& patron);
+
+        /**
+         * @brief Igual que buscar(), sobre un segmento del texto sin copiarlo (MotorSegmento).
+         */
+        static unsigned int buscarEnSegmento(std::string_view segmento, const std::string& patron);
+
+        /**
+         * @brief Igual que buscar(), recorriendo el texto con el autómata determinista del patrón.
+         * 
+         * Si el autómata excede PRESUPUESTO_AUTOMATA_KMP se usa la tabla de
+         * fallas, con el mismo resultado.
+         */
+        static unsigned int buscarAutomata(const std::string& texto, const std::string& patron);
+
+        /**
+         * @brief Igual que buscarAutomata(), sobre un segmento del texto sin copiarlo (MotorSegmento).
+         */
+        static unsigned int buscarAutomataEnSegmento(std::string_view segmento, const std::string& patron);
+
         /**
          * @brief Calcula la tabla de fallas (failure function) para el patrón.
          * 
@@ -72,4 +113,83 @@ class KnuthMorrisPratt {
          * - Espacio: O(m) para el vector resultante
          */
         static vc calcularTablaDeSaltos(const std::string& patron);
-};
\ No newline at end of file
+};
+
+/**
+ * @class PatronKnuthMorrisPratt
+ * @brief Patrón con su tabla de fallas calculada, reutilizable en muchos textos.
+ * 
+ * La tabla de fallas (el borde más largo de cada prefijo del patrón) se
+ * calcula una vez en O(m); buscar() recorre el texto siguiendo sus enlaces
+ * sin recalcularla ni reservar memoria.
+ * 
+ * Opcionalmente compila la tabla de fallas en un autómata determinista:
+ * los bytes se agrupan en clases (una por byte distinto del patrón y una
+ * para el resto) y cada estado guarda su transición para cada clase, de
+ * modo que cada byte del texto cuesta dos lecturas de tabla y ningún salto
+ * condicional dependiente de los datos. Si el autómata ocupa más que el
+ * presupuesto se usa la tabla de fallas.
+ */
+class PatronKnuthMorrisPratt {
+    public:
+        /**
+         * @brief Preprocesa el patrón.
+         * 
+         * @param patron Patrón a buscar.
+         * @param ignorar_mayusculas Comparar sin distinguir mayúsculas de minúsculas (ASCII).
+         * @param usar_automata Compilar el autómata determinista si cabe en el presupuesto.
+         * @param presupuesto_automata Bytes máximos del autómata; si los excede se usa la tabla de fallas.
+         */
+        explicit PatronKnuthMorrisPratt(const std::string& patron, bool ignorar_mayusculas = false,
+                                        bool usar_automata = false, size_t presupuesto_automata = PRESUPUESTO_AUTOMATA_KMP);
+
+        /**
+         * @brief Cantidad de ocurrencias del patrón en el texto, incluidas las solapadas.
+         * 
+         * @complexity
+         * - Tiempo: O(n)
+         * - Espacio: O(1) adicional
+         */
+        unsigned int buscar(std::string_view texto) const;
+
+        /**
+         * @brief Patrón tal como se compara (plegado si ignorar_mayusculas).
+         */
+        const std::string& getPatron() const { return patron_; }
+
+        /**
+         * @brief Indica si buscar() recorre el autómata (false si no se pidió o no cabía).
+         */
+        bool usaAutomata() const { return !automata_.empty(); }
+
+        /**
+         * @brief Bytes del autómata y de la tabla de clases (0 sin autómata).
+         */
+        size_t getMemoriaAutomataBytes() const;
+
+    private:
+        /**
+         * @brief Búsqueda KMP sobre los caracteres del texto plegados por plegar.
+         */
+        template<typename Plegado>
+        unsigned int buscarCon(std::string_view texto, Plegado plegar) const;
+
+        /**
+         * @brief Construye clases_ y automata_ a partir de la tabla de fallas.
+         * 
+         * @param cantidad_clases Bytes distintos del patrón más uno.
+         */
+        void construirAutomata(size_t cantidad_clases);
+
+        /**
+         * @brief Búsqueda recorriendo el autómata: un paso por byte del texto.
+         */
+        unsigned int buscarAutomata(std::string_view texto) const;
+
+        std::string patron_;
+        bool ignorar_mayusculas_;
+        vc tabla_de_saltos_;
+        std::array<uint16_t, 256> clases_{};    ///< Clase de cada byte del texto (tras plegarlo); 0 = ausente del patrón
+        std::vector<uint32_t> automata_;        ///< Transiciones: automata_[estado + clase], con estado = q * cantidad de clases
+        uint32_t estado_final_ = 0;             ///< Estado que indica una ocurrencia (m * cantidad de clases)
+};
@@ -6,6 +6,17 @@
  * rendimiento general de diferentes algoritmos y estructuras de datos
  * utilizados en búsqueda de patrones. Incluye exportación de resultados a JSON.
  * 
+ * Cada hilo arma su propia medición (iniciarMedicion hasta guardarResultado),
+ * por lo que varios hilos pueden medir a la vez; los resultados guardados y
+ * la memoria acumulada son compartidos. La memoria informada es la del
+ * proceso completo.
+ * 
+ * La construcción de cada estructura se mide también por fases
+ * (TRAZAR_FASE): el resultado incluye la duración de cada fase y
+ * guardarResultadosFinales escribe, junto a los resultados, una traza con
+ * formato de eventos de Chrome. Compilando con -DCONTADORES_MOTORES, cada
+ * resultado incluye además los contadores de operaciones de la búsqueda.
+ * 
  * @date 2025
  */
 
@@ -19,6 +30,8 @@
 #include "robin_karp.hpp"
 #include "boyer_moore.hpp"
 #include "knuth_morris_pratt.hpp"
+#include "traza.hpp"
+#include "contadores.hpp"
 
 #include <chrono>
 #include <functional>
@@ -83,19 +96,60 @@ void registrarConstruccion(size_t mem_inicio, size_t mem_fin, std::chrono::durat
  */
 void registrarBusqueda(size_t mem_inicio, size_t mem_fin, std::chrono::duration<double, std::milli> duracion, unsigned int ocurrencias);
 
+/**
+ * @brief Registra la memoria que la estructura reporta para sus propios datos.
+ * @param bytes Bytes ocupados por la estructura (BaseStructure::getMemoriaBytes).
+ */
+void registrarMemoriaEstructura(size_t bytes);
+
+/**
+ * @brief Registra la duración de las fases de la construcción y guarda sus eventos para la traza.
+ * 
+ * Las fases del mismo nombre se suman y cada fase incluye a las que se
+ * abrieron dentro de ella; la fase más externa (profundidad 0) es la
+ * construcción completa y solo va a la traza.
+ * 
+ * @param traza Registro activo durante la construcción.
+ */
+void registrarFasesConstruccion(const RegistroTraza& traza);
+
+/**
+ * @brief Registra los contadores de operaciones del hilo desde el último reiniciarContadoresMotor.
+ * 
+ * Solo agrega "contadores_motor" al resultado si se compiló con -DCONTADORES_MOTORES.
+ */
+void registrarContadoresMotor();
+
 /**
  * @brief Guarda el resultado actual en el arreglo de resultados.
  */
 void guardarResultado();
 
+/**
+ * @brief Retira los resultados acumulados sin escribirlos, para revisarlos en memoria.
+ * 
+ * Descarta también la memoria acumulada y los eventos de traza pendientes,
+ * igual que guardarResultadosFinales.
+ * 
+ * @return Resultados guardados desde la última escritura.
+ */
+nlohmann::json extraerResultados();
+
 /**
  * @brief Guarda todos los resultados en un archivo JSON y muestra la memoria total acumulada.
+ * 
+ * Si hubo fases registradas, las escribe como eventos de traza de Chrome
+ * en test/trazas/<nombre_archivo>.json (se abre con chrome://tracing o Perfetto).
+ * 
  * @param nombre_archivo Nombre del archivo en que se buscara el patron
  * @param patron Patrón que se buscó.
- * @param ocurrencias Total de ocurrencias encontradas.
+ * @param ocurrencias Ocurrencias exactas en que coincidieron los motores (0 si difirieron).
+ * @param ocurrencias_sin_mayusculas Ocurrencias sin distinguir mayúsculas en que coincidieron
+ *        los motores SinMayusculas con la referencia plegada (0 si difirieron).
  * @param memoria_maxima_kb Memoria máxima usada (no usada en esta versión, pero se mantiene el parámetro).
  */
-void guardarResultadosFinales(const std::string& nombre_archivo, const std::string& patron, unsigned int ocurrencias, size_t memoria_maxima_kb);
+void guardarResultadosFinales(const std::string& nombre_archivo, const std::string& patron, unsigned int ocurrencias,
+                              unsigned int ocurrencias_sin_mayusculas, size_t memoria_maxima_kb);
 
 /**
  * @brief Ejecuta y mide un algoritmo de búsqueda.
@@ -105,7 +159,7 @@ void guardarResultadosFinales(const std::string& nombre_archivo, const std::stri
  * @param patron Patrón a buscar.
  * @return Cantidad de ocurrencias encontradas.
  */
-unsigned int medirAlgoritmo(const std::string& nombre, unsigned int(*func)(const std::string&, const std::string&), 
+unsigned int medirAlgoritmo(const std::string& nombre, const std::function<unsigned int(const std::string&, const std::string&)>& func, 
                             const std::string& texto, const std::string& patron);
 
 /**
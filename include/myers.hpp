@@ -0,0 +1,111 @@
+/**
+ * @file myers.hpp
+ * @brief Búsqueda aproximada con a lo más k ediciones (Myers / Hyyrö, paralelismo de bits).
+ * 
+ * Contiene la clase PatronMyers, que recorre el texto una vez manteniendo
+ * la última columna de la matriz de distancia de edición codificada como
+ * vectores de diferencias de 64 bits, y la clase Myers con las búsquedas
+ * estáticas al estilo de los demás algoritmos en línea.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Ocurrencia aproximada: posición donde termina y distancia de edición.
+ */
+struct OcurrenciaAproximada {
+    size_t fin;                 ///< Posición del último carácter de la ocurrencia en el texto
+    unsigned int distancia;     ///< Mínima distancia de edición de una subcadena que termina en fin
+};
+
+/**
+ * @class PatronMyers
+ * @brief Patrón preprocesado para la búsqueda aproximada de Myers.
+ * 
+ * Una posición j del texto es una ocurrencia si alguna subcadena que
+ * termina en j está a distancia de edición (inserciones, borrados y
+ * sustituciones) a lo más k del patrón. Cerca de una ocurrencia exacta
+ * suelen terminar varias aproximadas (j - 1, j, j + 1 con k = 1); se
+ * cuentan todas las posiciones de término.
+ * 
+ * El patrón se divide en bloques de 64 caracteres (algoritmo por bloques
+ * de Hyyrö): cada byte del texto actualiza los bloques con unas pocas
+ * operaciones de bits y propaga el acarreo horizontal al bloque siguiente.
+ * 
+ * Complejidad temporal:
+ * - Preprocesamiento: O(σ·⌈m/64⌉ + m)
+ * - Búsqueda: O(n·⌈m/64⌉), independiente de k
+ * 
+ * Complejidad espacial: O(σ·⌈m/64⌉) para las máscaras de coincidencia
+ */
+class PatronMyers {
+    public:
+        /**
+         * @brief Preprocesa el patrón.
+         * 
+         * @param patron Patrón a buscar.
+         * @param maximo_ediciones Distancia de edición máxima k.
+         * @throws std::invalid_argument Si el patrón está vacío.
+         */
+        PatronMyers(const std::string& patron, unsigned int maximo_ediciones);
+
+        /**
+         * @brief Cantidad de posiciones del texto donde termina una ocurrencia aproximada.
+         * 
+         * @complexity
+         * - Tiempo: O(n·⌈m/64⌉)
+         * - Espacio: O(⌈m/64⌉)
+         */
+        unsigned int buscar(std::string_view texto) const;
+
+        /**
+         * @brief Ocurrencias aproximadas en orden de posición de término.
+         */
+        std::vector<OcurrenciaAproximada> localizar(std::string_view texto) const;
+
+        const std::string& getPatron() const { return patron_; }
+        unsigned int getMaximoEdiciones() const { return maximo_ediciones_; }
+
+    private:
+        /**
+         * @brief Recorre el texto y llama a reportar(j, distancia) en cada ocurrencia.
+         */
+        template<typename Reportar>
+        void recorrer(std::string_view texto, Reportar reportar) const;
+
+        std::string patron_;
+        unsigned int maximo_ediciones_;
+        size_t cantidad_bloques_;
+        uint64_t bit_final_;                    ///< Bit del último carácter del patrón en el último bloque
+        std::vector<uint64_t> coincidencias_;   ///< coincidencias_[byte * bloques + b]: posiciones del byte en el bloque b
+};
+
+/**
+ * @class Myers
+ * @brief Búsqueda aproximada estática, con la misma forma que los algoritmos exactos.
+ */
+class Myers {
+    public:
+        /**
+         * @brief Cuenta las posiciones donde termina una ocurrencia con a lo más k ediciones.
+         * 
+         * @param texto Texto donde se realizará la búsqueda.
+         * @param patron Patrón a buscar (vacío: 0 ocurrencias).
+         * @param maximo_ediciones Distancia de edición máxima k.
+         * @return Cantidad de posiciones de término; con k = 0 coincide con la búsqueda exacta.
+         */
+        static unsigned int buscar(const std::string& texto, const std::string& patron, unsigned int maximo_ediciones);
+
+        /**
+         * @brief Ocurrencias aproximadas con su posición de término y distancia.
+         */
+        static std::vector<OcurrenciaAproximada> localizar(const std::string& texto, const std::string& patron, unsigned int maximo_ediciones);
+};
@@ -0,0 +1,96 @@
+/**
+ * @file patron_comodin.hpp
+ * @brief Patrones con comodines y clases de caracteres para las estructuras indexadas.
+ * 
+ * Contiene la clase PatronComodin, que interpreta un lenguaje compacto de
+ * patrones de largo fijo: literales, el comodín ? (cualquier byte) y
+ * clases entre corchetes ([Ee], [a-z], [^0-9]). FMIndex, SuffixArrays y
+ * SuffixTrees lo buscan ramificando sobre sus intervalos o hijos, sin
+ * expandir el patrón en todas las cadenas concretas que describe.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <bitset>
+
+/**
+ * @brief Máximo por defecto de intervalos (o nodos) que explora una búsqueda con comodines.
+ */
+const size_t MAXIMO_INTERVALOS_COMODIN = 1 << 20;
+
+/**
+ * @brief Resultado de una búsqueda con comodines.
+ */
+struct ResultadoComodin {
+    size_t ocurrencias = 0;             ///< Posiciones donde comienza una cadena que cumple el patrón
+    size_t intervalos_explorados = 0;   ///< Intervalos (o nodos) no vacíos visitados durante la búsqueda
+    bool truncado = false;              ///< Se alcanzó el máximo de intervalos: ocurrencias es una cota inferior
+};
+
+/**
+ * @class PatronComodin
+ * @brief Patrón de largo fijo con un conjunto de bytes aceptados en cada posición.
+ * 
+ * Sintaxis:
+ * - Un byte cualquiera se acepta a sí mismo.
+ * - ? acepta cualquier byte.
+ * - [abc] acepta a, b o c; [a-z] acepta el rango; [^...] acepta el complemento.
+ * - \ quita el significado especial al byte siguiente (\?, \[, \\, y dentro
+ *   de una clase \], \- y \^).
+ * 
+ * Por ejemplo, err?r acepta "error" y "errar", y [Ee]rror acepta "Error" y
+ * "error".
+ */
+class PatronComodin {
+    public:
+        /**
+         * @brief Interpreta la expresión.
+         * 
+         * @param expresion Patrón en la sintaxis descrita.
+         * @throws std::invalid_argument Si la expresión está vacía, termina en \,
+         *         tiene un corchete sin cerrar, un rango invertido o una clase vacía.
+         */
+        explicit PatronComodin(const std::string& expresion);
+
+        /**
+         * @brief Largo del patrón (posiciones, no bytes de la expresión).
+         */
+        size_t size() const { return aceptados_.size(); }
+
+        /**
+         * @brief Indica si el byte se acepta en la posición.
+         */
+        bool acepta(size_t posicion, unsigned char caracter) const { return aceptados_[posicion][caracter]; }
+
+        /**
+         * @brief Bytes aceptados en la posición, en orden creciente.
+         */
+        const std::string& caracteres(size_t posicion) const { return caracteres_[posicion]; }
+
+        /**
+         * @brief Copia del patrón con cada conjunto plegado a minúsculas (ASCII).
+         * 
+         * Las estructuras construidas sobre el texto plegado la usan en lugar
+         * del patrón original: [E]rror plegado acepta "error".
+         */
+        PatronComodin plegado() const;
+
+        /**
+         * @brief Expresión con que se construyó el patrón.
+         */
+        const std::string& getExpresion() const { return expresion_; }
+
+    private:
+        /**
+         * @brief Agrega una posición con los bytes marcados y calcula su lista ordenada.
+         */
+        void agregarPosicion(const std::bitset<256>& aceptados);
+
+        std::string expresion_;
+        std::vector<std::bitset<256>> aceptados_;
+        std::vector<std::string> caracteres_;
+};
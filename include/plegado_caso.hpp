@@ -0,0 +1,49 @@
+/**
+ * @file plegado_caso.hpp
+ * @brief Plegado de mayúsculas a minúsculas para búsquedas sin distinción de caso.
+ * 
+ * Los algoritmos en línea comparan los caracteres ya plegados y las
+ * estructuras se construyen sobre el texto plegado, de modo que una
+ * búsqueda sin distinción de caso cuesta lo mismo que una exacta en lugar
+ * de enumerar las 2^k capitalizaciones del patrón.
+ * 
+ * El plegado es byte a byte y solo afecta a las letras ASCII A-Z: conserva
+ * el largo y las posiciones del texto. Las letras acentuadas en UTF-8
+ * (multibyte) se comparan de forma exacta.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+/**
+ * @brief Minúscula ASCII del byte; los demás bytes no cambian.
+ */
+inline unsigned char plegarCaracter(unsigned char caracter) {
+    return (caracter >= 'A' && caracter <= 'Z') ? static_cast<unsigned char>(caracter + ('a' - 'A')) : caracter;
+}
+
+/**
+ * @brief Copia de la cadena con sus letras ASCII en minúscula.
+ */
+inline std::string plegarCaso(const std::string& texto) {
+    std::string plegado(texto);
+    for (auto& caracter : plegado) caracter = static_cast<char>(plegarCaracter(static_cast<unsigned char>(caracter)));
+    return plegado;
+}
+
+/**
+ * @brief Plegado identidad, para instanciar los algoritmos en su versión exacta.
+ */
+struct SinPlegado {
+    unsigned char operator()(unsigned char caracter) const { return caracter; }
+};
+
+/**
+ * @brief Plegado a minúsculas, para instanciar los algoritmos sin distinción de caso.
+ */
+struct PlegadoMinusculas {
+    unsigned char operator()(unsigned char caracter) const { return plegarCaracter(caracter); }
+};
@@ -1,10 +1,10 @@
 /**
  * @file robin_karp.hpp
- * @brief Implementación del algoritmo de búsqueda Rabin-Karp con variaciones de capitalización.
+ * @brief Implementación del algoritmo de búsqueda Rabin-Karp.
  * 
- * Contiene la clase RobinKarp que implementa una versión extendida del algoritmo
- * Rabin-Karp que soporta búsquedas considerando todas las variaciones posibles
- * de mayúsculas y minúsculas del patrón.
+ * Contiene la clase RobinKarp que implementa el algoritmo Rabin-Karp con
+ * hash rolling, en versión exacta y sin distinción de mayúsculas, y
+ * PatronRobinKarp, el patrón con su hash ya calculado.
  * 
  * @date 2025
  */
@@ -12,77 +12,104 @@
 #pragma once
 
 #include "definiciones.hpp"
+#include "plegado_caso.hpp"
+
+#include <string_view>
 
 /**
  * @class RobinKarp
- * @brief Implementación extendida del algoritmo de búsqueda de patrones Rabin-Karp
- *        con soporte para variaciones de capitalización.
- * 
- * Esta implementación del algoritmo Rabin-Karp tiene soporte comentado para
- * variaciones de capitalización, pero actualmente solo busca coincidencias exactas
- * del patrón. La funcionalidad de variaciones está deshabilitada en el código.
+ * @brief Implementación del algoritmo de búsqueda de patrones Rabin-Karp.
  * 
  * Características principales:
  * - Utiliza función hash rolling para eficiencia
- * - Búsqueda solo de coincidencias exactas (variaciones comentadas)
  * - Incluye verificación de hash para evitar falsos positivos
  * - Hash con base 256 y módulo 101
+ * - Variante sin distinción de mayúsculas: el hash y la verificación usan
+ *   los caracteres plegados, sin enumerar las capitalizaciones del patrón
  * 
  * Complejidad temporal:
  * - Preprocesamiento: O(m) donde m es el tamaño del patrón
  * - Búsqueda: O(n) en promedio, O(n*m) en el peor caso
  * 
- * Complejidad espacial: O(1) para la búsqueda exacta
- * 
- * @note Las variaciones de capitalización están comentadas en la implementación actual.
+ * Complejidad espacial: O(1)
  */
 class RobinKarp {
     public:
         /**
          * @brief Busca un patrón en un texto utilizando el algoritmo de Rabin-Karp.
          * 
-         * Esta implementación busca coincidencias exactas del patrón usando hash rolling.
-         * Aunque incluye código para variaciones de capitalización, actualmente está
-         * comentado y solo retorna coincidencias exactas.
-         * 
          * @param texto Texto donde se realizará la búsqueda.
-         * @param patron Patrón base a buscar (solo coincidencias exactas).
+         * @param patron Patrón a buscar.
          * @return Cantidad de ocurrencias exactas encontradas del patrón.
          * 
-         * @note Actualmente solo busca coincidencias exactas (case-sensitive).
-         * @note El código de variaciones de capitalización está comentado.
+         * @note Es sensible a mayúsculas y minúsculas.
          * @note Utiliza rolling hash con base 256 y módulo 101.
          * 
          * @complexity
          * - Tiempo: O(n) promedio, O(n*m) peor caso
-         * - Espacio: O(1) para búsqueda exacta
+         * - Espacio: O(1)
          */
         static unsigned int buscar(const std::string& texto, const std::string& patron);
 
-    private:
         /**
-         * @brief Genera todas las variaciones de capitalización posibles de un patrón.
+         * @brief Igual que buscar(), sin distinguir mayúsculas de minúsculas (ASCII).
          * 
-         * Utiliza recursión para generar sistemáticamente todas las combinaciones
-         * posibles de mayúsculas y minúsculas para cada letra del patrón.
-         * Los caracteres no alfabéticos se mantienen sin cambios.
+         * @param texto Texto donde se realizará la búsqueda.
+         * @param patron Patrón a buscar.
+         * @return Cantidad de ocurrencias encontradas del patrón.
          * 
-         * @param patron Cadena patrón original.
-         * @param posicion Posición actual en la cadena (parámetro de recursión).
-         * @param buffer_actual Cadena temporal donde se construyen las variaciones.
-         * @param variaciones_capitalizacion Vector donde se almacenan todas las variaciones generadas.
+         * @complexity
+         * - Tiempo: O(n) promedio, O(n*m) peor caso (igual que la búsqueda exacta)
+         */
+        static unsigned int buscarSinMayusculas(const std::string& texto, const std::string& patron);
+
+        /**
+         * @brief Igual que buscar(), sobre un segmento del texto sin copiarlo (MotorSegmento).
+         */
+        static unsigned int buscarEnSegmento(std::string_view segmento, const std::string& patron);
+};
+
+/**
+ * @class PatronRobinKarp
+ * @brief Patrón con su hash y el peso del byte saliente ya calculados.
+ * 
+ * El hash del patrón y el peso base^(m-1) con que sale el primer byte de la
+ * ventana se calculan una vez; buscar() solo desliza el hash por el texto
+ * y compara byte a byte cuando coincide.
+ */
+class PatronRobinKarp {
+    public:
+        /**
+         * @brief Preprocesa el patrón.
          * 
-         * @note Este método modifica el vector variaciones_capitalizacion por referencia.
-         * @note Solo las letras alfabéticas generan variaciones; números y símbolos se mantienen.
+         * @param patron Patrón a buscar.
+         * @param ignorar_mayusculas Comparar sin distinguir mayúsculas de minúsculas (ASCII).
+         */
+        explicit PatronRobinKarp(const std::string& patron, bool ignorar_mayusculas = false);
+
+        /**
+         * @brief Cantidad de ocurrencias del patrón en el texto, incluidas las solapadas.
          * 
          * @complexity
-         * - Tiempo: O(2^k) donde k es el número de letras alfabéticas
-         * - Espacio: O(2^k * m) donde m es la longitud del patrón
+         * - Tiempo: O(n) promedio, O(n*m) peor caso
+         * - Espacio: O(1)
          */
-        static void generarVariacionesCapitalizacion(
-            const std::string& patron,
-            int posicion,
-            std::string& buffer_actual,
-            std::vector<std::string>& variaciones_capitalizacion
-        );
+        unsigned int buscar(std::string_view texto) const;
+
+        /**
+         * @brief Patrón tal como se compara (plegado si ignorar_mayusculas).
+         */
+        const std::string& getPatron() const { return patron_; }
+
+    private:
+        /**
+         * @brief Rabin-Karp sobre los caracteres del texto plegados por plegar.
+         */
+        template<typename Plegado>
+        unsigned int buscarCon(std::string_view texto, Plegado plegar) const;
+
+        std::string patron_;
+        bool ignorar_mayusculas_;
+        int hash_patron_ = 0;
+        int factor_potencia_ = 1;     ///< BASE^(m-1) mod MODULO, peso del byte que sale de la ventana
 };
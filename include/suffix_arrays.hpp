@@ -2,8 +2,8 @@
  * @file suffix_arrays.hpp
  * @brief Implementación de la estructura de datos Suffix Arrays para búsqueda de patrones.
  * 
- * Contiene la clase SuffixArrays que implementa una estructura de datos
- * basada en arrays de sufijos para realizar búsquedas eficientes de patrones.
+ * Contiene la clase SuffixArrays que implementa un arreglo de sufijos mejorado
+ * (Enhanced Suffix Array) para realizar búsquedas eficientes de patrones.
  * 
  * @date 2025
  */
@@ -12,72 +12,200 @@
 
 #include "definiciones.hpp"
 #include "class_base.hpp"
+#include "plegado_caso.hpp"
+#include "patron_comodin.hpp"
 
 /**
  * @class SuffixArrays
- * @brief Implementación de búsqueda de patrones usando Suffix Arrays.
+ * @brief Implementación de búsqueda de patrones usando Suffix Arrays mejorados.
  * 
- * Los Suffix Arrays son una estructura de datos que almacena todos los sufijos
- * de una cadena de texto ordenados lexicográficamente. Esta implementación
- * permite búsquedas eficientes de patrones en el texto preprocesado.
+ * Los Suffix Arrays almacenan las posiciones de todos los sufijos de un texto
+ * ordenados lexicográficamente. Esta implementación los extiende con la tabla
+ * LCP y la tabla de hijos de Abouelhoda et al. (Enhanced Suffix Array), lo que
+ * permite recorrer los intervalos LCP de arriba hacia abajo igual que se
+ * recorrería un árbol de sufijos, pero sin nodos ni punteros.
  * 
  * Características principales:
  * - Preprocesa el texto una vez en el constructor
- * - Permite múltiples búsquedas eficientes
- * - Utiliza ordenamiento lexicográfico de sufijos
+ * - Arreglo de sufijos como índices enteros (no como strings completos)
+ * - Tabla LCP construida con el algoritmo de Kasai
+ * - Tabla de hijos compacta (up/nextlIndex en un solo arreglo, down aparte)
+ * - Búsqueda top-down por intervalos LCP y búsqueda binaria clásica
+ * - Modo sin distinción de mayúsculas: arreglo sobre el texto plegado
  * - Hereda de BaseStructure para interfaz uniforme
+ * 
  * Complejidad temporal:
- * - Construcción: O(n² log n) donde n es el tamaño del texto (por ordenamiento de strings)
- * - Búsqueda: O(log n + k) donde k es el número de ocurrencias
+ * - Construcción: O(n log n) comparaciones de sufijos + O(n) para LCP y tabla de hijos
+ * - Búsqueda top-down: O(m·σ) donde σ es el tamaño del alfabeto
+ * - Búsqueda binaria: O(m log n)
  * 
- * Complejidad espacial: O(n²) para almacenar todos los sufijos como strings completos
+ * Complejidad espacial: O(n), cuatro enteros por carácter más una copia del texto
  * 
- * @note Esta implementación almacena los sufijos como strings completos,
- *       lo que puede ser memory-intensive para textos largos.
+ * @note Ofrece la velocidad de consulta de SuffixTrees con la memoria de un arreglo de sufijos.
  */
 class SuffixArrays: public BaseStructure {
     public:
         /**
-         * @brief Constructor que preprocesa el texto para crear el array de sufijos.
+         * @brief Constructor que preprocesa el texto para crear el arreglo de sufijos mejorado.
          * 
-         * Genera todos los sufijos del texto de entrada y los ordena
-         * lexicográficamente para permitir búsquedas eficientes posteriores.
+         * Ordena las posiciones de los sufijos, calcula la tabla LCP y a partir
+         * de ella la tabla de hijos que codifica el árbol de intervalos LCP.
          * 
          * @param texto Texto fuente del cual extraer y ordenar los sufijos.
+         * @param plegar_mayusculas Ordenar los sufijos del texto plegado a
+         *        minúsculas y plegar los patrones al buscar.
          * 
-         * @note El texto se procesa completamente en el constructor.
-         * @note Los sufijos se almacenan como strings completos ordenados.
+         * @note Se guarda una copia del texto (plegado si corresponde) para comparar los caracteres del patrón.
          * 
          * @complexity
-         * - Tiempo: O(n² log n) por el ordenamiento de strings
-         * - Espacio: O(n²) para almacenar todos los sufijos
+         * - Tiempo: O(n log n) comparaciones de sufijos + O(n) para LCP y tabla de hijos
+         * - Espacio: O(n)
          */
-        SuffixArrays(const std::string& texto);
-        
+        SuffixArrays(const std::string& texto, bool plegar_mayusculas = false);
+
         /**
-         * @brief Busca un patrón en el texto utilizando el array de sufijos precomputado.
+         * @brief Busca un patrón recorriendo de arriba hacia abajo los intervalos LCP.
          * 
-         * Realiza una búsqueda binaria en el array ordenado de sufijos para
-         * encontrar todas las ocurrencias del patrón especificado.
+         * Parte del intervalo raíz [0..n-1] y en cada paso salta directamente
+         * al final del prefijo común del intervalo actual (comparando esos
+         * caracteres una sola vez) y elige el intervalo hijo cuyo siguiente
+         * carácter coincide con el del patrón.
          * 
          * @param patron Patrón a buscar en el texto.
          * @return Cantidad de ocurrencias encontradas del patrón.
          * 
-         * @note Utiliza búsqueda binaria para eficiencia.
-         * @note Es sensible a mayúsculas y minúsculas.
+         * @note Es sensible a mayúsculas y minúsculas salvo con ignorar_mayusculas.
          * 
          * @complexity
-         * - Tiempo: O(m log n) donde m = |patron|, n = número de sufijos
+         * - Tiempo: O(m·σ) donde m = |patron| y σ el tamaño del alfabeto
          * - Espacio: O(1) adicional
          */
         unsigned int buscar(const std::string& patron) const override;
 
+        /**
+         * @brief Busca un patrón mediante búsqueda binaria sobre el arreglo de sufijos.
+         * 
+         * Se conserva como referencia para comparar contra la búsqueda top-down.
+         * 
+         * @param patron Patrón a buscar en el texto.
+         * @return Cantidad de ocurrencias encontradas del patrón.
+         * 
+         * @complexity
+         * - Tiempo: O(m log n)
+         * - Espacio: O(1) adicional
+         */
+        unsigned int buscarBinaria(const std::string& patron) const;
+
+        /**
+         * @brief Cuenta las ocurrencias de un patrón con comodines y clases de caracteres.
+         * 
+         * Recorre los intervalos LCP de arriba hacia abajo como buscar(), pero
+         * en cada bifurcación sigue a todos los hijos cuyo carácter acepta el
+         * patrón en esa posición. Los caracteres compartidos por un intervalo
+         * se verifican una sola vez contra las clases del patrón.
+         * 
+         * @param patron Patrón con comodines (plegado al buscar si corresponde).
+         * @param maximo_intervalos Intervalos que se exploran antes de detenerse.
+         * @return Ocurrencias, intervalos explorados y si la búsqueda se truncó.
+         * 
+         * @complexity
+         * - Tiempo: O(m + intervalos explorados · σ)
+         */
+        ResultadoComodin buscarComodin(const PatronComodin& patron, size_t maximo_intervalos = MAXIMO_INTERVALOS_COMODIN) const;
+
+        /**
+         * @brief Bytes del arreglo de sufijos, la tabla LCP, la tabla de hijos y la copia del texto.
+         */
+        size_t getMemoriaBytes() const override;
+
     private:
         /**
-         * @brief Vector que almacena todos los sufijos del texto ordenados lexicográficamente.
+         * @brief Obtiene el valor up[k] de la tabla de hijos.
+         * 
+         * up[k] se guarda en la celda siguiente[k-1], que solo queda libre
+         * cuando lcp[k-1] > lcp[k] (justo cuando up[k] está definido).
+         * 
+         * @param k Índice en el rango [1..n].
+         * @return up[k] o -1 si no está definido.
+         */
+        int obtenerArriba(int k) const;
+
+        /**
+         * @brief Obtiene el valor nextlIndex[k] de la tabla de hijos.
+         * 
+         * @param k Índice en el rango [0..n-1].
+         * @return nextlIndex[k] o -1 si no está definido.
+         */
+        int obtenerSiguienteL(int k) const;
+
+        /**
+         * @brief Obtiene el primer l-índice del intervalo LCP [i..j].
          * 
-         * Cada elemento es un sufijo completo del texto original, ordenado
-         * alfabéticamente para permitir búsquedas binarias eficientes.
+         * @param i Límite izquierdo del intervalo.
+         * @param j Límite derecho del intervalo (i < j).
+         * @return Posición que separa el primer hijo del resto.
+         */
+        int obtenerPrimerIndiceL(int i, int j) const;
+
+        /**
+         * @brief Busca el intervalo hijo de [i..j] cuyos sufijos tienen el carácter
+         *        dado en la posición profundidad.
+         * 
+         * @param caracter Carácter buscado.
+         * @param profundidad Valor lcp del intervalo [i..j].
+         * @param[in,out] i Límite izquierdo; se reemplaza por el del hijo.
+         * @param[in,out] j Límite derecho; se reemplaza por el del hijo.
+         * @return true si existe el hijo, false en caso contrario.
+         */
+        bool obtenerHijo(char caracter, int profundidad, int& i, int& j) const;
+
+        /**
+         * @brief Indica si texto[sufijo + desde, sufijo + hasta) cumple las posiciones [desde, hasta) del patrón.
+         */
+        bool coincideComodin(const PatronComodin& patron, int sufijo, int desde, int hasta) const;
+
+        /**
+         * @brief Continúa la búsqueda con comodines en el intervalo LCP [i..j].
+         * 
+         * @param comparados Posiciones del patrón ya verificadas para todo el intervalo.
+         */
+        void expandirComodin(const PatronComodin& patron, int i, int j, int comparados,
+                             size_t maximo_intervalos, ResultadoComodin& resultado) const;
+
+        /**
+         * @brief Patrón tal como se compara contra el texto (plegado si corresponde).
+         */
+        std::string patronBuscado(const std::string& patron) const;
+
+        /**
+         * @brief Copia del texto original (o plegado), necesaria para comparar caracteres.
+         */
+        std::string texto;
+
+        /**
+         * @brief Si el texto está plegado a minúsculas y los patrones deben plegarse.
+         */
+        bool ignorar_mayusculas = false;
+
+        /**
+         * @brief Posiciones de inicio de los sufijos ordenados lexicográficamente.
+         */
+        vc sufijos;
+
+        /**
+         * @brief Tabla LCP de tamaño n+1: lcp[i] es el prefijo común más largo
+         *        entre los sufijos sufijos[i-1] y sufijos[i]; lcp[0] = lcp[n] = -1.
+         */
+        vc lcp;
+
+        /**
+         * @brief Tabla de hijos compacta: guarda nextlIndex[k] o up[k+1] según
+         *        cuál de los dos esté definido.
+         */
+        vc siguiente;
+
+        /**
+         * @brief Valores down de la tabla de hijos.
          */
-        std::vector<std::string> sufijos;
+        vc abajo;
 };
@@ -12,6 +12,8 @@
 
 #include "definiciones.hpp"
 #include "class_base.hpp"
+#include "plegado_caso.hpp"
+#include "patron_comodin.hpp"
 
 #include <list>
 #include <memory>
@@ -51,6 +53,8 @@ class SuffixTrees: public BaseStructure {
          * almacena los índices de TODOS los sufijos que pasan por él.
          * 
          * @param texto Texto fuente para construir el suffix tree.
+         * @param plegar_mayusculas Insertar los sufijos del texto plegado a
+         *        minúsculas y plegar los patrones al buscar.
          * 
          * @note Cada sufijo i se inserta como texto[i..n-1] desde la raíz.
          * @note Cada nodo intermedio almacena todos los índices de sufijos.
@@ -60,7 +64,7 @@ class SuffixTrees: public BaseStructure {
          * - Tiempo: O(n²) donde n es el tamaño del texto
          * - Espacio: O(n²) debido a almacenar listas en cada nodo
          */
-        SuffixTrees(const std::string& texto);
+        SuffixTrees(const std::string& texto, bool plegar_mayusculas = false);
         
         /**
          * @brief Destructor que libera la memoria del árbol.
@@ -83,7 +87,7 @@ class SuffixTrees: public BaseStructure {
          * 
          * @note Busca carácter por carácter siguiendo los hijos del árbol.
          * @note Si encuentra el patrón completo, cuenta todos los índices del nodo.
-         * @note Es sensible a mayúsculas y minúsculas.
+         * @note Es sensible a mayúsculas y minúsculas salvo con ignorar_mayusculas.
          * 
          * @complexity
          * - Tiempo: O(m) donde m es la longitud del patrón
@@ -91,6 +95,31 @@ class SuffixTrees: public BaseStructure {
          */
         unsigned int buscar(const std::string& patron) const override;
 
+        /**
+         * @brief Cuenta las ocurrencias de un patrón con comodines y clases de caracteres.
+         * 
+         * Desciende por todos los hijos cuyo carácter acepta el patrón en la
+         * posición correspondiente; al terminar el patrón suma los índices de
+         * cada nodo alcanzado (nodos distintos de igual profundidad no
+         * comparten sufijos).
+         * 
+         * @param patron Patrón con comodines (plegado al buscar si corresponde).
+         * @param maximo_intervalos Nodos que se exploran antes de detenerse.
+         * @return Ocurrencias, nodos explorados y si la búsqueda se truncó.
+         * 
+         * @complexity
+         * - Tiempo: O(nodos explorados · σ)
+         */
+        ResultadoComodin buscarComodin(const PatronComodin& patron, size_t maximo_intervalos = MAXIMO_INTERVALOS_COMODIN) const;
+
+        /**
+         * @brief Bytes de todos los nodos del árbol con sus listas de índices.
+         * 
+         * @complexity
+         * - Tiempo: O(cantidad de nodos), recorre el árbol completo
+         */
+        size_t getMemoriaBytes() const override;
+
     private:
         /**
          * @class Node
@@ -143,6 +172,23 @@ class SuffixTrees: public BaseStructure {
                  * @note Retorna nullptr si no existe el hijo para el siguiente carácter.
                  */
                 const std::list<int>* search(const std::string& patron, size_t posicion) const;
+
+                /**
+                 * @brief Busca un patrón con comodines en el subárbol que comienza en este nodo.
+                 * 
+                 * @param patron Patrón con comodines.
+                 * @param posicion Posición actual dentro del patrón.
+                 * @param maximo_intervalos Nodos que se exploran antes de detenerse.
+                 * @param resultado Acumula las ocurrencias y los nodos explorados.
+                 */
+                void searchComodin(const PatronComodin& patron, size_t posicion, size_t maximo_intervalos,
+                                   ResultadoComodin& resultado) const;
+
+                /**
+                 * @brief Bytes de este nodo y de su subárbol: el nodo, su tabla de
+                 *        256 hijos y un nodo de lista por cada índice guardado.
+                 */
+                size_t getMemoriaBytes() const;
                 
                 /**
                  * @brief Destructor que libera recursivamente la memoria del subárbol.
@@ -177,4 +223,9 @@ class SuffixTrees: public BaseStructure {
          * Todos los sufijos del texto se insertan como caminos desde esta raíz.
          */
         std::unique_ptr<Node> root;
+
+        /**
+         * @brief Si el árbol se construyó sobre el texto plegado a minúsculas.
+         */
+        bool ignorar_mayusculas = false;
 };
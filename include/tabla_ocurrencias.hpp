@@ -0,0 +1,154 @@
+/**
+ * @file tabla_ocurrencias.hpp
+ * @brief Tabla de ocurrencias muestreada para consultas de rango sobre la BWT.
+ * 
+ * Contiene la clase TablaOcurrencias, que responde cuántas veces aparece un
+ * carácter en un prefijo de la BWT guardando conteos acumulados cada
+ * INTERVALO_OCURRENCIAS posiciones en lugar de uno por posición.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "archivo_mapeado.hpp"
+#include "busqueda_paralela.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Cada cuántas posiciones de la BWT se guarda una fila de conteos.
+ * 
+ * Con 64 posiciones el tramo que se recorre en cada consulta ocupa una
+ * sola línea de caché de la BWT.
+ */
+const size_t INTERVALO_OCURRENCIAS = 64;
+
+/**
+ * @class TablaOcurrencias
+ * @brief Estructura de rango (Occ) de la BWT basada en conteos muestreados.
+ * 
+ * Guarda la BWT y, cada INTERVALO_OCURRENCIAS posiciones, una fila con la
+ * cantidad acumulada de cada símbolo presente. Para responder rango(c, i)
+ * se lee la fila anterior a i y se cuentan las apariciones de c en el tramo
+ * restante de la BWT.
+ * 
+ * Todos los datos son arreglos planos, por lo que la tabla puede guardarse
+ * en disco y usarse directamente desde un archivo mapeado.
+ * 
+ * Complejidad temporal:
+ * - Construcción: O(n + (n / INTERVALO_OCURRENCIAS)·σ)
+ * - Consulta de rango: O(INTERVALO_OCURRENCIAS) en el peor caso
+ * 
+ * Complejidad espacial: n bytes + 4·σ·n / INTERVALO_OCURRENCIAS bytes
+ */
+class TablaOcurrencias {
+    public:
+        TablaOcurrencias() = default;
+
+        /**
+         * @brief Construye la tabla a partir de la BWT.
+         * 
+         * Con pool, cada tramo de filas cuenta sus caracteres, una suma
+         * acumulada por tramo da los conteos con que empieza cada uno y una
+         * segunda pasada escribe sus filas.
+         * 
+         * @param bwt Cadena BWT (puede ser la vista de un archivo mapeado; se copia).
+         * @param pool Hilos de la construcción; nullptr construye en el hilo actual.
+         */
+        explicit TablaOcurrencias(std::string_view bwt, PoolTrabajo* pool = nullptr);
+
+        /**
+         * @brief Cuenta las apariciones de un carácter en bwt[0, i).
+         * 
+         * @param caracter Carácter a contar.
+         * @param i Largo del prefijo de la BWT (0 <= i <= n).
+         * @return Cantidad de apariciones.
+         * 
+         * @complexity
+         * - Tiempo: O(INTERVALO_OCURRENCIAS)
+         */
+        size_t rango(unsigned char caracter, size_t i) const;
+
+        /**
+         * @brief Cuenta los caracteres menores que caracter en bwt[0, i).
+         * 
+         * Los códigos compactos respetan el orden de los bytes, así que basta
+         * sumar las columnas de la fila muestreada de los códigos menores.
+         * Es la consulta con que un índice bidireccional sincroniza el
+         * intervalo del texto invertido.
+         * 
+         * @param caracter Carácter de referencia (puede no aparecer en la BWT).
+         * @param i Largo del prefijo de la BWT (0 <= i <= n).
+         * @return Cantidad de caracteres menores.
+         * 
+         * @complexity
+         * - Tiempo: O(σ + INTERVALO_OCURRENCIAS)
+         */
+        size_t rangoMenores(unsigned char caracter, size_t i) const;
+
+        /**
+         * @brief Solicita al procesador la fila de conteos y el tramo de BWT que leerá rango(caracter, i).
+         */
+        void precargar(unsigned char caracter, size_t i) const {
+            uint16_t codigo = codigos_[caracter];
+            if (codigo == SIN_CODIGO) return;
+
+            size_t bloque = i / INTERVALO_OCURRENCIAS;
+            __builtin_prefetch(muestras_.data() + bloque * cantidad_simbolos_ + codigo);
+            __builtin_prefetch(bwt_.data() + bloque * INTERVALO_OCURRENCIAS);
+        }
+
+        /**
+         * @brief Retorna el carácter de la BWT en la posición i.
+         */
+        unsigned char acceder(size_t i) const { return bwt_[i]; }
+
+        /**
+         * @brief Largo de la BWT.
+         */
+        size_t size() const { return bwt_.size(); }
+
+        /**
+         * @brief Bytes ocupados por la BWT y las filas de conteos.
+         */
+        size_t getMemoriaBytes() const;
+
+        /**
+         * @brief Escribe la tabla en un archivo de índice.
+         * @param escritor Escritor del archivo.
+         */
+        void serializar(EscritorBinario& escritor) const;
+
+        /**
+         * @brief Enlaza la tabla a un archivo de índice mapeado, sin copiar datos.
+         * @param lector Lector posicionado al inicio de la sección de la tabla.
+         * @throws std::runtime_error Si la sección está corrupta.
+         */
+        void mapear(LectorMapeado& lector);
+
+    private:
+        /**
+         * @brief Cadena BWT.
+         */
+        ArregloPlano<unsigned char> bwt_;
+
+        /**
+         * @brief Código compacto de cada carácter (0..σ-1) o SIN_CODIGO si no aparece.
+         */
+        ArregloPlano<uint16_t> codigos_;
+
+        /**
+         * @brief Filas de conteos: muestras_[b·σ + codigo] = apariciones antes de b·INTERVALO_OCURRENCIAS.
+         */
+        ArregloPlano<uint32_t> muestras_;
+
+        /**
+         * @brief Cantidad de símbolos distintos presentes en la BWT (σ).
+         */
+        uint32_t cantidad_simbolos_ = 0;
+
+        static constexpr uint16_t SIN_CODIGO = 0xFFFF;
+};
@@ -0,0 +1,126 @@
+/**
+ * @file transformada_bwt.hpp
+ * @brief Construcción del arreglo de sufijos y de la BWT con centinela.
+ * 
+ * Funciones compartidas por los índices basados en la transformada de
+ * Burrows-Wheeler (FMIndex y FMIndexRL). El centinela $ es virtual: no se
+ * almacena en la BWT y solo se informa la fila en que aparece.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "busqueda_paralela.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @struct TransformadaBWT
+ * @brief Arreglo de sufijos y BWT del texto terminado en centinela.
+ * 
+ * Las filas de la matriz BWT son n + 1: la fila 0 corresponde al sufijo
+ * vacío "$" y la fila r + 1 al sufijo arreglo_sufijos[r].
+ */
+struct TransformadaBWT {
+    vc arreglo_sufijos;         ///< Arreglo de sufijos del texto (n entradas, sin la fila 0)
+    std::string bwt;            ///< BWT de n caracteres, sin el centinela
+    size_t fila_centinela = 0;  ///< Fila de la BWT que contiene el centinela
+
+    /**
+     * @brief Largo del texto (cantidad de filas menos una).
+     */
+    size_t longitud() const { return bwt.size(); }
+
+    /**
+     * @brief Posición de texto del sufijo de una fila (0 <= fila <= n).
+     */
+    size_t sufijoDeFila(size_t fila) const {
+        return fila == 0 ? bwt.size() : static_cast<size_t>(arreglo_sufijos[fila - 1]);
+    }
+
+    /**
+     * @brief Indica si la fila contiene el centinela.
+     */
+    bool esCentinela(size_t fila) const { return fila == fila_centinela; }
+
+    /**
+     * @brief Carácter de la BWT en una fila distinta de la del centinela.
+     */
+    unsigned char caracterDeFila(size_t fila) const {
+        return static_cast<unsigned char>(bwt[fila > fila_centinela ? fila - 1 : fila]);
+    }
+};
+
+/**
+ * @brief Construye el arreglo de sufijos de un texto por duplicación de prefijos.
+ * 
+ * Cuando un sufijo es prefijo de otro, el más corto va primero, lo que
+ * equivale a ordenar el texto terminado en un centinela menor que todo
+ * carácter.
+ * 
+ * Primero ordena los sufijos por sus primeros k caracteres empaquetados en
+ * 32 bits (k = 10 con σ = 4). Luego, con los sufijos agrupados por sus
+ * primeros h caracteres, cada ronda ordena dentro de cada grupo por el
+ * rango del sufijo que comienza h posiciones después y duplica h; los
+ * grupos de un solo sufijo ya están en su posición final y no se vuelven a
+ * recorrer. Los grupos se reparten entre los hilos del pool, los grupos
+ * grandes se ordenan por tramos y se mezclan en paralelo, y los rangos
+ * nuevos se escriben solo después de leer todos los de la ronda.
+ * 
+ * @param texto Texto fuente.
+ * @param pool Hilos de la construcción; nullptr construye en el hilo actual.
+ * @return vc Vector con los índices del arreglo de sufijos.
+ * @throws std::length_error Si el texto no cabe en posiciones de tipo int.
+ * 
+ * @complexity
+ * - Tiempo: O(n log n) por ronda y O(log(n / k)) rondas en el peor caso (texto
+ *   periódico); en texto no repetitivo, unas pocas rondas sobre grupos chicos
+ * - Espacio: 9n bytes más 16 bytes por sufijo aún no ordenado (8 con un solo hilo)
+ */
+vc construirArregloSufijos(const std::string& texto, PoolTrabajo* pool = nullptr);
+
+/**
+ * @brief Deriva la BWT de texto$ de su arreglo de sufijos, en paralelo por tramos de filas.
+ * 
+ * @param texto Texto original.
+ * @param arreglo_sufijos Arreglo de sufijos del texto; queda en la transformada.
+ * @param pool Hilos de la construcción; nullptr construye en el hilo actual.
+ * @return Transformada con la BWT sin el centinela y la fila en que aparece.
+ */
+TransformadaBWT transformadaDesdeArreglo(const std::string& texto, vc arreglo_sufijos, PoolTrabajo* pool = nullptr);
+
+/**
+ * @brief Construye el arreglo de sufijos y la BWT de texto$.
+ * 
+ * @param texto Texto original.
+ * @param pool Hilos de la construcción; nullptr construye en el hilo actual.
+ * @return Transformada con la BWT sin el centinela y la fila en que aparece.
+ * @throws std::length_error Si el texto no cabe en posiciones de tipo int.
+ */
+TransformadaBWT construirTransformadaBWT(const std::string& texto, PoolTrabajo* pool = nullptr);
+
+/**
+ * @brief Construye la tabla de inicio por carácter (tabla C) a partir de la BWT.
+ * 
+ * Cada tramo de la BWT cuenta sus caracteres por separado y luego se suman
+ * los histogramas.
+ * 
+ * @param bwt Cadena BWT sin el centinela.
+ * @param pool Hilos de la construcción; nullptr construye en el hilo actual.
+ * @return Tabla C de 257 entradas: C[c] es 1 (el centinela) más la cantidad
+ *         de caracteres menores que c, y C[256] es n + 1.
+ */
+std::vector<uint64_t> construirTablaInicioCaracter(std::string_view bwt, PoolTrabajo* pool = nullptr);
+
+/**
+ * @brief Cantidad de runs (tramos de caracteres iguales) de la BWT.
+ * 
+ * El centinela cuenta como un run propio.
+ * 
+ * @param transformada BWT del texto.
+ * @return Cantidad de runs r (1 <= r <= n + 1).
+ */
+size_t contarRunsBWT(const TransformadaBWT& transformada);
@@ -0,0 +1,112 @@
+/**
+ * @file traza.hpp
+ * @brief Fases con tiempo dentro de la construcción de las estructuras.
+ * 
+ * Contiene RegistroTraza, que junta los intervalos marcados con
+ * TRAZAR_FASE mientras está activo en el hilo, y FaseTraza, el objeto con
+ * alcance que mide cada intervalo. Los constructores marcan sus fases
+ * (ordenar sufijos, BWT, tabla C, tabla de ocurrencias, ...); el medidor
+ * activa un registro alrededor de cada construcción, informa la duración
+ * de cada fase en el resultado y exporta los intervalos como eventos de
+ * traza de Chrome (chrome://tracing, Perfetto).
+ * 
+ * Sin un registro activo, cada fase cuesta leer un puntero thread_local.
+ * Compilando con -DSIN_TRAZA, TRAZAR_FASE no genera código.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <cstdint>
+
+/**
+ * @brief Intervalo medido por una FaseTraza.
+ */
+struct EventoTraza {
+    const char* nombre;             ///< Nombre de la fase (literal o cadena que sobrevive al registro)
+    uint64_t inicio_ns;             ///< Comienzo desde el inicio del proceso
+    uint64_t fin_ns;                ///< Fin desde el inicio del proceso (0 mientras está abierta)
+    uint32_t profundidad;           ///< Fases abiertas al comenzar esta (0 es la más externa)
+    uint32_t hilo;                  ///< Número del hilo que la midió
+};
+
+/**
+ * @class RegistroTraza
+ * @brief Junta las fases medidas en el hilo mientras está activo.
+ * 
+ * Hay a lo más un registro activo por hilo; las fases que corren en otros
+ * hilos (tareas de un PoolTrabajo, el hilo de FMIndexIncremental) no se
+ * registran, así que los constructores marcan sus fases en el hilo que
+ * los llamó.
+ */
+class RegistroTraza {
+    public:
+        /**
+         * @brief Activa el registro en el hilo actual, reemplazando al que estuviera activo.
+         */
+        RegistroTraza();
+
+        /**
+         * @brief Desactiva el registro y restaura el anterior del hilo.
+         */
+        ~RegistroTraza();
+
+        RegistroTraza(const RegistroTraza&) = delete;
+        RegistroTraza& operator=(const RegistroTraza&) = delete;
+
+        /**
+         * @brief Intervalos medidos, en orden de comienzo.
+         */
+        const std::vector<EventoTraza>& getEventos() const { return eventos_; }
+
+        /**
+         * @brief Registro activo en el hilo actual, o nullptr.
+         */
+        static RegistroTraza* activo();
+
+    private:
+        friend class FaseTraza;
+
+        std::vector<EventoTraza> eventos_;
+        uint32_t abiertas_ = 0;
+        RegistroTraza* anterior_;
+};
+
+/**
+ * @class FaseTraza
+ * @brief Mide el intervalo entre su construcción y su destrucción en el registro activo.
+ * 
+ * Se usa con TRAZAR_FASE para que desaparezca al compilar con -DSIN_TRAZA.
+ */
+class FaseTraza {
+    public:
+        explicit FaseTraza(const char* nombre);
+        ~FaseTraza();
+
+        FaseTraza(const FaseTraza&) = delete;
+        FaseTraza& operator=(const FaseTraza&) = delete;
+
+    private:
+        RegistroTraza* registro_;
+        size_t evento_ = 0;
+};
+
+/**
+ * @brief Nanosegundos desde el inicio del proceso (reloj monótono); base de los eventos.
+ */
+uint64_t nanosegundosTraza();
+
+#define TRAZA_CONCATENAR_(a, b) a##b
+#define TRAZA_CONCATENAR(a, b) TRAZA_CONCATENAR_(a, b)
+
+/**
+ * @brief Mide el resto del bloque actual como la fase indicada.
+ */
+#ifdef SIN_TRAZA
+#define TRAZAR_FASE(nombre) ((void)0)
+#else
+#define TRAZAR_FASE(nombre) FaseTraza TRAZA_CONCATENAR(fase_traza_, __LINE__)(nombre)
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @file two_way.hpp
+ * @brief Implementación del algoritmo de búsqueda Two-Way (Crochemore-Perrin).
+ * 
+ * Contiene la clase TwoWay, un algoritmo en línea con tiempo lineal en el
+ * peor caso y espacio adicional constante, pensado para entradas
+ * adversarias en que Boyer-Moore degenera a O(n*m).
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+
+#include <string_view>
+
+/**
+ * @class TwoWay
+ * @brief Implementación del algoritmo de búsqueda de patrones Two-Way.
+ * 
+ * El patrón se divide en su factorización crítica x = u v, obtenida como
+ * el mayor de los sufijos máximos según el orden lexicográfico y su
+ * inverso. Cada ventana compara primero v de izquierda a derecha y, si
+ * coincide, u de derecha a izquierda:
+ * - Una discrepancia en v desplaza la ventana lo que se avanzó en v
+ * - Si el patrón es periódico se desplaza en su período y se recuerda el
+ *   prefijo ya verificado, de modo que ningún carácter se compara dos
+ *   veces con la misma posición del patrón
+ * - Si no es periódico se desplaza en max(|u|, |v|) + 1
+ * 
+ * Complejidad temporal:
+ * - Preprocesamiento: O(m) donde m es el tamaño del patrón
+ * - Búsqueda: O(n) en el peor caso (a lo más 2n comparaciones)
+ * 
+ * Complejidad espacial: O(1) adicional (sin tablas)
+ */
+class TwoWay {
+    public:
+        /**
+         * @brief Busca un patrón en un texto utilizando el algoritmo Two-Way.
+         * 
+         * @param texto Texto donde se realizará la búsqueda.
+         * @param patron Patrón a buscar en el texto.
+         * @return Cantidad de ocurrencias encontradas, incluidas las solapadas.
+         * 
+         * @note Es sensible a mayúsculas y minúsculas.
+         * 
+         * @complexity
+         * - Tiempo: O(n + m) en el peor caso
+         * - Espacio: O(1)
+         */
+        static unsigned int buscar(const std::string& texto, const std::string& patron);
+
+        /**
+         * @brief Igual que buscar(), sobre un segmento del texto sin copiarlo (MotorSegmento).
+         */
+        static unsigned int buscarEnSegmento(std::string_view segmento, const std::string& patron);
+
+    private:
+        /**
+         * @brief Sufijo máximo del patrón según el orden de bytes (o su inverso).
+         * 
+         * @param patron Patrón a factorizar.
+         * @param inverso Usar el orden inverso.
+         * @param periodo Período del sufijo máximo encontrado (salida).
+         * @return Posición anterior al comienzo del sufijo (-1 si es el patrón completo).
+         */
+        static long long sufijoMaximo(std::string_view patron, bool inverso, size_t& periodo);
+
+        /**
+         * @brief Búsqueda Two-Way sobre una vista del texto.
+         */
+        static unsigned int buscarVista(std::string_view texto, std::string_view patron);
+};
@@ -36,4 +36,14 @@ void input(std::string& texto, std::string& patron);
  * @note El patrón devuelto no sera una cadena vacía.
  * @note Esta función puede solicitar reingresar el patrón si está vacío.
  */
-void solicitarPatron(std::string& patron);
\ No newline at end of file
+void solicitarPatron(std::string& patron);
+
+/**
+ * @brief Lee el contenido completo de un archivo de texto.
+ * 
+ * @param ruta Ruta del archivo a leer.
+ * @return Contenido del archivo.
+ * 
+ * @throws std::ios_base::failure Si el archivo no se puede abrir.
+ */
+std::string leerArchivo(const std::string& ruta);
\ No newline at end of file
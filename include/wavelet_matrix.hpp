@@ -0,0 +1,181 @@
+/**
+ * @file wavelet_matrix.hpp
+ * @brief Wavelet matrix para consultas de rango y acceso sobre secuencias.
+ * 
+ * Contiene la clase WaveletMatrix, que representa una secuencia de símbolos
+ * con n·log σ bits y responde rango y acceso en O(log σ). Se usa como
+ * backend de rango compacto de FMIndex para alfabetos grandes.
+ * 
+ * @date 2025
+ */
+
+#pragma once
+
+#include "definiciones.hpp"
+#include "archivo_mapeado.hpp"
+#include "bit_vector.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @class WaveletMatrix
+ * @brief Wavelet matrix (Claude y Navarro) sobre un vector de bits con rango por popcount.
+ * 
+ * Cada nivel l guarda el bit l (desde el más significativo) de los códigos
+ * de la secuencia, reordenada de forma estable con los ceros del nivel
+ * anterior primero. Un rango o acceso baja un nivel por bit del código.
+ * 
+ * Para cadenas de bytes, los caracteres presentes se mapean a códigos
+ * compactos 0..σ-1, de modo que la cantidad de niveles es ceil(log2 σ) y no 8.
+ * 
+ * Complejidad temporal:
+ * - Construcción: O(n log σ)
+ * - Rango y acceso: O(log σ)
+ * 
+ * Complejidad espacial: n·ceil(log2 σ) bits más el directorio de rango de cada nivel
+ */
+class WaveletMatrix {
+    public:
+        WaveletMatrix() = default;
+
+        /**
+         * @brief Construye la matriz sobre los bytes de una cadena.
+         * 
+         * Lee el texto una vez por nivel sin copiarlo ni materializar la
+         * secuencia de códigos, de modo que sirve sobre una BWT mapeada.
+         * 
+         * @param texto Secuencia de caracteres (por ejemplo, la BWT).
+         */
+        explicit WaveletMatrix(std::string_view texto);
+
+        /**
+         * @brief Construye la matriz sobre una secuencia de códigos enteros.
+         * @param secuencia Códigos en el rango [0, max].
+         */
+        explicit WaveletMatrix(const std::vector<uint32_t>& secuencia);
+
+        /**
+         * @brief Cuenta las apariciones de un carácter en las posiciones [0, i).
+         * 
+         * @param caracter Carácter a contar.
+         * @param i Largo del prefijo (0 <= i <= n).
+         * @return Cantidad de apariciones.
+         * 
+         * @complexity
+         * - Tiempo: O(log σ)
+         */
+        size_t rango(unsigned char caracter, size_t i) const;
+
+        /**
+         * @brief Solicita al procesador las líneas del primer nivel que leerá rango(caracter, i).
+         * 
+         * Los niveles siguientes dependen del resultado del anterior, por lo
+         * que solo el primero puede precargarse antes de la consulta.
+         */
+        void precargar(unsigned char, size_t i) const {
+            if (!niveles_.empty()) niveles_[0].precargar(i);
+        }
+
+        /**
+         * @brief Retorna el carácter en la posición i.
+         */
+        unsigned char acceder(size_t i) const;
+
+        /**
+         * @brief Cuenta las apariciones de un código en las posiciones [0, i).
+         */
+        size_t rangoCodigo(uint32_t codigo, size_t i) const;
+
+        /**
+         * @brief Retorna el código en la posición i.
+         */
+        uint32_t accederCodigo(size_t i) const;
+
+        /**
+         * @brief Códigos distintos de las posiciones [inicio, fin) con su cantidad de apariciones.
+         * 
+         * Desciende por los niveles separando el rango en su parte con bit 0 y
+         * su parte con bit 1, y descarta las partes vacías, de modo que el
+         * costo depende de los códigos presentes en el rango y no de su largo.
+         * 
+         * @return Pares (código, apariciones) en orden creciente de código.
+         * 
+         * @complexity
+         * - Tiempo: O(d·log σ) con d la cantidad de códigos distintos del rango
+         */
+        std::vector<std::pair<uint32_t, size_t>> frecuenciasEnRango(size_t inicio, size_t fin) const;
+
+        /**
+         * @brief Los k códigos más frecuentes de las posiciones [inicio, fin).
+         * 
+         * Expande primero los nodos con más posiciones (cola de prioridad):
+         * como un hijo nunca tiene más posiciones que su padre, cada hoja que
+         * sale de la cola es el siguiente código más frecuente.
+         * 
+         * @return Pares (código, apariciones) de mayor a menor frecuencia (empates por código).
+         */
+        std::vector<std::pair<uint32_t, size_t>> masFrecuentesEnRango(size_t inicio, size_t fin, size_t k) const;
+
+        /**
+         * @brief Largo de la secuencia.
+         */
+        size_t size() const { return longitud_; }
+
+        /**
+         * @brief Cantidad de niveles (bits por código).
+         */
+        uint32_t getCantidadNiveles() const { return cantidad_niveles_; }
+
+        /**
+         * @brief Bytes ocupados por todos los niveles y tablas auxiliares.
+         */
+        size_t getMemoriaBytes() const;
+
+        /**
+         * @brief Escribe la matriz en un archivo de índice.
+         */
+        void serializar(EscritorBinario& escritor) const;
+
+        /**
+         * @brief Enlaza la matriz a un archivo de índice mapeado.
+         * @throws std::runtime_error Si la sección está corrupta.
+         */
+        void mapear(LectorMapeado& lector);
+
+    private:
+        /**
+         * @brief Construye los niveles a partir de los códigos ya compactados.
+         * @param secuencia Códigos de la secuencia (se reordena durante la construcción).
+         * @param maximo Mayor código presente.
+         */
+        void construirNiveles(std::vector<uint32_t> secuencia, uint32_t maximo);
+
+        /**
+         * @brief Recorre en profundidad los nodos no vacíos bajo el rango [inicio, fin) del nivel dado.
+         */
+        void recorrerRango(uint32_t nivel, size_t inicio, size_t fin, uint32_t codigo,
+                           std::vector<std::pair<uint32_t, size_t>>& frecuencias) const;
+
+        std::vector<BitVector> niveles_;
+
+        /**
+         * @brief Cantidad de ceros de cada nivel (inicio de la zona de unos en el siguiente).
+         */
+        ArregloPlano<uint64_t> ceros_;
+
+        /**
+         * @brief Código de cada byte, o SIN_CODIGO si no aparece (solo para cadenas de bytes).
+         */
+        ArregloPlano<uint16_t> codigos_;
+
+        /**
+         * @brief Byte correspondiente a cada código (solo para cadenas de bytes).
+         */
+        ArregloPlano<unsigned char> caracteres_;
+
+        size_t longitud_ = 0;
+        uint32_t cantidad_niveles_ = 0;
+
+        static constexpr uint16_t SIN_CODIGO = 0xFFFF;
+};
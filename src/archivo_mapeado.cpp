@@ -0,0 +1,77 @@
+#include "../include/definiciones.hpp"
+#include "../include/archivo_mapeado.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+ArchivoMapeado::ArchivoMapeado(const std::string& ruta) {
+    HANDLE archivo = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (archivo == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("No se pudo abrir el archivo de índice: " + ruta);
+    }
+
+    LARGE_INTEGER tamanio;
+    if (!GetFileSizeEx(archivo, &tamanio) || tamanio.QuadPart == 0) {
+        CloseHandle(archivo);
+        throw std::runtime_error("Archivo de índice vacío o ilegible: " + ruta);
+    }
+
+    HANDLE mapeo = CreateFileMappingA(archivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* datos = mapeo ? MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!datos) {
+        if (mapeo) CloseHandle(mapeo);
+        CloseHandle(archivo);
+        throw std::runtime_error("No se pudo mapear el archivo de índice: " + ruta);
+    }
+
+    manejador_archivo_ = archivo;
+    manejador_mapeo_ = mapeo;
+    datos_ = static_cast<const char*>(datos);
+    tamanio_ = static_cast<size_t>(tamanio.QuadPart);
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    if (datos_) UnmapViewOfFile(datos_);
+    if (manejador_mapeo_) CloseHandle(manejador_mapeo_);
+    if (manejador_archivo_) CloseHandle(manejador_archivo_);
+}
+
+#else
+
+ArchivoMapeado::ArchivoMapeado(const std::string& ruta) {
+    int descriptor = open(ruta.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("No se pudo abrir el archivo de índice: " + ruta);
+    }
+
+    struct stat estado;
+    if (fstat(descriptor, &estado) != 0 || estado.st_size == 0) {
+        close(descriptor);
+        throw std::runtime_error("Archivo de índice vacío o ilegible: " + ruta);
+    }
+
+    // MAP_SHARED: las páginas se comparten en el page cache entre procesos
+    void* datos = mmap(nullptr, static_cast<size_t>(estado.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (datos == MAP_FAILED) {
+        throw std::runtime_error("No se pudo mapear el archivo de índice: " + ruta);
+    }
+
+    datos_ = static_cast<const char*>(datos);
+    tamanio_ = static_cast<size_t>(estado.st_size);
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    if (datos_) munmap(const_cast<char*>(datos_), tamanio_);
+}
+
+#endif
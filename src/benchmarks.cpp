@@ -0,0 +1,1285 @@
+#include "../include/definiciones.hpp"
+#include "../include/benchmarks.hpp"
+#include "../include/bit_vector.hpp"
+#include "../include/fm_index.hpp"
+#include "../include/fm_index_bidireccional.hpp"
+#include "../include/fm_index_incremental.hpp"
+#include "../include/indice_documentos.hpp"
+#include "../include/cache_consultas.hpp"
+#include "../include/suffix_arrays.hpp"
+#include "../include/boyer_moore.hpp"
+#include "../include/knuth_morris_pratt.hpp"
+#include "../include/robin_karp.hpp"
+#include "../include/two_way.hpp"
+#include "../include/myers.hpp"
+#include "../include/busqueda_paralela.hpp"
+#include "../include/medidor.hpp"
+#include "../include/utilities.hpp"
+#include "../include/json.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <new>
+#include <random>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+using json = nlohmann::json;
+
+#define NOMBRE_CARPETA_BENCHMARKS fs::path("test/json")
+
+/**
+ * @brief Consultas aleatorias por cada operación medida.
+ */
+static const size_t CONSULTAS_MICROBENCHMARK = 1000000;
+
+/**
+ * @brief Escribe los resultados de un modo de benchmark en test/json/<modo>/<modo>.json.
+ */
+static void guardarResultadosBenchmark(const std::string& modo, const json& resultados) {
+    fs::path carpeta = NOMBRE_CARPETA_BENCHMARKS / modo;
+    fs::create_directories(carpeta);
+
+    fs::path archivo = carpeta / (modo + ".json");
+    std::ofstream out(archivo);
+    if (!out) {
+        throw std::runtime_error("Error abriendo archivo " + archivo.string() + " para escritura\n");
+    }
+    out << std::setw(4) << resultados << std::endl;
+}
+
+/**
+ * @brief Nanosegundos promedio por consulta de una operación sobre las consultas dadas.
+ * @param suma_control Acumula los resultados para que el compilador no descarte las llamadas.
+ */
+template <typename Operacion>
+static double medirNanosegundos(const std::vector<size_t>& consultas, Operacion operacion, size_t& suma_control) {
+    auto inicio = iniciarTimer();
+    for (size_t consulta : consultas) suma_control += operacion(consulta);
+    auto fin = detenerTimer();
+    return calcularDuracion(inicio, fin).count() * 1e6 / static_cast<double>(consultas.size());
+}
+
+/**
+ * @brief Consultas uniformes en [minimo, maximo].
+ */
+static std::vector<size_t> generarConsultas(std::mt19937_64& generador, size_t minimo, size_t maximo) {
+    std::uniform_int_distribution<size_t> distribucion(minimo, maximo);
+    std::vector<size_t> consultas(CONSULTAS_MICROBENCHMARK);
+    for (auto& consulta : consultas) consulta = distribucion(generador);
+    return consultas;
+}
+
+void ejecutarBenchmarkBitVector(uint64_t max_bits) {
+    std::mt19937_64 generador(2025);
+    json resultados = json::array();
+
+    // Densidad 1/2: una palabra aleatoria; densidad 1/16: AND de cuatro palabras
+    const std::vector<std::pair<double, int>> densidades = {{0.5, 1}, {0.0625, 4}};
+
+    for (uint64_t cantidad_bits = 1000000; cantidad_bits <= max_bits; cantidad_bits *= 10) {
+        for (const auto& densidad : densidades) {
+            try {
+                VectorAlineado<uint64_t> palabras(static_cast<size_t>(cantidad_bits / 64 + 1));
+                for (auto& palabra : palabras) {
+                    palabra = ~0ULL;
+                    rep(i, densidad.second) palabra &= generador();
+                }
+
+                auto t_inicio_const = iniciarTimer();
+                BitVector bits(std::move(palabras), static_cast<size_t>(cantidad_bits));
+                auto t_fin_const = detenerTimer();
+
+                size_t suma_control = 0;
+                auto consultas_rango = generarConsultas(generador, 0, bits.size());
+                double ns_rango = medirNanosegundos(consultas_rango, [&bits](size_t i) { return bits.rango1(i); }, suma_control);
+
+                auto consultas_unos = generarConsultas(generador, 1, bits.contarUnos());
+                double ns_seleccion1 = medirNanosegundos(consultas_unos, [&bits](size_t k) { return bits.seleccionar1(k); }, suma_control);
+
+                auto consultas_ceros = generarConsultas(generador, 1, bits.contarCeros());
+                double ns_seleccion0 = medirNanosegundos(consultas_ceros, [&bits](size_t k) { return bits.seleccionar0(k); }, suma_control);
+
+                json resultado;
+                resultado["bits"] = cantidad_bits;
+                resultado["densidad"] = densidad.first;
+                resultado["tiempo_construccion_mili"] = calcularDuracion(t_inicio_const, t_fin_const).count();
+                resultado["ns_rango1"] = ns_rango;
+                resultado["ns_seleccionar1"] = ns_seleccion1;
+                resultado["ns_seleccionar0"] = ns_seleccion0;
+                resultado["memoria_bytes"] = bits.getMemoriaBytes();
+                resultado["bits_por_bit"] = static_cast<double>(bits.getMemoriaBytes()) * 8.0 / static_cast<double>(cantidad_bits);
+                resultado["suma_control"] = suma_control;
+                resultados.push_back(resultado);
+
+                imprimir(VERDE "BitVector " << cantidad_bits << " bits, densidad " << densidad.first
+                         << ": rango1 " << ns_rango << " ns, seleccionar1 " << ns_seleccion1
+                         << " ns, seleccionar0 " << ns_seleccion0 << " ns" RESET_COLOR);
+            } catch (const std::bad_alloc&) {
+                imprimir(AMARILLO "Memoria insuficiente para " << cantidad_bits << " bits; se omite el tamaño" RESET_COLOR);
+            }
+        }
+    }
+
+    guardarResultadosBenchmark("bitvector", resultados);
+}
+
+/**
+ * @brief Largo de los patrones del benchmark de búsqueda en lote.
+ */
+static const size_t LARGO_PATRON_LOTE = 12;
+
+/**
+ * @brief Alfabeto de los textos aleatorios de los benchmarks de FMIndex.
+ */
+static const std::string ALFABETO_BENCHMARK = "ACGT";
+
+/**
+ * @brief Texto aleatorio uniforme sobre ALFABETO_BENCHMARK.
+ */
+static std::string generarTextoAleatorio(std::mt19937_64& generador, size_t longitud) {
+    std::string texto(longitud, 'A');
+    for (auto& caracter : texto) caracter = ALFABETO_BENCHMARK[generador() % ALFABETO_BENCHMARK.size()];
+    return texto;
+}
+
+/**
+ * @brief Patrones de largo dado: los de índice par tomados del texto (con ocurrencias), los demás aleatorios.
+ */
+static std::vector<std::string> generarPatrones(std::mt19937_64& generador, const std::string& texto, size_t cantidad, size_t largo) {
+    std::vector<std::string> patrones(cantidad);
+    std::uniform_int_distribution<size_t> distribucion_inicio(0, texto.size() - largo);
+    rep(k, patrones.size()) {
+        if (k % 2 == 0) {
+            patrones[k] = texto.substr(distribucion_inicio(generador), largo);
+        } else {
+            patrones[k].resize(largo);
+            for (auto& caracter : patrones[k]) caracter = ALFABETO_BENCHMARK[generador() % ALFABETO_BENCHMARK.size()];
+        }
+    }
+    return patrones;
+}
+
+void ejecutarBenchmarkLote(size_t longitud_texto) {
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_texto);
+    std::vector<std::string> patrones = generarPatrones(generador, texto, CONSULTAS_MICROBENCHMARK, LARGO_PATRON_LOTE);
+
+    json resultados = json::array();
+    const std::vector<std::pair<std::string, TipoRango>> backends = {
+        {"tabla", TipoRango::Tabla}, {"wavelet", TipoRango::Wavelet}
+    };
+
+    for (const auto& backend : backends) {
+        OpcionesFMIndex opciones;
+        opciones.tipo_rango = backend.second;
+        FMIndex indice(texto, opciones);
+
+        auto t_inicio_individual = iniciarTimer();
+        std::vector<unsigned int> conteos_individuales(patrones.size());
+        rep(k, patrones.size()) conteos_individuales[k] = indice.buscar(patrones[k]);
+        auto t_fin_individual = detenerTimer();
+
+        auto t_inicio_lote = iniciarTimer();
+        std::vector<unsigned int> conteos_lote = indice.buscarLote(patrones);
+        auto t_fin_lote = detenerTimer();
+
+        if (conteos_lote != conteos_individuales) {
+            throw std::runtime_error("buscarLote difiere de buscar en el backend " + backend.first);
+        }
+
+        double cantidad = static_cast<double>(patrones.size());
+        double ns_individual = calcularDuracion(t_inicio_individual, t_fin_individual).count() * 1e6 / cantidad;
+        double ns_lote = calcularDuracion(t_inicio_lote, t_fin_lote).count() * 1e6 / cantidad;
+
+        json resultado;
+        resultado["backend"] = backend.first;
+        resultado["longitud_texto"] = longitud_texto;
+        resultado["patrones"] = patrones.size();
+        resultado["largo_patron"] = LARGO_PATRON_LOTE;
+        resultado["ns_por_patron_individual"] = ns_individual;
+        resultado["ns_por_patron_lote"] = ns_lote;
+        resultado["aceleracion"] = ns_individual / ns_lote;
+        resultados.push_back(resultado);
+
+        imprimir(VERDE "FMIndex " << backend.first << " (" << longitud_texto << " caracteres): buscar "
+                 << ns_individual << " ns/patrón, buscarLote " << ns_lote << " ns/patrón" RESET_COLOR);
+    }
+
+    guardarResultadosBenchmark("lote", resultados);
+}
+
+/**
+ * @brief Patrones distintos entre los que se reparten las consultas Zipf.
+ */
+static const size_t PATRONES_DISTINTOS_CACHE = 100000;
+
+/**
+ * @brief Índices de consultas con P(k) proporcional a 1/(k+1)^s sobre [0, cantidad_patrones).
+ * 
+ * Invierte la distribución acumulada con búsqueda binaria.
+ */
+static std::vector<size_t> generarConsultasZipf(std::mt19937_64& generador, size_t cantidad_patrones, double exponente) {
+    std::vector<double> acumulada(cantidad_patrones);
+    double suma = 0.0;
+    rep(k, cantidad_patrones) {
+        suma += 1.0 / std::pow(static_cast<double>(k + 1), exponente);
+        acumulada[k] = suma;
+    }
+
+    std::uniform_real_distribution<double> distribucion(0.0, suma);
+    std::vector<size_t> consultas(CONSULTAS_MICROBENCHMARK);
+    for (auto& consulta : consultas) {
+        auto rango = std::lower_bound(acumulada.begin(), acumulada.end(), distribucion(generador));
+        consulta = std::min(static_cast<size_t>(rango - acumulada.begin()), cantidad_patrones - 1);
+    }
+    return consultas;
+}
+
+/**
+ * @brief Vista de una estructura ajena, para envolverla en varias cachés sin reconstruirla.
+ */
+class EstructuraPrestada : public BaseStructure {
+    public:
+        explicit EstructuraPrestada(const BaseStructure& estructura) : estructura_(estructura) {}
+        unsigned int buscar(const std::string& patron) const override { return estructura_.buscar(patron); }
+        size_t getMemoriaBytes() const override { return estructura_.getMemoriaBytes(); }
+
+    private:
+        const BaseStructure& estructura_;
+};
+
+void ejecutarBenchmarkCache(size_t longitud_texto, double exponente_zipf) {
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_texto);
+    std::vector<std::string> patrones = generarPatrones(generador, texto, PATRONES_DISTINTOS_CACHE, LARGO_PATRON_LOTE);
+    std::shuffle(patrones.begin(), patrones.end(), generador);  // Los frecuentes no siempre tienen ocurrencias
+    std::vector<size_t> consultas = generarConsultasZipf(generador, patrones.size(), exponente_zipf);
+
+    FMIndex indice(texto);
+
+    auto t_inicio_base = iniciarTimer();
+    std::vector<unsigned int> conteos_base(consultas.size());
+    rep(k, consultas.size()) conteos_base[k] = indice.buscar(patrones[consultas[k]]);
+    auto t_fin_base = detenerTimer();
+    double ns_base = calcularDuracion(t_inicio_base, t_fin_base).count() * 1e6 / static_cast<double>(consultas.size());
+
+    json resultados = json::array();
+    json resultado_base;
+    resultado_base["configuracion"] = "sin_cache";
+    resultado_base["ns_por_consulta"] = ns_base;
+    resultado_base["memoria_bytes"] = indice.getMemoriaBytes();
+    resultados.push_back(resultado_base);
+    imprimir(VERDE "FMIndex sin caché: " << ns_base << " ns/consulta" RESET_COLOR);
+
+    // Capacidades crecientes sin vencimiento y una con vencimiento corto
+    std::vector<std::pair<std::string, OpcionesCache>> configuraciones;
+    for (size_t capacidad : {1000, 10000, 100000}) {
+        OpcionesCache opciones;
+        opciones.capacidad = capacidad;
+        configuraciones.emplace_back("lru_" + std::to_string(capacidad), opciones);
+    }
+    OpcionesCache opciones_ttl;
+    opciones_ttl.capacidad = 10000;
+    opciones_ttl.ttl = std::chrono::milliseconds(5);
+    configuraciones.emplace_back("lru_10000_ttl_5ms", opciones_ttl);
+
+    for (const auto& configuracion : configuraciones) {
+        CacheConsultas cache(std::make_unique<EstructuraPrestada>(indice), configuracion.second);
+
+        auto t_inicio = iniciarTimer();
+        std::vector<unsigned int> conteos(consultas.size());
+        rep(k, consultas.size()) conteos[k] = cache.buscar(patrones[consultas[k]]);
+        auto t_fin = detenerTimer();
+
+        if (conteos != conteos_base) {
+            throw std::runtime_error("CacheConsultas difiere del índice en la configuración " + configuracion.first);
+        }
+
+        double ns_cache = calcularDuracion(t_inicio, t_fin).count() * 1e6 / static_cast<double>(consultas.size());
+
+        json resultado;
+        resultado["configuracion"] = configuracion.first;
+        resultado["capacidad"] = configuracion.second.capacidad;
+        resultado["ttl_mili"] = configuracion.second.ttl.count();
+        resultado["ns_por_consulta"] = ns_cache;
+        resultado["aceleracion"] = ns_base / ns_cache;
+        resultado["cache_aciertos"] = cache.getAciertos();
+        resultado["cache_fallos"] = cache.getFallos();
+        resultado["cache_tasa_aciertos"] = cache.getTasaAciertos();
+        resultado["memoria_bytes"] = cache.getMemoriaBytes();
+        resultados.push_back(resultado);
+
+        imprimir(VERDE "CacheConsultas " << configuracion.first << ": " << ns_cache << " ns/consulta, "
+                 << 100.0 * cache.getTasaAciertos() << "% de aciertos" RESET_COLOR);
+    }
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["patrones_distintos"] = patrones.size();
+    salida["consultas"] = consultas.size();
+    salida["exponente_zipf"] = exponente_zipf;
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("cache", salida);
+}
+
+/**
+ * @brief Cantidades de hilos a medir: 1, 2, 4, ... y max_hilos.
+ */
+static std::vector<size_t> generarCantidadesHilos(size_t max_hilos) {
+    std::vector<size_t> cantidades_hilos;
+    for (size_t hilos = 1; hilos < max_hilos; hilos *= 2) cantidades_hilos.push_back(hilos);
+    cantidades_hilos.push_back(std::max<size_t>(max_hilos, 1));
+    return cantidades_hilos;
+}
+
+/**
+ * @brief Segundos que tardan `hilos` hilos en responder todos los patrones sobre la misma estructura.
+ * 
+ * El hilo h responde los patrones h, h + hilos, h + 2·hilos, ... Todos
+ * esperan una señal común antes de empezar para medir solo la fase
+ * concurrente. Retorna la cantidad de conteos distintos de los esperados.
+ */
+static size_t medirConsultasConcurrentes(const BaseStructure& estructura, const std::vector<std::string>& patrones,
+                                         const std::vector<unsigned int>& esperados, size_t hilos, double& segundos) {
+    std::atomic<size_t> listos{0};
+    std::atomic<bool> partida{false};
+    std::atomic<size_t> diferencias{0};
+
+    std::vector<std::thread> lectores;
+    lectores.reserve(hilos);
+    rep(h, hilos) {
+        lectores.emplace_back([&, h]() {
+            listos.fetch_add(1);
+            while (!partida.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            size_t propias = 0;
+            for (size_t k = static_cast<size_t>(h); k < patrones.size(); k += hilos) {
+                if (estructura.buscar(patrones[k]) != esperados[k]) propias++;
+            }
+            diferencias.fetch_add(propias);
+        });
+    }
+
+    while (listos.load() < hilos) std::this_thread::yield();
+    auto inicio = iniciarTimer();
+    partida.store(true, std::memory_order_release);
+    for (auto& lector : lectores) lector.join();
+    auto fin = detenerTimer();
+
+    segundos = calcularDuracion(inicio, fin).count() / 1e3;
+    return diferencias.load();
+}
+
+/**
+ * @brief Largo del texto que cada medición de verificarMedidorConcurrente indexa.
+ */
+static const size_t LARGO_TEXTO_MEDIDOR = 1 << 16;
+
+/**
+ * @brief Mediciones de estructura y de algoritmo que hace cada hilo en verificarMedidorConcurrente.
+ */
+static const size_t MEDICIONES_POR_HILO_MEDIDOR = 8;
+
+/**
+ * @brief Llama a medirEstructura y medirAlgoritmo desde `hilos` hilos a la vez y revisa lo registrado.
+ * 
+ * Cada medición lleva un nombre propio. Al terminar, el medidor debe tener
+ * exactamente un resultado por medición, con su tipo y, para las
+ * estructuras, la memoria del índice: un resultado mezclado entre hilos o
+ * perdido aparece como diferencia. Retorna la cantidad de diferencias.
+ */
+static size_t verificarMedidorConcurrente(const std::string& texto, const std::vector<std::string>& patrones, size_t hilos) {
+    std::vector<unsigned int> esperados(patrones.size());
+    rep(k, patrones.size()) esperados[k] = KnuthMorrisPratt::buscar(texto, patrones[k]);
+    size_t memoria_indice = FMIndex(texto).getMemoriaBytes();
+    extraerResultados();
+
+    std::atomic<size_t> diferencias{0};
+    std::vector<std::thread> medidores;
+    medidores.reserve(hilos);
+    rep(h, hilos) {
+        medidores.emplace_back([&, h]() {
+            size_t propias = 0;
+            rep(m, MEDICIONES_POR_HILO_MEDIDOR) {
+                size_t k = (static_cast<size_t>(h) * MEDICIONES_POR_HILO_MEDIDOR + static_cast<size_t>(m)) % patrones.size();
+                std::string sufijo = "#" + std::to_string(h) + "." + std::to_string(m);
+                unsigned int estructura = medirEstructura("FMIndex" + sufijo, [](const std::string& t) {
+                    return std::make_unique<FMIndex>(t);
+                }, texto, patrones[k]);
+                unsigned int algoritmo = medirAlgoritmo("KnuthMorrisPratt" + sufijo, KnuthMorrisPratt::buscar, texto, patrones[k]);
+                if (estructura != esperados[k]) propias++;
+                if (algoritmo != esperados[k]) propias++;
+            }
+            diferencias.fetch_add(propias);
+        });
+    }
+    for (auto& medidor : medidores) medidor.join();
+
+    json resultados = extraerResultados();
+    size_t total = diferencias.load();
+    std::set<std::string> nombres;
+    for (const auto& resultado : resultados) {
+        const std::string nombre = resultado.value("Nombre", "");
+        const std::string tipo = resultado.value("Tipo", "");
+        bool es_estructura = nombre.rfind("FMIndex#", 0) == 0;
+        if (!nombres.insert(nombre).second || tipo != (es_estructura ? "Estructura" : "Algoritmo")
+            || !resultado.contains("tiempo_busqueda_mili")
+            || (es_estructura && resultado.value("memoria_estructura_bytes", size_t(0)) != memoria_indice)) {
+            total++;
+        }
+    }
+    size_t mediciones = 2 * hilos * MEDICIONES_POR_HILO_MEDIDOR;
+    return total + (mediciones > resultados.size() ? mediciones - resultados.size() : resultados.size() - mediciones);
+}
+
+void ejecutarBenchmarkConcurrente(size_t longitud_texto, size_t max_hilos) {
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_texto);
+    std::vector<std::string> patrones = generarPatrones(generador, texto, CONSULTAS_MICROBENCHMARK, LARGO_PATRON_LOTE);
+
+    std::vector<size_t> cantidades_hilos = generarCantidadesHilos(max_hilos);
+
+    OpcionesFMIndex opciones_wavelet;
+    opciones_wavelet.tipo_rango = TipoRango::Wavelet;
+
+    std::vector<std::pair<std::string, std::function<std::unique_ptr<BaseStructure>()>>> estructuras = {
+        {"FMIndex",        [&texto]() { return std::make_unique<FMIndex>(texto); }},
+        {"FMIndexWavelet", [&]() { return std::make_unique<FMIndex>(texto, opciones_wavelet); }},
+        {"SuffixArrays",   [&texto]() { return std::make_unique<SuffixArrays>(texto); }},
+    };
+
+    json resultados = json::array();
+    for (const auto& entrada : estructuras) {
+        auto estructura = entrada.second();
+
+        std::vector<unsigned int> esperados(patrones.size());
+        rep(k, patrones.size()) esperados[k] = estructura->buscar(patrones[k]);
+
+        double qps_un_hilo = 0.0;
+        for (size_t hilos : cantidades_hilos) {
+            double segundos = 0.0;
+            size_t diferencias = medirConsultasConcurrentes(*estructura, patrones, esperados, hilos, segundos);
+            if (diferencias > 0) {
+                throw std::runtime_error(entrada.first + " retornó " + std::to_string(diferencias)
+                                         + " conteos distintos con " + std::to_string(hilos) + " hilos");
+            }
+
+            double qps = static_cast<double>(patrones.size()) / segundos;
+            if (hilos == 1) qps_un_hilo = qps;
+
+            json resultado;
+            resultado["estructura"] = entrada.first;
+            resultado["hilos"] = hilos;
+            resultado["consultas"] = patrones.size();
+            resultado["consultas_por_segundo"] = qps;
+            resultado["aceleracion"] = qps / qps_un_hilo;
+            resultado["eficiencia"] = qps / qps_un_hilo / static_cast<double>(hilos);
+            resultado["memoria_bytes"] = estructura->getMemoriaBytes();
+            resultados.push_back(resultado);
+
+            imprimir(VERDE << entrada.first << " con " << hilos << " hilos: " << qps << " consultas/s ("
+                     << qps / qps_un_hilo << "x)" RESET_COLOR);
+        }
+    }
+
+    // El medidor también se comparte: cada hilo arma su medición y la agrega al arreglo común
+    std::string texto_medidor = texto.substr(0, std::min(texto.size(), LARGO_TEXTO_MEDIDOR));
+    std::vector<std::string> patrones_medidor = generarPatrones(generador, texto_medidor, MEDICIONES_POR_HILO_MEDIDOR, LARGO_PATRON_LOTE);
+    size_t hilos_medidor = cantidades_hilos.back();
+    size_t diferencias_medidor = verificarMedidorConcurrente(texto_medidor, patrones_medidor, hilos_medidor);
+    if (diferencias_medidor > 0) {
+        throw std::runtime_error("El medidor registró " + std::to_string(diferencias_medidor)
+                                 + " resultados erróneos con " + std::to_string(hilos_medidor) + " hilos");
+    }
+    imprimir(VERDE "Medidor con " << hilos_medidor << " hilos: " << 2 * hilos_medidor * MEDICIONES_POR_HILO_MEDIDOR
+             << " mediciones registradas sin diferencias" RESET_COLOR);
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["nucleos"] = std::thread::hardware_concurrency();
+    salida["resultados"] = resultados;
+    salida["mediciones_medidor_concurrentes"] = 2 * hilos_medidor * MEDICIONES_POR_HILO_MEDIDOR;
+    guardarResultadosBenchmark("concurrente", salida);
+}
+
+/**
+ * @brief Segmentos pequeños para que verificarPoolConcurrente reparta muchas tareas.
+ */
+static const size_t TAMANO_SEGMENTO_VERIFICACION = 1 << 12;
+
+/**
+ * @brief Usa un mismo pool desde dos hilos a la vez y desde dentro de sus propias tareas.
+ * 
+ * Dos hilos cuentan el patrón al mismo tiempo mientras un tercero ejecuta
+ * tareas que lanzan una excepción: los conteos deben ser los secuenciales y
+ * la excepción debe llegar solo a quien lanzó esas tareas. Luego una tarea
+ * del pool llama a contarParalelo() sobre el mismo pool, lo que no debe
+ * bloquearse aunque el pool tenga un solo hilo.
+ * 
+ * @throws std::runtime_error Si algún conteo difiere o la excepción llega a otro lote.
+ */
+static void verificarPoolConcurrente(std::string_view texto, const std::string& patron, MotorSegmento motor,
+                                     uint64_t esperado, size_t hilos) {
+    PoolTrabajo pool(hilos);
+    std::atomic<bool> partida{false};
+    std::atomic<size_t> errores{0};
+
+    auto contar = [&]() {
+        while (!partida.load(std::memory_order_acquire)) std::this_thread::yield();
+        try {
+            if (contarParalelo(motor, texto, patron, pool, TAMANO_SEGMENTO_VERIFICACION) != esperado) errores++;
+        } catch (...) {
+            errores++;     // La excepción del otro lote no debe llegar aquí
+        }
+    };
+    auto fallar = [&]() {
+        while (!partida.load(std::memory_order_acquire)) std::this_thread::yield();
+        std::vector<std::function<void()>> tareas(4 * hilos, []() { throw std::logic_error("tarea fallida"); });
+        try {
+            pool.ejecutar(std::move(tareas));
+            errores++;
+        } catch (const std::logic_error&) {}
+    };
+
+    std::thread primero(contar), segundo(contar), tercero(fallar);
+    partida.store(true, std::memory_order_release);
+    primero.join();
+    segundo.join();
+    tercero.join();
+    if (errores.load() > 0) {
+        throw std::runtime_error("El pool mezcló los lotes de llamadas concurrentes (" + std::to_string(errores.load()) + " errores)");
+    }
+
+    uint64_t anidado = 0;
+    std::vector<std::function<void()>> externa = {[&]() {
+        anidado = contarParalelo(motor, texto, patron, pool, TAMANO_SEGMENTO_VERIFICACION);
+    }};
+    pool.ejecutar(std::move(externa));
+    if (anidado != esperado) {
+        throw std::runtime_error("contarParalelo dentro de una tarea del pool contó " + std::to_string(anidado)
+                                 + " ocurrencias y el secuencial " + std::to_string(esperado));
+    }
+}
+
+void ejecutarBenchmarkEscaneo(size_t longitud_texto, size_t max_hilos) {
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_texto);
+    std::string patron = generarPatrones(generador, texto, 1, LARGO_PATRON_LOTE)[0];
+    double gigabytes = static_cast<double>(longitud_texto) / 1e9;
+
+    const std::vector<std::pair<std::string, std::pair<unsigned int(*)(const std::string&, const std::string&), MotorSegmento>>> motores = {
+        {"BoyerMoore",       {BoyerMoore::buscar, BoyerMoore::buscarEnSegmento}},
+        {"KnuthMorrisPratt", {KnuthMorrisPratt::buscar, KnuthMorrisPratt::buscarEnSegmento}},
+        {"KnuthMorrisPrattAutomata", {KnuthMorrisPratt::buscarAutomata, KnuthMorrisPratt::buscarAutomataEnSegmento}},
+        {"RobinKarp",        {RobinKarp::buscar, RobinKarp::buscarEnSegmento}},
+        {"TwoWay",           {TwoWay::buscar, TwoWay::buscarEnSegmento}},
+    };
+
+    json resultados = json::array();
+    for (const auto& motor : motores) {
+        auto t_inicio_secuencial = iniciarTimer();
+        uint64_t esperado = motor.second.first(texto, patron);
+        auto t_fin_secuencial = detenerTimer();
+        double gbs_secuencial = gigabytes / (calcularDuracion(t_inicio_secuencial, t_fin_secuencial).count() / 1e3);
+
+        imprimir(VERDE << motor.first << " secuencial: " << gbs_secuencial << " GB/s" RESET_COLOR);
+
+        std::string_view muestra = std::string_view(texto).substr(0, std::min(texto.size(), TAMANO_SEGMENTO_PARALELO));
+        uint64_t esperado_muestra = motor.second.second(muestra, patron);
+        verificarPoolConcurrente(muestra, patron, motor.second.second, esperado_muestra, 1);
+        verificarPoolConcurrente(muestra, patron, motor.second.second, esperado_muestra, max_hilos);
+
+        for (size_t hilos : generarCantidadesHilos(max_hilos)) {
+            PoolTrabajo pool(hilos);
+
+            auto t_inicio = iniciarTimer();
+            uint64_t conteo = contarParalelo(motor.second.second, texto, patron, pool);
+            auto t_fin = detenerTimer();
+
+            if (conteo != esperado) {
+                throw std::runtime_error(motor.first + " por segmentos contó " + std::to_string(conteo)
+                                         + " ocurrencias y el secuencial " + std::to_string(esperado));
+            }
+
+            double gbs = gigabytes / (calcularDuracion(t_inicio, t_fin).count() / 1e3);
+
+            json resultado;
+            resultado["algoritmo"] = motor.first;
+            resultado["hilos"] = hilos;
+            resultado["ocurrencias"] = conteo;
+            resultado["gb_por_segundo_secuencial"] = gbs_secuencial;
+            resultado["gb_por_segundo"] = gbs;
+            resultado["aceleracion"] = gbs / gbs_secuencial;
+            resultados.push_back(resultado);
+
+            imprimir(VERDE << motor.first << " con " << hilos << " hilos: " << gbs << " GB/s ("
+                     << gbs / gbs_secuencial << "x)" RESET_COLOR);
+        }
+    }
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["largo_patron"] = patron.size();
+    salida["tamano_segmento"] = TAMANO_SEGMENTO_PARALELO;
+    salida["nucleos"] = std::thread::hardware_concurrency();
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("escaneo", salida);
+}
+
+// ========== Construcción en paralelo ==========
+
+void ejecutarBenchmarkConstruccion(size_t longitud_texto, size_t max_hilos) {
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_texto);
+
+    json resultados = json::array();
+    std::string bwt_secuencial;
+    double ms_total_secuencial = 0;
+    for (size_t hilos : generarCantidadesHilos(max_hilos)) {
+        std::unique_ptr<PoolTrabajo> pool_propio;
+        PoolTrabajo* pool = poolParaHilos(hilos, pool_propio);
+
+        auto t_inicio_sufijos = iniciarTimer();
+        vc arreglo_sufijos = construirArregloSufijos(texto, pool);
+        auto t_fin_sufijos = detenerTimer();
+        double ms_sufijos = calcularDuracion(t_inicio_sufijos, t_fin_sufijos).count();
+
+        auto t_inicio_bwt = iniciarTimer();
+        TransformadaBWT transformada = transformadaDesdeArreglo(texto, std::move(arreglo_sufijos), pool);
+        auto t_fin_bwt = detenerTimer();
+        double ms_bwt = calcularDuracion(t_inicio_bwt, t_fin_bwt).count();
+
+        auto t_inicio_tabla_c = iniciarTimer();
+        std::vector<uint64_t> tabla_c = construirTablaInicioCaracter(transformada.bwt, pool);
+        auto t_fin_tabla_c = detenerTimer();
+        double ms_tabla_c = calcularDuracion(t_inicio_tabla_c, t_fin_tabla_c).count();
+
+        auto t_inicio_ocurrencias = iniciarTimer();
+        TablaOcurrencias ocurrencias(transformada.bwt, pool);
+        auto t_fin_ocurrencias = detenerTimer();
+        double ms_ocurrencias = calcularDuracion(t_inicio_ocurrencias, t_fin_ocurrencias).count();
+
+        OpcionesFMIndex opciones;
+        opciones.hilos_construccion = hilos;
+        auto t_inicio_indice = iniciarTimer();
+        FMIndex indice(transformada, opciones);
+        auto t_fin_indice = detenerTimer();
+        double ms_indice = calcularDuracion(t_inicio_indice, t_fin_indice).count();
+
+        if (bwt_secuencial.empty()) bwt_secuencial = transformada.bwt;
+        else if (transformada.bwt != bwt_secuencial) {
+            throw std::runtime_error("La BWT construida con " + std::to_string(hilos) + " hilos difiere de la secuencial");
+        }
+
+        double ms_total = ms_sufijos + ms_bwt + ms_indice;
+        if (ms_total_secuencial == 0) ms_total_secuencial = ms_total;
+
+        json resultado;
+        resultado["hilos"] = hilos;
+        resultado["ms_arreglo_sufijos"] = ms_sufijos;
+        resultado["ms_bwt"] = ms_bwt;
+        resultado["ms_tabla_c"] = ms_tabla_c;
+        resultado["ms_tabla_ocurrencias"] = ms_ocurrencias;
+        resultado["ms_indice_desde_transformada"] = ms_indice;
+        resultado["ms_total"] = ms_total;
+        resultado["aceleracion"] = ms_total_secuencial / ms_total;
+        resultados.push_back(resultado);
+
+        imprimir(VERDE << hilos << " hilos: sufijos " << ms_sufijos << " ms, BWT " << ms_bwt << " ms, tabla C " << ms_tabla_c
+                 << " ms, ocurrencias " << ms_ocurrencias << " ms, índice " << ms_indice << " ms; total " << ms_total
+                 << " ms (" << ms_total_secuencial / ms_total << "x)" RESET_COLOR);
+    }
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("construccion", salida);
+}
+
+// ========== Construcción en memoria externa ==========
+
+/**
+ * @brief Largo máximo del texto de σ alto de verificarPresupuestoExterno.
+ */
+static const size_t LARGO_TEXTO_SIGMA_ALTO = 1 << 22;
+
+/**
+ * @brief Verifica que la construcción externa respete el presupuesto con un alfabeto grande.
+ * 
+ * El texto tiene σ = 192 (cubetas de solo 2 caracteres) y la mitad de sus
+ * caracteres son espacios, como el código fuente, de modo que la cubeta
+ * "  " tiene un cuarto de los sufijos y un presupuesto de n/16 sufijos
+ * obliga a subdividirla. La BWT debe coincidir con la construida en memoria.
+ * 
+ * @return Mayor cantidad de sufijos ordenados en una pasada.
+ * @throws std::runtime_error Si una pasada excede el presupuesto o la BWT difiere.
+ */
+static size_t verificarPresupuestoExterno(std::mt19937_64& generador, const std::string& directorio, size_t longitud) {
+    std::string texto(longitud, ' ');
+    for (auto& caracter : texto) {
+        if (generador() % 2) caracter = static_cast<char>(64 + generador() % 191);
+    }
+
+    size_t capacidad = std::max<size_t>(longitud / 16, 1);
+    ArchivoTemporal archivo_bwt(directorio, "bwt");
+    TransformadaExterna externa = construirTransformadaExterna(texto, PASO_MUESTREO_SUFIJOS, archivo_bwt.getRuta(),
+                                                              capacidad * sizeof(uint64_t));
+    if (externa.max_sufijos_pasada > capacidad) {
+        throw std::runtime_error("La construcción externa ordenó " + std::to_string(externa.max_sufijos_pasada)
+                                 + " sufijos en una pasada con un presupuesto de " + std::to_string(capacidad));
+    }
+
+    TransformadaBWT en_memoria = construirTransformadaBWT(texto);
+    std::ifstream entrada(archivo_bwt.getRuta(), std::ios::binary);
+    std::string bwt((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+    if (bwt != en_memoria.bwt || externa.fila_centinela != en_memoria.fila_centinela) {
+        throw std::runtime_error("La BWT externa del texto de σ alto difiere de la construida en memoria");
+    }
+    return externa.max_sufijos_pasada;
+}
+
+void ejecutarBenchmarkExterna(size_t longitud_texto, size_t memoria_mb) {
+    OpcionesConstruccionExterna externa;
+    externa.memoria_bytes = memoria_mb << 20;
+    ArchivoTemporal archivo_texto(externa.directorio_temporal, "texto");
+
+    std::mt19937_64 generador(2025);
+    std::vector<std::string> patrones;
+    {
+        std::string texto = generarTextoAleatorio(generador, longitud_texto);
+        patrones = generarPatrones(generador, texto, 1000, LARGO_PATRON_LOTE);
+        std::ofstream salida(archivo_texto.getRuta(), std::ios::binary);
+        salida.write(texto.data(), static_cast<std::streamsize>(texto.size()));
+        if (!salida) throw std::runtime_error("No se pudo escribir el texto en " + archivo_texto.getRuta());
+    }
+
+    // El pico de memoria solo crece: primero la construcción externa, después la completa
+    size_t kb_inicial = obtenerMemoriaMaximaKb();
+    auto t_inicio_externa = iniciarTimer();
+    auto externo = FMIndex::construirExterno(archivo_texto.getRuta(), OpcionesFMIndex(), externa);
+    auto t_fin_externa = detenerTimer();
+    double ms_externa = calcularDuracion(t_inicio_externa, t_fin_externa).count();
+    size_t kb_externa = obtenerMemoriaMaximaKb();
+
+    auto t_inicio_memoria = iniciarTimer();
+    std::unique_ptr<FMIndex> en_memoria;
+    {
+        std::ifstream entrada(archivo_texto.getRuta(), std::ios::binary);
+        std::string texto((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+        en_memoria = std::make_unique<FMIndex>(texto);
+    }
+    auto t_fin_memoria = detenerTimer();
+    double ms_memoria = calcularDuracion(t_inicio_memoria, t_fin_memoria).count();
+    size_t kb_memoria = obtenerMemoriaMaximaKb();
+
+    for (const auto& patron : patrones) {
+        if (externo->buscar(patron) != en_memoria->buscar(patron)) {
+            throw std::runtime_error("La construcción externa cuenta distinto el patrón " + patron);
+        }
+    }
+
+    size_t largo_sigma_alto = std::min(longitud_texto, LARGO_TEXTO_SIGMA_ALTO);
+    size_t max_sufijos_sigma_alto = verificarPresupuestoExterno(generador, externa.directorio_temporal, largo_sigma_alto);
+    imprimir(VERDE "σ = 192: a lo más " << max_sufijos_sigma_alto << " sufijos por pasada con un presupuesto de "
+             << std::max<size_t>(largo_sigma_alto / 16, 1) << RESET_COLOR);
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["memoria_mb"] = memoria_mb;
+    salida["ms_externa"] = ms_externa;
+    salida["ms_en_memoria"] = ms_memoria;
+    salida["pico_kb_externa"] = kb_externa - kb_inicial;
+    salida["pico_kb_en_memoria"] = kb_memoria - kb_inicial;
+    salida["memoria_indice_bytes"] = externo->getMemoriaBytes();
+    salida["max_sufijos_pasada_sigma_alto"] = max_sufijos_sigma_alto;
+    guardarResultadosBenchmark("externa", salida);
+
+    imprimir(VERDE "Externa (" << memoria_mb << " MB): " << ms_externa << " ms, pico +" << kb_externa - kb_inicial
+             << " KB; en memoria: " << ms_memoria << " ms, pico +" << kb_memoria - kb_inicial << " KB; índice "
+             << externo->getMemoriaBytes() / 1024 << " KB" RESET_COLOR);
+}
+
+// ========== Patrones preprocesados en textos cortos ==========
+
+/**
+ * @brief Largo de cada línea y del patrón del benchmark de líneas.
+ */
+static const size_t LARGO_LINEA_BENCHMARK = 100;
+static const size_t LARGO_PATRON_LINEAS = 6;
+
+/**
+ * @brief Mide buscar() contra el patrón preprocesado de un algoritmo sobre todas las líneas.
+ */
+template <typename Estatico, typename Compilado>
+static json medirLineas(const std::string& algoritmo, const std::vector<std::string>& lineas, const std::string& patron,
+                        Estatico buscar_estatico, const Compilado& compilado) {
+    std::vector<size_t> indices(lineas.size());
+    rep(i, lineas.size()) indices[i] = i;
+
+    size_t ocurrencias_estatico = 0, ocurrencias_compilado = 0;
+    double ns_estatico = medirNanosegundos(indices, [&](size_t i) { return buscar_estatico(lineas[i], patron); }, ocurrencias_estatico);
+    double ns_compilado = medirNanosegundos(indices, [&](size_t i) { return compilado.buscar(lineas[i]); }, ocurrencias_compilado);
+
+    if (ocurrencias_estatico != ocurrencias_compilado) {
+        throw std::runtime_error(algoritmo + " compilado contó " + std::to_string(ocurrencias_compilado)
+                                 + " ocurrencias y buscar() " + std::to_string(ocurrencias_estatico));
+    }
+
+    json resultado;
+    resultado["algoritmo"] = algoritmo;
+    resultado["ocurrencias"] = ocurrencias_compilado;
+    resultado["ns_por_linea_estatico"] = ns_estatico;
+    resultado["ns_por_linea_compilado"] = ns_compilado;
+    resultado["aceleracion"] = ns_estatico / ns_compilado;
+
+    imprimir(VERDE << algoritmo << ": " << ns_estatico << " ns/línea con buscar(), " << ns_compilado
+             << " ns/línea compilado (" << ns_estatico / ns_compilado << "x)" RESET_COLOR);
+    return resultado;
+}
+
+void ejecutarBenchmarkLineas(size_t cantidad_lineas) {
+    std::mt19937_64 generador(2025);
+    std::vector<std::string> lineas(cantidad_lineas);
+    for (auto& linea : lineas) linea = generarTextoAleatorio(generador, LARGO_LINEA_BENCHMARK);
+
+    // Patrón tomado de una línea para que haya ocurrencias
+    std::string patron = cantidad_lineas ? generarPatrones(generador, lineas[0], 1, LARGO_PATRON_LINEAS)[0]
+                                         : std::string(LARGO_PATRON_LINEAS, ALFABETO_BENCHMARK[0]);
+
+    json resultados = json::array();
+    resultados.push_back(medirLineas("BoyerMoore", lineas, patron, BoyerMoore::buscar, PatronBoyerMoore(patron)));
+    resultados.push_back(medirLineas("KnuthMorrisPratt", lineas, patron, KnuthMorrisPratt::buscar, PatronKnuthMorrisPratt(patron)));
+    resultados.push_back(medirLineas("KnuthMorrisPrattAutomata", lineas, patron, KnuthMorrisPratt::buscarAutomata,
+                                     PatronKnuthMorrisPratt(patron, false, true)));
+    resultados.push_back(medirLineas("RobinKarp", lineas, patron, RobinKarp::buscar, PatronRobinKarp(patron)));
+
+    json salida;
+    salida["cantidad_lineas"] = cantidad_lineas;
+    salida["largo_linea"] = LARGO_LINEA_BENCHMARK;
+    salida["largo_patron"] = patron.size();
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("lineas", salida);
+}
+
+// ========== Entradas adversarias ==========
+
+void ejecutarBenchmarkPeorCaso(size_t longitud_texto) {
+    const std::string texto(longitud_texto, 'a');
+
+    const std::vector<std::pair<std::string, unsigned int(*)(const std::string&, const std::string&)>> algoritmos = {
+        {"BoyerMoore",               BoyerMoore::buscar},
+        {"KnuthMorrisPratt",         KnuthMorrisPratt::buscar},
+        {"KnuthMorrisPrattAutomata", KnuthMorrisPratt::buscarAutomata},
+        {"RobinKarp",                RobinKarp::buscar},
+        {"TwoWay",                   TwoWay::buscar},
+    };
+
+    json resultados = json::array();
+    for (size_t largo : {10, 100, 1000}) {
+        const std::vector<std::pair<std::string, std::string>> patrones = {
+            {"a...ab", std::string(largo - 1, 'a') + "b"},
+            {"ba...a", "b" + std::string(largo - 1, 'a')},
+            {"a...a",  std::string(largo, 'a')},
+        };
+
+        for (const auto& patron : patrones) {
+            unsigned int esperado = KnuthMorrisPratt::buscar(texto, patron.second);
+
+            for (const auto& algoritmo : algoritmos) {
+                auto t_inicio = iniciarTimer();
+                unsigned int ocurrencias = algoritmo.second(texto, patron.second);
+                auto t_fin = detenerTimer();
+
+                if (ocurrencias != esperado) {
+                    throw std::runtime_error(algoritmo.first + " contó " + std::to_string(ocurrencias) + " ocurrencias de "
+                                             + patron.first + " y KnuthMorrisPratt " + std::to_string(esperado));
+                }
+
+                double ns_por_byte = calcularDuracion(t_inicio, t_fin).count() * 1e6 / static_cast<double>(std::max<size_t>(longitud_texto, 1));
+
+                json resultado;
+                resultado["algoritmo"] = algoritmo.first;
+                resultado["patron"] = patron.first;
+                resultado["largo_patron"] = largo;
+                resultado["ocurrencias"] = ocurrencias;
+                resultado["ns_por_byte"] = ns_por_byte;
+                resultados.push_back(resultado);
+
+                imprimir(VERDE << algoritmo.first << " con " << patron.first << " (m = " << largo << "): "
+                         << ns_por_byte << " ns/byte" RESET_COLOR);
+            }
+        }
+    }
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("peorcaso", salida);
+}
+
+// ========== Búsqueda aproximada ==========
+
+/**
+ * @brief Largos de los patrones del benchmark aproximado: uno y dos bloques de 64 bits.
+ */
+static const std::vector<size_t> LARGOS_PATRON_APROXIMADA = {16, 100};
+
+void ejecutarBenchmarkAproximada(const std::vector<std::string>& rutas, unsigned int maximo_ediciones) {
+    std::mt19937_64 generador(2025);
+    json resultados = json::array();
+
+    for (const auto& ruta : rutas) {
+        std::string texto = leerArchivo(ruta);
+        double megabytes = static_cast<double>(texto.size()) / 1e6;
+
+        for (size_t largo : LARGOS_PATRON_APROXIMADA) {
+            if (texto.size() < largo) continue;
+            std::uniform_int_distribution<size_t> distribucion(0, texto.size() - largo);
+            std::string patron = texto.substr(distribucion(generador), largo);
+
+            auto medir = [&](const std::string& algoritmo, unsigned int ediciones, auto buscar) {
+                auto t_inicio = iniciarTimer();
+                unsigned int ocurrencias = buscar();
+                auto t_fin = detenerTimer();
+                double mbs = megabytes / (calcularDuracion(t_inicio, t_fin).count() / 1e3);
+
+                json resultado;
+                resultado["archivo"] = fs::path(ruta).filename().string();
+                resultado["algoritmo"] = algoritmo;
+                resultado["largo_patron"] = largo;
+                resultado["ediciones"] = ediciones;
+                resultado["ocurrencias"] = ocurrencias;
+                resultado["mb_por_segundo"] = mbs;
+                resultados.push_back(resultado);
+
+                imprimir(VERDE << fs::path(ruta).filename().string() << " " << algoritmo << " (m = " << largo << ", k = "
+                         << ediciones << "): " << ocurrencias << " ocurrencias, " << mbs << " MB/s" RESET_COLOR);
+                return ocurrencias;
+            };
+
+            unsigned int exactas = medir("KnuthMorrisPratt", 0, [&] { return KnuthMorrisPratt::buscar(texto, patron); });
+            medir("BoyerMoore", 0, [&] { return BoyerMoore::buscar(texto, patron); });
+
+            for (unsigned int ediciones = 0; ediciones <= maximo_ediciones; ediciones++) {
+                PatronMyers myers(patron, ediciones);
+                unsigned int ocurrencias = medir("Myers", ediciones, [&] { return myers.buscar(texto); });
+                if (ediciones == 0 && ocurrencias != exactas) {
+                    throw std::runtime_error("Myers con k = 0 contó " + std::to_string(ocurrencias)
+                                             + " ocurrencias y la búsqueda exacta " + std::to_string(exactas));
+                }
+            }
+        }
+    }
+
+    json salida;
+    salida["maximo_ediciones"] = maximo_ediciones;
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("aproximada", salida);
+}
+
+// ========== Tabla de k-mers ==========
+
+/**
+ * @brief Largos k medidos (0 desactiva la tabla) y patrones consultados por archivo.
+ */
+static const std::vector<uint32_t> LARGOS_KMER_BENCHMARK = {0, 3, 4, 6, 8};
+static const size_t PATRONES_KMER = 100000;
+
+void ejecutarBenchmarkKmer(const std::vector<std::string>& rutas, size_t largo_patron) {
+    std::mt19937_64 generador(2025);
+    json resultados = json::array();
+
+    for (const auto& ruta : rutas) {
+        std::string texto = leerArchivo(ruta);
+        if (texto.size() < largo_patron) continue;
+        std::string archivo = fs::path(ruta).filename().string();
+
+        // Todos los patrones salen del texto: uno aleatorio del alfabeto ACGT no sirve en texto real
+        std::uniform_int_distribution<size_t> distribucion(0, texto.size() - largo_patron);
+        std::vector<std::string> patrones(PATRONES_KMER);
+        for (auto& patron : patrones) patron = texto.substr(distribucion(generador), largo_patron);
+
+        std::vector<unsigned int> conteos_sin_tabla;
+        double ns_sin_tabla = 0;
+
+        for (uint32_t largo_kmer : LARGOS_KMER_BENCHMARK) {
+            OpcionesFMIndex opciones;
+            opciones.largo_kmer = largo_kmer;
+            FMIndex indice(texto, opciones);
+
+            auto t_inicio = iniciarTimer();
+            std::vector<unsigned int> conteos(patrones.size());
+            rep(k, patrones.size()) conteos[k] = indice.buscar(patrones[k]);
+            auto t_fin = detenerTimer();
+            double ns = calcularDuracion(t_inicio, t_fin).count() * 1e6 / static_cast<double>(patrones.size());
+
+            if (largo_kmer == 0) {
+                conteos_sin_tabla = conteos;
+                ns_sin_tabla = ns;
+            } else if (conteos != conteos_sin_tabla) {
+                throw std::runtime_error("La tabla de " + std::to_string(largo_kmer) + "-mers cambió los conteos en " + archivo);
+            }
+
+            json resultado;
+            resultado["archivo"] = archivo;
+            resultado["longitud_texto"] = texto.size();
+            resultado["largo_kmer"] = largo_kmer;
+            resultado["largo_patron"] = largo_patron;
+            resultado["bytes_tabla_kmer"] = indice.getMemoriaTablaKmerBytes();
+            resultado["ns_por_patron"] = ns;
+            resultado["aceleracion"] = ns_sin_tabla / ns;
+            resultados.push_back(resultado);
+
+            imprimir(VERDE << archivo << " (k = " << largo_kmer << "): " << ns << " ns/patrón, tabla de "
+                     << indice.getMemoriaTablaKmerBytes() << " bytes" RESET_COLOR);
+        }
+    }
+
+    guardarResultadosBenchmark("kmer", resultados);
+}
+
+// ========== FM-Index bidireccional ==========
+
+/**
+ * @brief Patrones consultados en el índice y, de ellos, los que se verifican recorriendo el texto.
+ */
+static const size_t PATRONES_BIDIRECCIONAL = 100;
+static const size_t PATRONES_VERIFICADOS_BIDIRECCIONAL = 3;
+static const size_t LARGO_PATRON_BIDIRECCIONAL = 32;
+
+/**
+ * @brief Posiciones del texto donde el patrón aparece con a lo más k sustituciones.
+ */
+static size_t contarHamming(const std::string& texto, const std::string& patron, uint32_t maximo_errores) {
+    size_t ocurrencias = 0;
+    for (size_t i = 0; i + patron.size() <= texto.size(); ++i) {
+        uint32_t errores = 0;
+        for (size_t j = 0; j < patron.size() && errores <= maximo_errores; ++j) errores += texto[i + j] != patron[j];
+        if (errores <= maximo_errores) ocurrencias++;
+    }
+    return ocurrencias;
+}
+
+void ejecutarBenchmarkBidireccional(size_t longitud_texto, uint32_t maximo_errores) {
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_texto);
+    std::vector<std::string> patrones = generarPatrones(generador, texto, PATRONES_BIDIRECCIONAL, LARGO_PATRON_BIDIRECCIONAL);
+
+    auto t_inicio_construccion = iniciarTimer();
+    FMIndexBidireccional indice(texto);
+    auto t_fin_construccion = detenerTimer();
+    double ms_construccion = calcularDuracion(t_inicio_construccion, t_fin_construccion).count();
+    imprimir(VERDE "FMIndexBidireccional (" << longitud_texto << " caracteres): construcción " << ms_construccion << " ms, "
+             << indice.getMemoriaBytes() / 1e6 << " MB" RESET_COLOR);
+
+    // Myers sobre el texto invertido cuenta las posiciones de inicio, como el índice
+    std::string texto_invertido(texto.rbegin(), texto.rend());
+
+    const std::vector<std::pair<std::string, TipoError>> tipos = {
+        {"sustituciones", TipoError::Sustituciones}, {"ediciones", TipoError::Ediciones}
+    };
+
+    json resultados = json::array();
+    for (const auto& tipo : tipos) {
+        for (uint32_t errores = 0; errores <= maximo_errores; errores++) {
+            std::vector<size_t> conteos(patrones.size());
+            auto t_inicio = iniciarTimer();
+            rep(k, patrones.size()) conteos[k] = indice.buscarAproximado(patrones[k], errores, tipo.second);
+            auto t_fin = detenerTimer();
+            double ms_indice = calcularDuracion(t_inicio, t_fin).count() / static_cast<double>(patrones.size());
+
+            auto t_inicio_escaneo = iniciarTimer();
+            rep(k, PATRONES_VERIFICADOS_BIDIRECCIONAL) {
+                size_t esperado;
+                if (tipo.second == TipoError::Sustituciones) {
+                    esperado = contarHamming(texto, patrones[k], errores);
+                } else {
+                    PatronMyers myers(std::string(patrones[k].rbegin(), patrones[k].rend()), errores);
+                    esperado = myers.buscar(texto_invertido);
+                }
+                if (conteos[k] != esperado) {
+                    throw std::runtime_error("FMIndexBidireccional contó " + std::to_string(conteos[k]) + " ocurrencias con "
+                                             + std::to_string(errores) + " " + tipo.first + " y el escaneo " + std::to_string(esperado));
+                }
+            }
+            auto t_fin_escaneo = detenerTimer();
+            double ms_escaneo = calcularDuracion(t_inicio_escaneo, t_fin_escaneo).count() / static_cast<double>(PATRONES_VERIFICADOS_BIDIRECCIONAL);
+
+            size_t suma_ocurrencias = 0;
+            for (size_t conteo : conteos) suma_ocurrencias += conteo;
+
+            json resultado;
+            resultado["tipo_error"] = tipo.first;
+            resultado["errores"] = errores;
+            resultado["ocurrencias_totales"] = suma_ocurrencias;
+            resultado["ms_por_patron_indice"] = ms_indice;
+            resultado["ms_por_patron_escaneo"] = ms_escaneo;
+            resultado["aceleracion"] = ms_escaneo / ms_indice;
+            resultados.push_back(resultado);
+
+            imprimir(VERDE "k = " << errores << " " << tipo.first << ": índice " << ms_indice << " ms/patrón, escaneo "
+                     << ms_escaneo << " ms/patrón (" << suma_ocurrencias << " ocurrencias)" RESET_COLOR);
+        }
+    }
+
+    json salida;
+    salida["longitud_texto"] = longitud_texto;
+    salida["largo_patron"] = LARGO_PATRON_BIDIRECCIONAL;
+    salida["patrones"] = patrones.size();
+    salida["ms_construccion"] = ms_construccion;
+    salida["memoria_bytes"] = indice.getMemoriaBytes();
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("bidireccional", salida);
+}
+
+// ========== FM-Index incremental ==========
+
+/**
+ * @brief Patrones verificados contra el recorrido en cada punto de medición.
+ */
+static const size_t PATRONES_INCREMENTAL = 5;
+
+void ejecutarBenchmarkIncremental(size_t longitud_total, size_t tamano_bloque) {
+    if (tamano_bloque == 0) throw std::invalid_argument("El tamaño del bloque debe ser mayor que 0");
+
+    std::mt19937_64 generador(2025);
+    std::string texto = generarTextoAleatorio(generador, longitud_total);
+
+    FMIndexIncremental indice;
+    json resultados = json::array();
+    double ms_ingesta = 0;
+    size_t agregados = 0;
+    size_t siguiente_medicion = std::min(longitud_total, std::max(tamano_bloque, CAPACIDAD_DELTA_INCREMENTAL));
+
+    while (agregados < longitud_total) {
+        size_t largo = std::min(tamano_bloque, longitud_total - agregados);
+        auto t_inicio = iniciarTimer();
+        indice.agregar(std::string_view(texto).substr(agregados, largo));
+        agregados += largo;
+        if (agregados >= siguiente_medicion) indice.esperarFusiones();
+        auto t_fin = detenerTimer();
+        ms_ingesta += calcularDuracion(t_inicio, t_fin).count();
+
+        if (agregados < siguiente_medicion) continue;
+        siguiente_medicion = std::min(longitud_total, 2 * siguiente_medicion);
+
+        // Lo que costaría la alternativa sin segmentos: reconstruir el índice de todo el texto
+        std::string prefijo = texto.substr(0, agregados);
+        auto t_inicio_completo = iniciarTimer();
+        FMIndex completo(prefijo);
+        auto t_fin_completo = detenerTimer();
+        double ms_completo = calcularDuracion(t_inicio_completo, t_fin_completo).count();
+
+        for (const auto& patron : generarPatrones(generador, prefijo, PATRONES_INCREMENTAL, LARGO_PATRON_LOTE)) {
+            size_t esperado = KnuthMorrisPratt::buscarEnSegmento(prefijo, patron);
+            if (indice.buscar(patron) != esperado || completo.buscar(patron) != esperado) {
+                throw std::runtime_error("FMIndexIncremental contó " + std::to_string(indice.buscar(patron))
+                                         + " ocurrencias y el recorrido " + std::to_string(esperado));
+            }
+        }
+
+        double ns_por_byte = ms_ingesta * 1e6 / static_cast<double>(agregados);
+        double reconstruidos_por_byte = static_cast<double>(indice.getBytesReconstruidos()) / static_cast<double>(agregados);
+
+        json resultado;
+        resultado["longitud_texto"] = agregados;
+        resultado["ns_por_byte_ingesta"] = ns_por_byte;
+        resultado["bytes_reconstruidos_por_byte"] = reconstruidos_por_byte;
+        resultado["segmentos"] = indice.getCantidadSegmentos();
+        resultado["ms_ingesta_acumulada"] = ms_ingesta;
+        resultado["ms_reconstruccion_completa"] = ms_completo;
+        resultado["memoria_bytes"] = indice.getMemoriaBytes();
+        resultados.push_back(resultado);
+
+        imprimir(VERDE << agregados << " caracteres: " << ns_por_byte << " ns/byte, " << reconstruidos_por_byte
+                 << " reconstrucciones/byte, " << indice.getCantidadSegmentos() << " segmentos; reconstruir todo: "
+                 << ms_completo << " ms" RESET_COLOR);
+    }
+
+    json salida;
+    salida["longitud_total"] = longitud_total;
+    salida["tamano_bloque"] = tamano_bloque;
+    salida["capacidad_delta"] = CAPACIDAD_DELTA_INCREMENTAL;
+    salida["factor_fusion"] = FACTOR_FUSION_INCREMENTAL;
+    salida["resultados"] = resultados;
+    guardarResultadosBenchmark("incremental", salida);
+}
+
+// ========== Índice de documentos ==========
+
+void ejecutarBenchmarkDocumentos(const std::vector<std::string>& rutas, const std::string& patron, size_t k) {
+    std::vector<std::string> documentos;
+    for (const auto& ruta : rutas) documentos.push_back(leerArchivo(ruta));
+
+    auto t_inicio_construccion = iniciarTimer();
+    IndiceDocumentos indice(documentos);
+    auto t_fin_construccion = detenerTimer();
+    double ms_construccion = calcularDuracion(t_inicio_construccion, t_fin_construccion).count();
+
+    auto t_inicio_conteo = iniciarTimer();
+    std::vector<OcurrenciasDocumento> conteos = indice.contarPorDocumento(patron);
+    auto t_fin_conteo = detenerTimer();
+
+    auto t_inicio_listado = iniciarTimer();
+    std::vector<size_t> listado = indice.listarDocumentos(patron);
+    auto t_fin_listado = detenerTimer();
+
+    auto t_inicio_frecuentes = iniciarTimer();
+    std::vector<OcurrenciasDocumento> frecuentes = indice.documentosMasFrecuentes(patron, k);
+    auto t_fin_frecuentes = detenerTimer();
+
+    // Referencia: recorrer cada archivo con Knuth-Morris-Pratt
+    auto t_inicio_escaneo = iniciarTimer();
+    std::vector<OcurrenciasDocumento> esperados;
+    rep(d, documentos.size()) {
+        unsigned int ocurrencias = KnuthMorrisPratt::buscar(documentos[d], patron);
+        if (ocurrencias > 0) esperados.push_back({static_cast<size_t>(d), ocurrencias});
+    }
+    auto t_fin_escaneo = detenerTimer();
+
+    bool coinciden = conteos.size() == esperados.size() && listado.size() == esperados.size();
+    for (size_t i = 0; coinciden && i < conteos.size(); ++i) {
+        coinciden = conteos[i].documento == esperados[i].documento && conteos[i].ocurrencias == esperados[i].ocurrencias
+                    && listado[i] == esperados[i].documento;
+    }
+    if (!coinciden) throw std::runtime_error("IndiceDocumentos difiere de recorrer los archivos para el patrón " + patron);
+
+    json documentos_frecuentes = json::array();
+    for (const auto& frecuente : frecuentes) {
+        json entrada;
+        entrada["archivo"] = fs::path(rutas[frecuente.documento]).filename().string();
+        entrada["ocurrencias"] = frecuente.ocurrencias;
+        documentos_frecuentes.push_back(entrada);
+
+        imprimir(VERDE << fs::path(rutas[frecuente.documento]).filename().string() << ": " << frecuente.ocurrencias
+                 << " ocurrencias" RESET_COLOR);
+    }
+
+    double ms_conteo = calcularDuracion(t_inicio_conteo, t_fin_conteo).count();
+    double ms_listado = calcularDuracion(t_inicio_listado, t_fin_listado).count();
+    double ms_frecuentes = calcularDuracion(t_inicio_frecuentes, t_fin_frecuentes).count();
+    double ms_escaneo = calcularDuracion(t_inicio_escaneo, t_fin_escaneo).count();
+    imprimir(VERDE "IndiceDocumentos (" << documentos.size() << " documentos): construcción " << ms_construccion
+             << " ms; conteo por documento " << ms_conteo << " ms, listado " << ms_listado << " ms, top-" << k << " "
+             << ms_frecuentes << " ms; recorrer los archivos " << ms_escaneo << " ms" RESET_COLOR);
+
+    json salida;
+    salida["patron"] = patron;
+    salida["documentos"] = documentos.size();
+    salida["documentos_con_patron"] = listado.size();
+    salida["ms_construccion"] = ms_construccion;
+    salida["memoria_bytes"] = indice.getMemoriaBytes();
+    salida["ms_conteo_por_documento"] = ms_conteo;
+    salida["ms_listado"] = ms_listado;
+    salida["ms_mas_frecuentes"] = ms_frecuentes;
+    salida["ms_escaneo"] = ms_escaneo;
+    salida["mas_frecuentes"] = documentos_frecuentes;
+    guardarResultadosBenchmark("documentos", salida);
+}
@@ -0,0 +1,156 @@
+#include "../include/definiciones.hpp"
+#include "../include/bit_vector.hpp"
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+static const size_t PALABRAS_POR_BLOQUE = BITS_POR_BLOQUE_RANGO / 64;
+
+/**
+ * @brief Posición del uno número k + 1 (k desde 0) dentro de una palabra.
+ */
+static size_t seleccionarEnPalabra(uint64_t palabra, uint64_t k) {
+#ifdef __BMI2__
+    return static_cast<size_t>(__builtin_ctzll(_pdep_u64(1ULL << k, palabra)));
+#else
+    size_t desplazamiento = 0;
+    for (;;) {
+        uint64_t unos_byte = static_cast<uint64_t>(__builtin_popcountll(palabra & 0xFF));
+        if (k < unos_byte) break;
+        k -= unos_byte;
+        palabra >>= 8;
+        desplazamiento += 8;
+    }
+    for (;; palabra >>= 1, ++desplazamiento) {
+        if ((palabra & 1ULL) && k-- == 0) return desplazamiento;
+    }
+#endif
+}
+
+/**
+ * @brief Cantidad de muestras de selección para un total de unos (o ceros), sin el centinela.
+ */
+static size_t cantidadMuestras(size_t total) {
+    return (total + MUESTREO_SELECCION - 1) / MUESTREO_SELECCION;
+}
+
+BitVector::BitVector(VectorAlineado<uint64_t> palabras, size_t cantidad_bits) : cantidad_bits_(cantidad_bits) {
+    // Siempre queda un superbloque para la posición n, aunque n sea múltiplo de BITS_POR_BLOQUE_RANGO
+    size_t cantidad_bloques = cantidad_bits / BITS_POR_BLOQUE_RANGO + 1;
+    palabras.resize(cantidad_bloques * PALABRAS_POR_BLOQUE, 0);
+
+    // Limpiar los bits sobrantes desde la posición n
+    size_t ultima = cantidad_bits / 64;
+    palabras[ultima] &= (1ULL << (cantidad_bits % 64)) - 1;
+    std::fill(palabras.begin() + static_cast<std::ptrdiff_t>(ultima + 1), palabras.end(), 0);
+
+    VectorAlineado<uint64_t> directorio(2 * cantidad_bloques, 0);
+    std::vector<uint64_t> muestras_unos, muestras_ceros;
+    uint64_t unos = 0;
+
+    for (size_t bloque = 0; bloque < cantidad_bloques; ++bloque) {
+        directorio[2 * bloque] = unos;
+
+        uint64_t relativos = 0, en_bloque = 0;
+        for (size_t j = 0; j < PALABRAS_POR_BLOQUE; ++j) {
+            if (j > 0) relativos |= en_bloque << ((j - 1) * 9);
+            en_bloque += static_cast<uint64_t>(__builtin_popcountll(palabras[bloque * PALABRAS_POR_BLOQUE + j]));
+        }
+        directorio[2 * bloque + 1] = relativos;
+        unos += en_bloque;
+
+        // Una muestra por cada uno (o cero) número k·MUESTREO_SELECCION + 1 que cae en este bloque
+        uint64_t fin_bloque = std::min<uint64_t>((bloque + 1) * BITS_POR_BLOQUE_RANGO, cantidad_bits);
+        uint64_t ceros = fin_bloque - unos;
+        while (muestras_unos.size() * MUESTREO_SELECCION < unos) muestras_unos.push_back(bloque);
+        while (muestras_ceros.size() * MUESTREO_SELECCION < ceros) muestras_ceros.push_back(bloque);
+    }
+    muestras_unos.push_back(cantidad_bloques - 1);
+    muestras_ceros.push_back(cantidad_bloques - 1);
+
+    cantidad_unos_ = static_cast<size_t>(unos);
+    palabras_ = ArregloPlano<uint64_t>(std::move(palabras));
+    directorio_ = ArregloPlano<uint64_t>(std::move(directorio));
+    muestras_unos_ = ArregloPlano<uint64_t>(muestras_unos);
+    muestras_ceros_ = ArregloPlano<uint64_t>(muestras_ceros);
+}
+
+size_t BitVector::seleccionar1(size_t k) const {
+    if (k == 0 || k > cantidad_unos_) throw std::out_of_range("seleccionar1: k fuera de rango");
+
+    // Último superbloque entre las dos muestras con menos de k unos antes de él
+    size_t muestra = (k - 1) / MUESTREO_SELECCION;
+    size_t izquierda = muestras_unos_[muestra];
+    size_t derecha = muestras_unos_[muestra + 1];
+    while (izquierda < derecha) {
+        size_t medio = izquierda + (derecha - izquierda + 1) / 2;
+        if (directorio_[2 * medio] < k) izquierda = medio;
+        else derecha = medio - 1;
+    }
+
+    size_t bloque = izquierda;
+    uint64_t resto = k - directorio_[2 * bloque];
+    size_t j = PALABRAS_POR_BLOQUE - 1;
+    while (unosRelativos(bloque, j) >= resto) --j;
+
+    resto -= unosRelativos(bloque, j);
+    return bloque * BITS_POR_BLOQUE_RANGO + j * 64
+         + seleccionarEnPalabra(palabras_[bloque * PALABRAS_POR_BLOQUE + j], resto - 1);
+}
+
+size_t BitVector::seleccionar0(size_t k) const {
+    if (k == 0 || k > contarCeros()) throw std::out_of_range("seleccionar0: k fuera de rango");
+
+    size_t muestra = (k - 1) / MUESTREO_SELECCION;
+    size_t izquierda = muestras_ceros_[muestra];
+    size_t derecha = muestras_ceros_[muestra + 1];
+    while (izquierda < derecha) {
+        size_t medio = izquierda + (derecha - izquierda + 1) / 2;
+        if (cerosAntesDeBloque(medio) < k) izquierda = medio;
+        else derecha = medio - 1;
+    }
+
+    size_t bloque = izquierda;
+    uint64_t resto = k - cerosAntesDeBloque(bloque);
+    size_t j = PALABRAS_POR_BLOQUE - 1;
+    while (j * 64 - unosRelativos(bloque, j) >= resto) --j;
+
+    resto -= j * 64 - unosRelativos(bloque, j);
+    return bloque * BITS_POR_BLOQUE_RANGO + j * 64
+         + seleccionarEnPalabra(~palabras_[bloque * PALABRAS_POR_BLOQUE + j], resto - 1);
+}
+
+size_t BitVector::getMemoriaBytes() const {
+    return palabras_.getMemoriaBytes() + directorio_.getMemoriaBytes()
+         + muestras_unos_.getMemoriaBytes() + muestras_ceros_.getMemoriaBytes();
+}
+
+void BitVector::serializar(EscritorBinario& escritor) const {
+    escritor.escribir(static_cast<uint64_t>(cantidad_bits_));
+    escritor.escribir(static_cast<uint64_t>(cantidad_unos_));
+    escritor.escribirArreglo(palabras_);
+    escritor.escribirArreglo(directorio_);
+    escritor.escribirArreglo(muestras_unos_);
+    escritor.escribirArreglo(muestras_ceros_);
+}
+
+void BitVector::mapear(LectorMapeado& lector) {
+    uint64_t cantidad_bits = lector.leer<uint64_t>();
+    uint64_t cantidad_unos = lector.leer<uint64_t>();
+    lector.mapearArreglo(palabras_);
+    lector.mapearArreglo(directorio_);
+    lector.mapearArreglo(muestras_unos_);
+    lector.mapearArreglo(muestras_ceros_);
+
+    uint64_t cantidad_bloques = cantidad_bits / BITS_POR_BLOQUE_RANGO + 1;
+    if (cantidad_unos > cantidad_bits
+        || palabras_.size() != cantidad_bloques * PALABRAS_POR_BLOQUE
+        || directorio_.size() != 2 * cantidad_bloques
+        || muestras_unos_.size() != cantidadMuestras(cantidad_unos) + 1
+        || muestras_ceros_.size() != cantidadMuestras(cantidad_bits - cantidad_unos) + 1) {
+        throw std::runtime_error("Archivo de índice corrupto: vector de bits inconsistente");
+    }
+    cantidad_bits_ = static_cast<size_t>(cantidad_bits);
+    cantidad_unos_ = static_cast<size_t>(cantidad_unos);
+}
@@ -1,41 +1,69 @@
 #include "../include/definiciones.hpp"
 #include "../include/boyer_moore.hpp"
+#include "../include/contadores.hpp"
 
 unsigned int BoyerMoore::buscar(const std::string& texto, const std::string& patron) {
-    int tamanio_patron = patron.length(), tamanio_texto = texto.length();
+    return PatronBoyerMoore(patron).buscar(texto);
+}
+
+unsigned int BoyerMoore::buscarSinMayusculas(const std::string& texto, const std::string& patron) {
+    return PatronBoyerMoore(patron, true).buscar(texto);
+}
+
+unsigned int BoyerMoore::buscarEnSegmento(std::string_view segmento, const std::string& patron) {
+    return PatronBoyerMoore(patron).buscar(segmento);
+}
+
+PatronBoyerMoore::PatronBoyerMoore(const std::string& patron, bool ignorar_mayusculas)
+    : patron_(ignorar_mayusculas ? plegarCaso(patron) : patron), ignorar_mayusculas_(ignorar_mayusculas) {
+    ultima_.fill(-1);
+    rep(j, patron_.size()) ultima_[static_cast<unsigned char>(patron_[j])] = j;
+}
+
+unsigned int PatronBoyerMoore::buscar(std::string_view texto) const {
+    return ignorar_mayusculas_ ? buscarCon(texto, PlegadoMinusculas()) : buscarCon(texto, SinPlegado());
+}
+
+template<typename Plegado>
+unsigned int PatronBoyerMoore::buscarCon(std::string_view texto, Plegado plegar) const {
+    size_t tamanio_patron = patron_.length(), tamanio_texto = texto.length();
     
     // Contador de aciertos
     unsigned int aciertos = 0;
 
     // Si no tiene largo el patron o el texto
-    if(!tamanio_patron || !tamanio_texto) return 0;
+    if(!tamanio_patron || tamanio_texto < tamanio_patron) return 0;
+
+    auto caracterTexto = [&](size_t posicion) { return plegar(static_cast<unsigned char>(texto[posicion])); };
     
-    int desplazamiento = 0;
+    size_t desplazamiento = 0;
     
     while(desplazamiento <= tamanio_texto - tamanio_patron){
         // Ultimo elemento del patron
-        int i = tamanio_patron - 1;
+        long long i = static_cast<long long>(tamanio_patron) - 1;
         
         // Si hay coincidencias, avanza al revés
-        while(i >= 0 && patron[i] == texto[desplazamiento + i]){
+        while(i >= 0 && static_cast<unsigned char>(patron_[i]) == caracterTexto(desplazamiento + i)){
             i--;
         }
+        // Los m - 1 - i caracteres que coincidieron, más el que discrepó si lo hubo
+        CONTAR_MOTOR(comparaciones_boyer_moore, static_cast<long long>(tamanio_patron) - 1 - i + (i >= 0 ? 1 : 0));
 
-        // Ahora comparamos si i llego a 0, entonces encontró el patron
-        if(i < 0) aciertos++, desplazamiento += tamanio_patron;
-        
+        if(i < 0) {
+            // Ocurrencia: se alinea el byte siguiente a la ventana para no saltar ocurrencias solapadas
+            aciertos++;
+            size_t siguiente = desplazamiento + tamanio_patron;
+            long long salto = (siguiente < tamanio_texto) ? static_cast<long long>(tamanio_patron) - ultima_[caracterTexto(siguiente)] : 1;
+            desplazamiento += static_cast<size_t>(salto);
+            CONTAR_MOTOR(desplazamientos_boyer_moore, 1);
+            CONTAR_MOTOR(caracteres_desplazados_boyer_moore, salto);
+        }
         else {
-            // Pillar similitudes menores
-            int aux = tamanio_patron - 1;
-            
-            // Se compara desde la similitud, ahi comparamos los elementos
-            while(aux >= 0 && texto[desplazamiento + i] != patron[aux]) aux--;
-            
-            // Tomar los cambios
-            if(aux < 0) desplazamiento += tamanio_patron;
-
-            // Avanzamos un poco hasta que encage con el patron
-            else desplazamiento += std::max(1, i - aux);
+            // Alinea el byte discrepante con su última aparición en el patrón
+            long long salto = std::max(1LL, i - ultima_[caracterTexto(desplazamiento + i)]);
+            desplazamiento += static_cast<size_t>(salto);
+            CONTAR_MOTOR(desplazamientos_boyer_moore, 1);
+            CONTAR_MOTOR(caracteres_desplazados_boyer_moore, salto);
         }
     }
     return aciertos;
@@ -0,0 +1,141 @@
+#include "../include/definiciones.hpp"
+#include "../include/busqueda_flujo.hpp"
+#include "../include/knuth_morris_pratt.hpp"
+
+#include <stdexcept>
+
+/**
+ * @brief Base y módulo del hash de BuscadorFlujoRobinKarp.
+ * 
+ * Con un módulo primo cercano a 2^31 las colisiones (y las verificaciones
+ * inútiles) son muy raras, y BASE·hash + byte no desborda 64 bits.
+ */
+static const uint64_t BASE_HASH_FLUJO = 256;
+static const uint64_t MODULO_HASH_FLUJO = 2147483647;
+
+// ========== KMP ==========
+
+BuscadorFlujoKMP::BuscadorFlujoKMP(const std::string& patron) : patron_(patron) {
+    if (patron.empty()) throw std::invalid_argument("El patrón de búsqueda no puede estar vacío");
+    tabla_de_saltos_ = KnuthMorrisPratt::calcularTablaDeSaltos(patron_);
+}
+
+void BuscadorFlujoKMP::procesar(std::string_view bloque) {
+    for (char caracter : bloque) {
+        while (posicion_patron_ > 0 && caracter != patron_[posicion_patron_]) {
+            posicion_patron_ = tabla_de_saltos_[posicion_patron_ - 1];
+        }
+
+        if (caracter == patron_[posicion_patron_]) posicion_patron_++;
+
+        if (posicion_patron_ == patron_.size()) {
+            ocurrencias_++;
+            posicion_patron_ = tabla_de_saltos_[posicion_patron_ - 1];
+        }
+    }
+    bytes_procesados_ += bloque.size();
+}
+
+void BuscadorFlujoKMP::reiniciar() {
+    posicion_patron_ = 0;
+    ocurrencias_ = 0;
+    bytes_procesados_ = 0;
+}
+
+// ========== Shift-And ==========
+
+BuscadorFlujoShiftAnd::BuscadorFlujoShiftAnd(const std::string& patron) {
+    if (patron.empty()) throw std::invalid_argument("El patrón de búsqueda no puede estar vacío");
+    if (patron.size() > 64) throw std::invalid_argument("Shift-And admite patrones de a lo más 64 bytes");
+
+    rep(j, patron.size()) mascaras_[static_cast<unsigned char>(patron[j])] |= 1ULL << j;
+    bit_final_ = 1ULL << (patron.size() - 1);
+}
+
+void BuscadorFlujoShiftAnd::procesar(std::string_view bloque) {
+    uint64_t estado = estado_;
+    uint64_t ocurrencias = 0;
+    for (char caracter : bloque) {
+        estado = ((estado << 1) | 1ULL) & mascaras_[static_cast<unsigned char>(caracter)];
+        ocurrencias += (estado & bit_final_) != 0;
+    }
+    estado_ = estado;
+    ocurrencias_ += ocurrencias;
+    bytes_procesados_ += bloque.size();
+}
+
+void BuscadorFlujoShiftAnd::reiniciar() {
+    estado_ = 0;
+    ocurrencias_ = 0;
+    bytes_procesados_ = 0;
+}
+
+// ========== Robin-Karp ==========
+
+BuscadorFlujoRobinKarp::BuscadorFlujoRobinKarp(const std::string& patron) : patron_(patron) {
+    if (patron.empty()) throw std::invalid_argument("El patrón de búsqueda no puede estar vacío");
+
+    rep(i, patron_.size() - 1) factor_potencia_ = (factor_potencia_ * BASE_HASH_FLUJO) % MODULO_HASH_FLUJO;
+    for (char caracter : patron_) {
+        hash_patron_ = (BASE_HASH_FLUJO * hash_patron_ + static_cast<unsigned char>(caracter)) % MODULO_HASH_FLUJO;
+    }
+    ventana_.reserve(patron_.size());
+}
+
+bool BuscadorFlujoRobinKarp::ventanaCoincide() const {
+    size_t largo = patron_.size();
+    rep(j, largo) {
+        if (ventana_[(inicio_ventana_ + static_cast<size_t>(j)) % largo] != patron_[j]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Mientras la ventana tiene menos de m bytes solo se acumula el hash;
+ *        después cada byte reemplaza al más antiguo del búfer circular.
+ */
+void BuscadorFlujoRobinKarp::procesar(std::string_view bloque) {
+    size_t largo = patron_.size();
+    for (char caracter : bloque) {
+        uint64_t entrante = static_cast<unsigned char>(caracter);
+
+        if (ventana_.size() < largo) {
+            ventana_.push_back(caracter);
+            hash_ventana_ = (BASE_HASH_FLUJO * hash_ventana_ + entrante) % MODULO_HASH_FLUJO;
+        } else {
+            uint64_t saliente = static_cast<unsigned char>(ventana_[inicio_ventana_]);
+            uint64_t sin_saliente = (hash_ventana_ + MODULO_HASH_FLUJO - (saliente * factor_potencia_) % MODULO_HASH_FLUJO) % MODULO_HASH_FLUJO;
+            hash_ventana_ = (BASE_HASH_FLUJO * sin_saliente + entrante) % MODULO_HASH_FLUJO;
+
+            ventana_[inicio_ventana_] = caracter;
+            inicio_ventana_ = (inicio_ventana_ + 1) % largo;
+        }
+
+        if (ventana_.size() == largo && hash_ventana_ == hash_patron_ && ventanaCoincide()) ocurrencias_++;
+    }
+    bytes_procesados_ += bloque.size();
+}
+
+void BuscadorFlujoRobinKarp::reiniciar() {
+    hash_ventana_ = 0;
+    ventana_.clear();
+    inicio_ventana_ = 0;
+    ocurrencias_ = 0;
+    bytes_procesados_ = 0;
+}
+
+// ========== Lectura por bloques ==========
+
+uint64_t contarEnFlujo(std::istream& entrada, BuscadorFlujo& buscador, size_t tamano_bloque) {
+    if (tamano_bloque == 0) throw std::invalid_argument("El tamaño de bloque debe ser mayor que 0");
+
+    std::vector<char> bufer(tamano_bloque);
+    while (entrada) {
+        entrada.read(bufer.data(), static_cast<std::streamsize>(bufer.size()));
+        std::streamsize leidos = entrada.gcount();
+        if (leidos > 0) buscador.procesar(std::string_view(bufer.data(), static_cast<size_t>(leidos)));
+    }
+
+    if (entrada.bad()) throw std::ios_base::failure("Error leyendo la entrada");
+    return buscador.getOcurrencias();
+}
@@ -0,0 +1,174 @@
+#include "../include/definiciones.hpp"
+#include "../include/busqueda_paralela.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+PoolTrabajo::PoolTrabajo(size_t hilos) {
+    if (hilos == 0) hilos = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    rep(i, hilos) colas_.push_back(std::make_unique<Cola>());
+    rep(i, hilos) hilos_.emplace_back(&PoolTrabajo::trabajar, this, static_cast<size_t>(i));
+}
+
+PoolTrabajo::~PoolTrabajo() {
+    {
+        std::lock_guard<std::mutex> lock(candado_);
+        detener_ = true;
+    }
+    hay_tareas_.notify_all();
+    for (auto& hilo : hilos_) hilo.join();
+}
+
+void PoolTrabajo::ejecutar(std::vector<std::function<void()>> tareas) {
+    if (tareas.empty()) return;
+
+    Lote lote;
+    lote.pendientes = tareas.size();
+
+    // Las colas se llenan con candado_ tomado para que ningún hilo tome una tarea antes de contarla
+    {
+        std::lock_guard<std::mutex> lock(candado_);
+        rep(k, tareas.size()) {
+            Cola& cola = *colas_[k % colas_.size()];
+            std::lock_guard<std::mutex> lock_cola(cola.candado);
+            cola.tareas.push_back(Tarea{std::move(tareas[k]), &lote});
+        }
+        sin_tomar_ += tareas.size();
+    }
+    hay_tareas_.notify_all();
+
+    auto loteTerminado = [&lote]() {
+        std::lock_guard<std::mutex> lock(lote.candado);
+        return lote.pendientes == 0;
+    };
+
+    Tarea tarea;
+    while (!loteTerminado() && tomarTarea(colas_.size(), tarea)) {
+        {
+            std::lock_guard<std::mutex> lock(candado_);
+            sin_tomar_--;
+        }
+        ejecutarTarea(tarea);
+    }
+
+    std::unique_lock<std::mutex> lock(lote.candado);
+    lote.terminado.wait(lock, [&lote]() { return lote.pendientes == 0; });
+    if (lote.error) std::rethrow_exception(lote.error);
+}
+
+/**
+ * @brief La cola propia se consume desde el final (tareas recién repartidas,
+ *        aún en caché) y las ajenas desde el inicio, lejos de su dueño.
+ */
+bool PoolTrabajo::tomarTarea(size_t hilo, Tarea& tarea) {
+    rep(desplazamiento, colas_.size()) {
+        size_t indice = (hilo + static_cast<size_t>(desplazamiento)) % colas_.size();
+        Cola& cola = *colas_[indice];
+        std::lock_guard<std::mutex> lock(cola.candado);
+        if (cola.tareas.empty()) continue;
+
+        if (indice == hilo) {
+            tarea = std::move(cola.tareas.back());
+            cola.tareas.pop_back();
+        } else {
+            tarea = std::move(cola.tareas.front());
+            cola.tareas.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+void PoolTrabajo::ejecutarTarea(Tarea& tarea) {
+    std::exception_ptr error;
+    try {
+        tarea.funcion();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    tarea.funcion = nullptr;
+
+    // Se notifica con el candado tomado: al soltarlo, ejecutar() puede retornar y destruir el lote
+    Lote& lote = *tarea.lote;
+    std::lock_guard<std::mutex> lock(lote.candado);
+    if (error && !lote.error) lote.error = error;
+    if (--lote.pendientes == 0) lote.terminado.notify_all();
+}
+
+void PoolTrabajo::trabajar(size_t hilo) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(candado_);
+            hay_tareas_.wait(lock, [this]() { return detener_ || sin_tomar_ > 0; });
+            if (detener_) return;
+        }
+
+        Tarea tarea;
+        while (tomarTarea(hilo, tarea)) {
+            {
+                std::lock_guard<std::mutex> lock(candado_);
+                sin_tomar_--;
+            }
+            ejecutarTarea(tarea);
+        }
+    }
+}
+
+PoolTrabajo& poolCompartido() {
+    static PoolTrabajo pool;
+    return pool;
+}
+
+PoolTrabajo* poolParaHilos(size_t hilos, std::unique_ptr<PoolTrabajo>& propio) {
+    if (hilos == 0) return &poolCompartido();
+    if (hilos == 1) return nullptr;
+    propio = std::make_unique<PoolTrabajo>(hilos);
+    return propio.get();
+}
+
+size_t cantidadTramos(size_t n, const PoolTrabajo* pool) {
+    if (pool == nullptr) return 1;
+    size_t tramos = std::min(4 * pool->getCantidadHilos(), n / TAMANO_MINIMO_TRAMO);
+    return std::max<size_t>(tramos, 1);
+}
+
+void paraCadaTramo(size_t n, size_t tramos, PoolTrabajo* pool,
+                   const std::function<void(size_t tramo, size_t inicio, size_t fin)>& cuerpo) {
+    if (pool == nullptr || tramos == 1) {
+        rep(k, tramos) cuerpo(k, k * n / tramos, (k + 1) * n / tramos);
+        return;
+    }
+
+    std::vector<std::function<void()>> tareas;
+    tareas.reserve(tramos);
+    rep(k, tramos) {
+        tareas.emplace_back([&, k]() { cuerpo(k, k * n / tramos, (k + 1) * n / tramos); });
+    }
+    pool->ejecutar(std::move(tareas));
+}
+
+uint64_t contarParalelo(MotorSegmento motor, std::string_view texto, const std::string& patron,
+                        PoolTrabajo& pool, size_t tamano_segmento) {
+    if (tamano_segmento == 0) throw std::invalid_argument("El tamaño de segmento debe ser mayor que 0");
+    if (patron.empty() || texto.size() < patron.size()) return 0;
+
+    size_t posiciones_inicio = texto.size() - patron.size() + 1;
+    size_t cantidad_segmentos = (posiciones_inicio + tamano_segmento - 1) / tamano_segmento;
+
+    std::vector<uint64_t> conteos(cantidad_segmentos, 0);
+    std::vector<std::function<void()>> tareas;
+    tareas.reserve(cantidad_segmentos);
+    rep(k, cantidad_segmentos) {
+        tareas.emplace_back([&, k]() {
+            size_t inicio = static_cast<size_t>(k) * tamano_segmento;
+            size_t largo = std::min(tamano_segmento + patron.size() - 1, texto.size() - inicio);
+            conteos[k] = motor(texto.substr(inicio, largo), patron);
+        });
+    }
+    pool.ejecutar(std::move(tareas));
+
+    uint64_t total = 0;
+    for (uint64_t conteo : conteos) total += conteo;
+    return total;
+}
@@ -0,0 +1,117 @@
+#include "../include/definiciones.hpp"
+#include "../include/cache_consultas.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+CacheConsultas::CacheConsultas(std::unique_ptr<BaseStructure> estructura, const OpcionesCache& opciones)
+    : estructura_(std::move(estructura)), ttl_(opciones.ttl) {
+    if (!estructura_) throw std::invalid_argument("CacheConsultas requiere una estructura");
+    if (opciones.capacidad == 0) throw std::invalid_argument("La capacidad de la caché debe ser mayor que 0");
+    if (opciones.fragmentos == 0) throw std::invalid_argument("La caché debe tener al menos un fragmento");
+
+    // Con pocas entradas no tiene sentido tener más fragmentos que entradas
+    cantidad_fragmentos_ = std::min(opciones.fragmentos, opciones.capacidad);
+    fragmentos_ = std::make_unique<Fragmento[]>(cantidad_fragmentos_);
+    rep(i, cantidad_fragmentos_) {
+        fragmentos_[i].capacidad = opciones.capacidad / cantidad_fragmentos_
+                                 + (static_cast<size_t>(i) < opciones.capacidad % cantidad_fragmentos_ ? 1 : 0);
+    }
+}
+
+CacheConsultas::Fragmento& CacheConsultas::fragmentoDe(const std::string& patron) const {
+    return fragmentos_[std::hash<std::string>()(patron) % cantidad_fragmentos_];
+}
+
+size_t CacheConsultas::bytesEntrada(const std::string& patron) {
+    // Nodo de la lista con la entrada, nodo de la tabla con la clave y un puntero de cubeta
+    return sizeof(Entrada) + 2 * sizeof(void*)
+         + sizeof(std::string) + sizeof(std::list<Entrada>::iterator) + 2 * sizeof(void*)
+         + 2 * patron.size();
+}
+
+/**
+ * @brief Busca en el fragmento con el candado tomado; ante un fallo busca
+ *        en la estructura sin candado y luego guarda el resultado.
+ */
+unsigned int CacheConsultas::buscar(const std::string& patron) const {
+    Fragmento& fragmento = fragmentoDe(patron);
+    auto ahora = Reloj::now();
+
+    {
+        std::lock_guard<std::mutex> lock(fragmento.candado);
+        auto posicion = fragmento.posiciones.find(patron);
+        if (posicion != fragmento.posiciones.end()) {
+            auto entrada = posicion->second;
+            if (ttl_.count() == 0 || ahora < entrada->vencimiento) {
+                fragmento.recientes.splice(fragmento.recientes.begin(), fragmento.recientes, entrada);
+                aciertos_.fetch_add(1, std::memory_order_relaxed);
+                return entrada->ocurrencias;
+            }
+            // Vencida: se descarta y se vuelve a buscar
+            fragmento.bytes -= bytesEntrada(patron);
+            fragmento.recientes.erase(entrada);
+            fragmento.posiciones.erase(posicion);
+        }
+    }
+
+    fallos_.fetch_add(1, std::memory_order_relaxed);
+    unsigned int ocurrencias = estructura_->buscar(patron);
+
+    std::lock_guard<std::mutex> lock(fragmento.candado);
+    auto posicion = fragmento.posiciones.find(patron);
+    if (posicion != fragmento.posiciones.end()) {
+        // Otro hilo la guardó mientras se buscaba
+        posicion->second->ocurrencias = ocurrencias;
+        posicion->second->vencimiento = ahora + ttl_;
+        fragmento.recientes.splice(fragmento.recientes.begin(), fragmento.recientes, posicion->second);
+        return ocurrencias;
+    }
+
+    if (fragmento.recientes.size() >= fragmento.capacidad) {
+        const Entrada& antigua = fragmento.recientes.back();
+        fragmento.bytes -= bytesEntrada(antigua.patron);
+        fragmento.posiciones.erase(antigua.patron);
+        fragmento.recientes.pop_back();
+    }
+
+    fragmento.recientes.push_front(Entrada{patron, ocurrencias, ahora + ttl_});
+    fragmento.posiciones.emplace(patron, fragmento.recientes.begin());
+    fragmento.bytes += bytesEntrada(patron);
+    return ocurrencias;
+}
+
+size_t CacheConsultas::getMemoriaBytes() const {
+    size_t bytes = estructura_->getMemoriaBytes() + cantidad_fragmentos_ * sizeof(Fragmento);
+    rep(i, cantidad_fragmentos_) {
+        std::lock_guard<std::mutex> lock(fragmentos_[i].candado);
+        bytes += fragmentos_[i].bytes + fragmentos_[i].posiciones.bucket_count() * sizeof(void*);
+    }
+    return bytes;
+}
+
+double CacheConsultas::getTasaAciertos() const {
+    size_t aciertos = getAciertos();
+    size_t total = aciertos + getFallos();
+    return total == 0 ? 0.0 : static_cast<double>(aciertos) / static_cast<double>(total);
+}
+
+size_t CacheConsultas::getCantidadEntradas() const {
+    size_t cantidad = 0;
+    rep(i, cantidad_fragmentos_) {
+        std::lock_guard<std::mutex> lock(fragmentos_[i].candado);
+        cantidad += fragmentos_[i].recientes.size();
+    }
+    return cantidad;
+}
+
+void CacheConsultas::limpiar() {
+    rep(i, cantidad_fragmentos_) {
+        std::lock_guard<std::mutex> lock(fragmentos_[i].candado);
+        fragmentos_[i].recientes.clear();
+        fragmentos_[i].posiciones.clear();
+        fragmentos_[i].bytes = 0;
+    }
+    aciertos_.store(0, std::memory_order_relaxed);
+    fallos_.store(0, std::memory_order_relaxed);
+}
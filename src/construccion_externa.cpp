@@ -0,0 +1,191 @@
+#include "../include/definiciones.hpp"
+#include "../include/construccion_externa.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @brief Bytes de la BWT que se acumulan antes de cada escritura al archivo.
+ */
+static const size_t BUFFER_BWT_EXTERNA = 1 << 20;
+
+// ========== Archivos temporales ==========
+
+ArchivoTemporal::ArchivoTemporal(const std::string& directorio, const std::string& prefijo) {
+    static std::atomic<uint64_t> siguiente{0};
+
+    std::filesystem::create_directories(directorio);
+    std::string nombre = prefijo + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())
+                       + "_" + std::to_string(siguiente++) + ".tmp";
+    ruta_ = (std::filesystem::path(directorio) / nombre).string();
+}
+
+ArchivoTemporal::~ArchivoTemporal() {
+    std::error_code error;
+    std::filesystem::remove(ruta_, error);
+}
+
+// ========== Ordenamiento por cubetas ==========
+
+TransformadaExterna construirTransformadaExterna(std::string_view texto, uint32_t paso_muestreo,
+                                                 const std::string& ruta_bwt, size_t memoria_bytes) {
+    if (texto.empty()) throw std::invalid_argument("La construcción externa necesita al menos un carácter");
+    if (texto.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("El texto excede el tamaño máximo de la construcción externa");
+    }
+    size_t longitud = texto.size();
+
+    // Código 1..σ de cada carácter presente; 0 completa los sufijos de menos de k caracteres
+    std::array<uint32_t, 256> codigos{};
+    for (char caracter : texto) codigos[static_cast<unsigned char>(caracter)] = 1;
+    uint32_t sigma = 0;
+    for (auto& codigo : codigos) {
+        if (codigo != 0) codigo = ++sigma;
+    }
+    uint32_t bits = 1;
+    while ((1u << bits) <= sigma) bits++;
+    uint32_t caracteres_cubeta = std::max<uint32_t>(BITS_CUBETAS_EXTERNAS / bits, 1);
+    uint32_t desplazamiento_primero = bits * (caracteres_cubeta - 1);
+
+    // Recorre los sufijos de atrás hacia adelante manteniendo la cubeta de cada uno
+    auto recorrerCubetas = [&](auto&& visitar) {
+        uint64_t cubeta = 0;
+        for (size_t i = longitud; i-- > 0;) {
+            cubeta = (static_cast<uint64_t>(codigos[static_cast<unsigned char>(texto[i])]) << desplazamiento_primero) | (cubeta >> bits);
+            visitar(i, cubeta);
+        }
+    };
+
+    // Cubeta de los k caracteres que comienzan en posicion (0 completa los que pasan del final)
+    auto cubetaEn = [&](size_t posicion) {
+        uint64_t cubeta = 0;
+        rep(j, caracteres_cubeta) {
+            size_t actual = posicion + static_cast<size_t>(j);
+            cubeta = (cubeta << bits) | (actual < longitud ? codigos[static_cast<unsigned char>(texto[actual])] : 0);
+        }
+        return cubeta;
+    };
+
+    // Recorre los sufijos que comienzan con las cubetas de prefijo (k caracteres cada una)
+    // junto con la cubeta siguiente, la del nivel prefijo.size()
+    auto recorrerNivel = [&](const std::vector<uint64_t>& prefijo, auto&& visitar) {
+        if (prefijo.empty()) {
+            recorrerCubetas(visitar);
+            return;
+        }
+        size_t nivel = prefijo.size();
+        recorrerCubetas([&](size_t i, uint64_t cubeta) {
+            if (cubeta != prefijo[0]) return;
+            for (size_t j = 1; j < nivel; ++j) {
+                if (cubetaEn(i + j * caracteres_cubeta) != prefijo[j]) return;
+            }
+            visitar(i, cubetaEn(i + nivel * caracteres_cubeta));
+        });
+    };
+
+    std::vector<uint32_t> conteos(size_t(1) << (bits * caracteres_cubeta), 0);
+    recorrerCubetas([&](size_t, uint64_t cubeta) { conteos[cubeta]++; });
+
+    // Los sufijos de una cubeta del nivel comparten sus primeros (nivel + 1)·k caracteres
+    // (o son el mismo si alguno es más corto). std::sort puede comparar un sufijo consigo
+    // mismo: los corridos se acotan al final del texto
+    auto menorSufijo = [&](size_t nivel) {
+        size_t comunes = (nivel + 1) * caracteres_cubeta;
+        return [&texto, longitud, comunes](uint64_t a, uint64_t b) {
+            if ((a >> 32) != (b >> 32)) return (a >> 32) < (b >> 32);
+            size_t sufijo_a = std::min<size_t>(static_cast<uint32_t>(a) + comunes, longitud);
+            size_t sufijo_b = std::min<size_t>(static_cast<uint32_t>(b) + comunes, longitud);
+            size_t largo = longitud - std::max(sufijo_a, sufijo_b);
+            int comparacion = std::memcmp(texto.data() + sufijo_a, texto.data() + sufijo_b, largo);
+            if (comparacion != 0) return comparacion < 0;
+            return sufijo_a > sufijo_b;     // Uno es prefijo del otro: el más corto va primero
+        };
+    };
+
+    std::ofstream salida(ruta_bwt, std::ios::binary | std::ios::trunc);
+    if (!salida) throw std::runtime_error("No se pudo abrir el archivo temporal de la BWT: " + ruta_bwt);
+
+    TransformadaExterna transformada;
+    transformada.longitud = longitud;
+    transformada.marcas.assign((longitud + 1) / 64 + 1, 0);
+    transformada.muestras_inverso.assign(longitud / paso_muestreo + 1, 0);
+
+    std::string buffer;
+    buffer.reserve(BUFFER_BWT_EXTERNA);
+    size_t fila = 0;
+    auto emitirFila = [&](size_t posicion) {
+        if (posicion == 0) transformada.fila_centinela = fila;
+        else buffer.push_back(texto[posicion - 1]);
+
+        if (posicion % paso_muestreo == 0) {
+            transformada.marcas[fila / 64] |= 1ULL << (fila % 64);
+            transformada.muestras_sufijos.push_back(static_cast<uint32_t>(posicion));
+            transformada.muestras_inverso[posicion / paso_muestreo] = static_cast<uint32_t>(fila);
+        }
+        fila++;
+
+        if (buffer.size() >= BUFFER_BWT_EXTERNA) {
+            salida.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    };
+
+    // Fila 0: el sufijo vacío
+    emitirFila(longitud);
+
+    size_t capacidad = std::max<size_t>(memoria_bytes / sizeof(uint64_t), 1);
+    std::vector<uint64_t> sufijos;
+
+    // Emite en orden los sufijos que comienzan con prefijo, dados los conteos de sus cubetas del
+    // nivel siguiente. Una cubeta que no cabe en el presupuesto se vuelve a contar por los k
+    // caracteres que siguen, hasta MAX_NIVELES_CUBETAS_EXTERNAS niveles
+    std::function<void(std::vector<uint64_t>&, const std::vector<uint32_t>&)> ordenarNivel =
+        [&](std::vector<uint64_t>& prefijo, const std::vector<uint32_t>& conteos_nivel) {
+        size_t nivel = prefijo.size();
+        for (size_t primera = 0; primera < conteos_nivel.size();) {
+            if (conteos_nivel[primera] > capacidad && nivel + 1 < MAX_NIVELES_CUBETAS_EXTERNAS) {
+                prefijo.push_back(primera);
+                std::vector<uint32_t> conteos_hijas(conteos_nivel.size(), 0);
+                recorrerNivel(prefijo, [&](size_t, uint64_t cubeta) { conteos_hijas[cubeta]++; });
+                ordenarNivel(prefijo, conteos_hijas);
+                prefijo.pop_back();
+                primera++;
+                continue;
+            }
+
+            // Cubetas [primera, ultima) de esta pasada: al menos una (solo excede el
+            // presupuesto si ya se alcanzó el último nivel)
+            size_t ultima = primera;
+            size_t cantidad = 0;
+            while (ultima < conteos_nivel.size() && (ultima == primera || cantidad + conteos_nivel[ultima] <= capacidad)) {
+                cantidad += conteos_nivel[ultima++];
+            }
+            if (cantidad > 0) {
+                sufijos.clear();
+                sufijos.reserve(cantidad);
+                recorrerNivel(prefijo, [&](size_t i, uint64_t cubeta) {
+                    if (cubeta >= primera && cubeta < ultima) sufijos.push_back((cubeta << 32) | i);
+                });
+                std::sort(sufijos.begin(), sufijos.end(), menorSufijo(nivel));
+                for (uint64_t sufijo : sufijos) emitirFila(static_cast<uint32_t>(sufijo));
+                transformada.pasadas++;
+                transformada.max_sufijos_pasada = std::max(transformada.max_sufijos_pasada, cantidad);
+            }
+            primera = ultima;
+        }
+    };
+
+    std::vector<uint64_t> prefijo;
+    ordenarNivel(prefijo, conteos);
+
+    salida.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    salida.close();
+    if (!salida) throw std::runtime_error("Error al escribir el archivo temporal de la BWT: " + ruta_bwt);
+    return transformada;
+}
@@ -0,0 +1,8 @@
+#include "../include/definiciones.hpp"
+#include "../include/contadores.hpp"
+
+thread_local ContadoresMotor contadores_motor;
+
+void reiniciarContadoresMotor() {
+    contadores_motor = ContadoresMotor();
+}
@@ -1,18 +1,60 @@
 #include "../include/definiciones.hpp"
 #include "../include/fm_index.hpp"
+#include "../include/traza.hpp"
 
-#include <map>
-#include <unordered_set>
+/**
+ * @brief Número mágico al inicio de los archivos de índice ("FMINDEX\0").
+ */
+static const uint64_t MAGICO_ARCHIVO_FM_INDEX = 0x005845444E494D46ULL;
+
+/**
+ * @brief Marca escrita con el orden de bytes nativo para detectar archivos de otra arquitectura.
+ */
+static const uint32_t MARCA_ENDIANNESS = 0x01020304;
+
+TransformadaBWT construirTransformadaFM(const std::string& texto, const OpcionesFMIndex& opciones) {
+    std::unique_ptr<PoolTrabajo> pool_propio;
+    PoolTrabajo* pool = poolParaHilos(opciones.hilos_construccion, pool_propio);
+    if (!opciones.ignorar_mayusculas) return construirTransformadaBWT(texto, pool);
+
+    std::string plegado;
+    {
+        TRAZAR_FASE("plegado_caso");
+        plegado = plegarCaso(texto);
+    }
+    return construirTransformadaBWT(plegado, pool);
+}
 
 /**
  * @brief Constructor que inicializa la estructura FM-Index con el texto dado.
- *        Utiliza el texto para construir las estructuras necesarias (BWT, tablas).
+ *        El arreglo de sufijos completo solo vive durante la construcción:
+ *        de él se derivan la BWT, la tabla C y las muestras de SA e ISA.
+ */
+FMIndex::FMIndex(const std::string& texto, const OpcionesFMIndex& opciones)
+    : FMIndex(construirTransformadaFM(texto, opciones), opciones) {}
+
+/**
+ * @brief Constructor desde la transformada: deriva la tabla C, las muestras
+ *        de SA e ISA y el backend de rango.
  */
-FMIndex::FMIndex(const std::string& texto) : texto_(texto) {
-    arreglo_sufijos_ = construirArregloSufijos(texto_);
-    bwt_ = construirTransformadaBWT(texto_, arreglo_sufijos_);
-    tabla_inicio_caracter_ = construirTablaInicioCaracter(bwt_);
-    tabla_ocurrencias_ = construirTablaOcurrencias(bwt_);
+FMIndex::FMIndex(const TransformadaBWT& transformada, const OpcionesFMIndex& opciones)
+    : longitud_texto_(transformada.longitud()), fila_centinela_(transformada.fila_centinela),
+      paso_muestreo_(opciones.paso_muestreo), tipo_rango_(opciones.tipo_rango),
+      ignorar_mayusculas_(opciones.ignorar_mayusculas) {
+    if (paso_muestreo_ == 0) {
+        throw std::invalid_argument("El paso de muestreo del FM-Index debe ser mayor que 0");
+    }
+
+    std::unique_ptr<PoolTrabajo> pool_propio;
+    PoolTrabajo* pool = poolParaHilos(opciones.hilos_construccion, pool_propio);
+
+    tabla_inicio_caracter_ = ArregloPlano<uint64_t>(construirTablaInicioCaracter(transformada.bwt, pool));
+    construirMuestras(transformada, pool);
+
+    if (tipo_rango_ == TipoRango::Wavelet) wavelet_ = WaveletMatrix(transformada.bwt);
+    else tabla_ocurrencias_ = TablaOcurrencias(transformada.bwt, pool);
+
+    if (opciones.largo_kmer > 0) construirTablaKmer(opciones.largo_kmer);
 }
 
 /**
@@ -22,214 +64,582 @@ FMIndex::FMIndex(const std::string& texto) : texto_(texto) {
 unsigned int FMIndex::buscar(const std::string& patron) const {
     if (patron.empty()) return 0;
 
-    int i = static_cast<int>(patron.size()) - 1;
-    char c = patron[i];
+    return conRango([&](const auto& rango) {
+        auto intervalo = intervaloPatron(rango, patron);
+        return static_cast<unsigned int>(intervalo.second - intervalo.first);
+    });
+}
 
-    if (!tabla_inicio_caracter_.count(c)) return 0;
+/**
+ * @brief Cuenta un lote de patrones intercalando sus búsquedas backward.
+ */
+std::vector<unsigned int> FMIndex::buscarLote(const std::vector<std::string>& patrones) const {
+    return conRango([&](const auto& rango) { return buscarLoteCon(rango, patrones); });
+}
 
-    int inicio = tabla_inicio_caracter_.at(c);
-    int fin = inicio + tabla_ocurrencias_.at(c).back();
+/**
+ * @brief Ventana de búsquedas activas: cada turno avanza todas un carácter y
+ *        precarga las filas del siguiente; las que terminan se reemplazan por
+ *        patrones nuevos para mantener la ventana llena.
+ */
+template<typename Rango>
+std::vector<unsigned int> FMIndex::buscarLoteCon(const Rango& rango, const std::vector<std::string>& patrones) const {
+    struct Busqueda {
+        const char* patron;     // Caracteres del patrón
+        size_t restantes;       // Caracteres por procesar
+        size_t inicio;
+        size_t fin;
+        size_t indice;          // Posición en patrones
+    };
+
+    std::vector<unsigned int> conteos(patrones.size(), 0);
+    std::vector<Busqueda> activas;
+    activas.reserve(TAMANO_LOTE_BUSQUEDA);
+    size_t siguiente_patron = 0;
+
+    while (true) {
+        while (activas.size() < TAMANO_LOTE_BUSQUEDA && siguiente_patron < patrones.size()) {
+            const std::string& patron = patrones[siguiente_patron];
+            Busqueda busqueda{patron.data(), patron.size(), 0, longitud_texto_ + 1, siguiente_patron};
+            siguiente_patron++;
+
+            if (largo_kmer_ > 0 && busqueda.restantes >= largo_kmer_) {
+                busqueda.restantes -= largo_kmer_;
+                std::tie(busqueda.inicio, busqueda.fin) = intervaloKmer(busqueda.patron + busqueda.restantes);
+                if (busqueda.inicio >= busqueda.fin) continue;
+                if (busqueda.restantes == 0) {
+                    conteos[busqueda.indice] = static_cast<unsigned int>(busqueda.fin - busqueda.inicio);
+                    continue;
+                }
+            }
+            if (busqueda.restantes == 0) continue;
 
-    while (i > 0 && inicio < fin) {
-        i--;
-        c = patron[i];
-        if (!tabla_inicio_caracter_.count(c)) return 0;
+            unsigned char c = caracterPatron(busqueda.patron[busqueda.restantes - 1]);
+            precargarBWT(rango, c, busqueda.inicio);
+            precargarBWT(rango, c, busqueda.fin);
+            activas.push_back(busqueda);
+        }
+        if (activas.empty()) break;
+
+        for (size_t k = 0; k < activas.size();) {
+            Busqueda& busqueda = activas[k];
+            unsigned char c = caracterPatron(busqueda.patron[--busqueda.restantes]);
+
+            busqueda.inicio = tabla_inicio_caracter_[c] + rangoBWT(rango, c, busqueda.inicio);
+            busqueda.fin = tabla_inicio_caracter_[c] + rangoBWT(rango, c, busqueda.fin);
+
+            if (busqueda.inicio >= busqueda.fin || busqueda.restantes == 0) {
+                if (busqueda.inicio < busqueda.fin) {
+                    conteos[busqueda.indice] = static_cast<unsigned int>(busqueda.fin - busqueda.inicio);
+                }
+                busqueda = activas.back();
+                activas.pop_back();
+                continue;
+            }
 
-        int nuevo_inicio = tabla_inicio_caracter_.at(c) + (inicio > 0 ? tabla_ocurrencias_.at(c)[inicio - 1] : 0);
-        int nuevo_fin = tabla_inicio_caracter_.at(c) + tabla_ocurrencias_.at(c)[fin - 1];
+            unsigned char proximo = caracterPatron(busqueda.patron[busqueda.restantes - 1]);
+            precargarBWT(rango, proximo, busqueda.inicio);
+            precargarBWT(rango, proximo, busqueda.fin);
+            ++k;
+        }
+    }
+    return conteos;
+}
 
-        inicio = nuevo_inicio;
-        fin = nuevo_fin;
+/**
+ * @brief Búsqueda backward: el intervalo [inicio, fin) de filas se reduce
+ *        con la tabla C y el rango del backend por cada carácter del patrón.
+ */
+template<typename Rango>
+std::pair<size_t, size_t> FMIndex::intervaloPatron(const Rango& rango, const std::string& patron) const {
+    size_t inicio = 0;
+    size_t fin = longitud_texto_ + 1;
+    size_t restantes = patron.size();
+
+    // Los últimos k caracteres se resuelven con una lectura de la tabla de k-mers
+    if (largo_kmer_ > 0 && restantes >= largo_kmer_) {
+        restantes -= largo_kmer_;
+        std::tie(inicio, fin) = intervaloKmer(patron.data() + restantes);
+        if (inicio >= fin) return {0, 0};
     }
 
-    unsigned int coincidencias = (inicio < fin) ? (fin - inicio) : 0;
-    return coincidencias;
+    for (size_t i = restantes; i-- > 0;) {
+        unsigned char c = caracterPatron(patron[i]);
+
+        // El carácter no aparece en el texto
+        if (tabla_inicio_caracter_[c] == tabla_inicio_caracter_[c + 1]) return {0, 0};
+
+        inicio = tabla_inicio_caracter_[c] + rangoBWT(rango, c, inicio);
+        fin = tabla_inicio_caracter_[c] + rangoBWT(rango, c, fin);
+        if (inicio >= fin) return {0, 0};
+    }
+    return {inicio, fin};
+}
+
+/**
+ * @brief LF(fila) = C[c] + rango(c, fila), con c el carácter de la BWT en la fila.
+ */
+template<typename Rango>
+size_t FMIndex::pasoLF(const Rango& rango, size_t fila, unsigned char* caracter) const {
+    unsigned char c = rango.acceder(fila > fila_centinela_ ? fila - 1 : fila);
+    if (caracter != nullptr) *caracter = c;
+    return tabla_inicio_caracter_[c] + rangoBWT(rango, c, fila);
+}
+
+/**
+ * @brief Cada paso LF retrocede una posición en el texto; al llegar a una fila
+ *        muestreada se suma la cantidad de pasos a su posición guardada.
+ */
+template<typename Rango>
+size_t FMIndex::posicionDeFila(const Rango& rango, size_t fila) const {
+    size_t pasos = 0;
+    while (!filas_muestreadas_.acceder(fila)) {
+        fila = pasoLF(rango, fila);
+        pasos++;
+    }
+    return muestras_sufijos_[filas_muestreadas_.rango1(fila)] + pasos;
 }
 
 /**
- * @brief Genera todas las combinaciones posibles del patrón con variaciones
- *        de mayúsculas y minúsculas, excluyendo el patrón original.
+ * @brief Localiza cada fila del intervalo del patrón y ordena las posiciones.
  */
-std::unordered_set<std::string> FMIndex::generarVariacionesCapitalizacion(const std::string& patron) const {
-    std::unordered_set<std::string> variaciones;
-    // int longitud = static_cast<int>(patron.length());
-    // int total_variaciones = 1 << longitud;
+std::vector<size_t> FMIndex::localizar(const std::string& patron) const {
+    if (patron.empty()) return {};
+
+    return conRango([&](const auto& rango) {
+        auto intervalo = intervaloPatron(rango, patron);
 
-    // for (int mascara = 0; mascara < total_variaciones; ++mascara) {
-    //     std::string variacion;
-    //     variacion.reserve(longitud);
-    //     for (int posicion = 0; posicion < longitud; ++posicion) {
-    //         bool es_mayuscula = (mascara >> posicion) & 1;
-    //         variacion += es_mayuscula ? static_cast<char>(std::toupper(patron[posicion]))
-    //                                   : static_cast<char>(std::tolower(patron[posicion]));
-    //     }
-    //     if (variacion != patron) {
-    //         variaciones.insert(variacion);
-    //     }
-    // }
-    return variaciones;
+        std::vector<size_t> posiciones;
+        posiciones.reserve(intervalo.second - intervalo.first);
+        for (size_t fila = intervalo.first; fila < intervalo.second; ++fila) {
+            posiciones.push_back(posicionDeFila(rango, fila));
+        }
+        std::sort(posiciones.begin(), posiciones.end());
+        return posiciones;
+    });
+}
+
+std::pair<size_t, size_t> FMIndex::intervaloFilas(const std::string& patron) const {
+    if (patron.empty()) return {0, 0};
+    return conRango([&](const auto& rango) { return intervaloPatron(rango, patron); });
 }
 
 /**
- * @brief Construye el arreglo de sufijos del texto.
+ * @brief Sin tabla de k-mers: cada posición del patrón puede aceptar varios caracteres.
  */
-vc FMIndex::construirArregloSufijos(const std::string& texto) {
-    int longitud = static_cast<int>(texto.size());
-    vc arreglo_sufijos(longitud);
-    rep(i, longitud) {
-        arreglo_sufijos[i] = i;
+ResultadoComodin FMIndex::buscarComodin(const PatronComodin& patron, size_t maximo_intervalos) const {
+    const PatronComodin buscado = ignorar_mayusculas_ ? patron.plegado() : patron;
+
+    ResultadoComodin resultado;
+    conRango([&](const auto& rango) {
+        expandirComodin(rango, buscado, buscado.size(), 0, longitud_texto_ + 1, maximo_intervalos, resultado);
+    });
+    return resultado;
+}
+
+template<typename Rango>
+void FMIndex::expandirComodin(const Rango& rango, const PatronComodin& patron, size_t restantes, size_t inicio, size_t fin,
+                              size_t maximo_intervalos, ResultadoComodin& resultado) const {
+    if (restantes == 0) {
+        resultado.ocurrencias += fin - inicio;
+        return;
     }
 
-    std::sort(arreglo_sufijos.begin(), arreglo_sufijos.end(),
-        [&](int a, int b) {
-            int comparacion_longitud = longitud - std::max(a, b);
-            return texto.compare(a, comparacion_longitud, texto, b, comparacion_longitud) < 0;
-        });
+    for (char caracter : patron.caracteres(restantes - 1)) {
+        unsigned char c = static_cast<unsigned char>(caracter);
+        if (tabla_inicio_caracter_[c] == tabla_inicio_caracter_[c + 1]) continue;
+
+        size_t nuevo_inicio = tabla_inicio_caracter_[c] + rangoBWT(rango, c, inicio);
+        size_t nuevo_fin = tabla_inicio_caracter_[c] + rangoBWT(rango, c, fin);
+        if (nuevo_inicio >= nuevo_fin) continue;
+
+        if (resultado.intervalos_explorados == maximo_intervalos) {
+            resultado.truncado = true;
+            return;
+        }
+        resultado.intervalos_explorados++;
 
-    return arreglo_sufijos;
+        expandirComodin(rango, patron, restantes - 1, nuevo_inicio, nuevo_fin, maximo_intervalos, resultado);
+        if (resultado.truncado) return;
+    }
 }
 
 /**
- * @brief Construye la BWT (Burrows-Wheeler Transform) desde el arreglo de sufijos.
+ * @brief Parte de la primera posición muestreada en o después del final pedido
+ *        y retrocede con LF, escribiendo la subcadena de derecha a izquierda.
  */
-std::string FMIndex::construirTransformadaBWT(const std::string& texto, const vc& arreglo_sufijos) {
-    std::string bwt(texto.size(), '$');
-    for (size_t i = 0; i < arreglo_sufijos.size(); ++i) {
-        int indice_sufijo = arreglo_sufijos[i];
-        bwt[i] = (indice_sufijo == 0) ? texto.back() : texto[indice_sufijo - 1];
+std::string FMIndex::extraer(size_t inicio, size_t longitud) const {
+    if (inicio > longitud_texto_) {
+        throw std::out_of_range("extraer: posición fuera del texto indexado");
     }
-    return bwt;
+    size_t fin = inicio + std::min(longitud, longitud_texto_ - inicio);
+
+    std::string subcadena(fin - inicio, '\0');
+    if (subcadena.empty()) return subcadena;
+
+    return conRango([&](const auto& rango) {
+        size_t posicion = ((fin + paso_muestreo_ - 1) / paso_muestreo_) * paso_muestreo_;
+        size_t fila = 0;  // Fila del sufijo vacío, que comienza en la posición n
+        if (posicion < longitud_texto_) fila = muestras_inverso_[posicion / paso_muestreo_];
+        else posicion = longitud_texto_;
+
+        while (posicion > inicio) {
+            unsigned char c;
+            fila = pasoLF(rango, fila, &c);
+            --posicion;
+            if (posicion < fin) subcadena[posicion - inicio] = static_cast<char>(c);
+        }
+        return subcadena;
+    });
 }
 
 /**
- * @brief Construye la tabla de inicio por carácter (tabla C).
+ * @brief Memoria de las estructuras que usan las consultas.
  */
-std::map<char, int> FMIndex::construirTablaInicioCaracter(const std::string& bwt) {
-    std::map<char, int> tabla_inicio_caracter;
-    std::string caracteres_unicos = bwt;
+size_t FMIndex::getMemoriaBytes() const {
+    size_t rango = conRango([](const auto& backend) { return backend.getMemoriaBytes(); });
+    return tabla_inicio_caracter_.getMemoriaBytes() + rango + filas_muestreadas_.getMemoriaBytes()
+         + muestras_sufijos_.getMemoriaBytes() + muestras_inverso_.getMemoriaBytes()
+         + getMemoriaTablaKmerBytes();
+}
 
-    std::sort(caracteres_unicos.begin(), caracteres_unicos.end());
-    caracteres_unicos.erase(std::unique(caracteres_unicos.begin(), caracteres_unicos.end()), caracteres_unicos.end());
+size_t FMIndex::getMemoriaTablaKmerBytes() const {
+    return codigos_kmer_.getMemoriaBytes() + tabla_kmer_.getMemoriaBytes();
+}
 
-    int acumulador = 0;
-    for (char caracter : caracteres_unicos) {
-        tabla_inicio_caracter[caracter] = acumulador;
-        acumulador += static_cast<int>(std::count(bwt.begin(), bwt.end(), caracter));
+/**
+ * @brief Clave del k-mer por el método de Horner sobre los códigos compactos.
+ */
+std::pair<size_t, size_t> FMIndex::intervaloKmer(const char* kmer) const {
+    uint64_t clave = 0;
+    rep(j, largo_kmer_) {
+        uint16_t codigo = codigos_kmer_[caracterPatron(kmer[j])];
+        if (codigo == SIN_CODIGO_KMER) return {0, 0};
+        clave = clave * simbolos_kmer_ + codigo;
+    }
+
+    size_t mascara = (size_t(1) << bits_ranuras_kmer_) - 1;
+    size_t ranura = ranuraKmer(clave);
+    for (size_t sondeo = 0; sondeo <= mascara; ++sondeo, ranura = (ranura + 1) & mascara) {
+        uint64_t intervalo = tabla_kmer_[2 * ranura + 1];
+        if (intervalo == 0) break;
+        if (tabla_kmer_[2 * ranura] == clave) return {intervalo & 0xFFFFFFFFULL, intervalo >> 32};
     }
-    return tabla_inicio_caracter;
+    return {0, 0};
 }
 
 /**
- * @brief Construye la tabla de ocurrencias acumuladas por carácter.
+ * @brief Asigna códigos a los símbolos presentes, verifica que las claves
+ *        (σ^k valores) quepan en 64 bits, junta los k-mers que aparecen y
+ *        los inserta en una tabla con al menos el doble de ranuras.
  */
-mcharvc FMIndex::construirTablaOcurrencias(const std::string& bwt) {
-    mcharvc tabla_ocurrencias;
-
-    for (char caracter : bwt) {
-        if (!tabla_ocurrencias.count(caracter)) {
-            tabla_ocurrencias[caracter] = vc(bwt.size(), 0);
-        }
+void FMIndex::construirTablaKmer(uint32_t largo_kmer) {
+    TRAZAR_FASE("tabla_kmer");
+    std::vector<uint16_t> codigos(256, SIN_CODIGO_KMER);
+    uint32_t simbolos = 0;
+    rep(c, 256) {
+        if (tabla_inicio_caracter_[c] < tabla_inicio_caracter_[c + 1]) codigos[c] = static_cast<uint16_t>(simbolos++);
     }
 
-    for (size_t i = 0; i < bwt.size(); ++i) {
-        char caracter_actual = bwt[i];
-        for (auto& par : tabla_ocurrencias) {
-            char clave = par.first;
-            vc& conteos = par.second;
-            conteos[i] = (i > 0 ? conteos[i - 1] : 0) + (clave == caracter_actual ? 1 : 0);
+    uint64_t clave_maxima = 0;
+    rep(j, largo_kmer) {
+        if (simbolos == 0) break;
+        if (clave_maxima > (std::numeric_limits<uint64_t>::max() - (simbolos - 1)) / simbolos) {
+            throw std::invalid_argument("Las claves de " + std::to_string(largo_kmer) + "-mers con "
+                                        + std::to_string(simbolos) + " símbolos no caben en 64 bits");
         }
+        clave_maxima = clave_maxima * simbolos + (simbolos - 1);
     }
 
-    return tabla_ocurrencias;
+    largo_kmer_ = largo_kmer;
+    simbolos_kmer_ = simbolos;
+    codigos_kmer_ = ArregloPlano<uint16_t>(codigos);
+
+    std::vector<std::pair<uint64_t, uint64_t>> kmers;
+    conRango([&](const auto& rango) {
+        llenarTablaKmer(rango, 0, longitud_texto_ + 1, 0, 0, 1, kmers);
+        return 0;
+    });
+
+    bits_ranuras_kmer_ = 1;
+    while ((size_t(1) << bits_ranuras_kmer_) < 2 * kmers.size()) bits_ranuras_kmer_++;
+    size_t mascara = (size_t(1) << bits_ranuras_kmer_) - 1;
+
+    VectorAlineado<uint64_t> tabla(2 * (mascara + 1), 0);
+    for (const auto& kmer : kmers) {
+        size_t ranura = ranuraKmer(kmer.first);
+        while (tabla[2 * ranura + 1] != 0) ranura = (ranura + 1) & mascara;
+        tabla[2 * ranura] = kmer.first;
+        tabla[2 * ranura + 1] = kmer.second;
+    }
+    tabla_kmer_ = ArregloPlano<uint64_t>(std::move(tabla));
 }
 
 /**
- * @brief Método estático alternativo que permite buscar sin construir la clase.
- * 
- * Esta función realiza todo el proceso (construcción de BWT, tablas, etc.)
- * desde cero en cada llamada. Es útil para búsquedas puntuales cuando no se
- * necesita reutilizar estructuras ni mantener estado.
- * 
- * Se mantiene junto al constructor y al método no estático para dar flexibilidad:
- * - El método estático es ideal para búsquedas únicas o pruebas rápidas.
- * - La versión con constructor es más eficiente para múltiples búsquedas
- *   sobre el mismo texto, ya que evita reprocesar todo cada vez.
+ * @brief Recorrido en profundidad: solo se visitan sufijos de k-mers que
+ *        aparecen en el texto, de modo que el costo y la tabla dependen de
+ *        los k-mers observados y no de σ^k.
  */
-unsigned int FMIndex::buscar(const std::string& texto, const std::string& patron) {
-    if (patron.empty()) return 0;
-
-    auto arreglo_sufijos = construirArregloSufijos(texto);
-    auto bwt = construirTransformadaBWT(texto, arreglo_sufijos);
-    auto tabla_inicio_caracter = construirTablaInicioCaracter(bwt);
-    auto tabla_ocurrencias = construirTablaOcurrencias(bwt);
+template<typename Rango>
+void FMIndex::llenarTablaKmer(const Rango& rango, size_t inicio, size_t fin, uint32_t profundidad,
+                              uint64_t clave, uint64_t peso, std::vector<std::pair<uint64_t, uint64_t>>& kmers) const {
+    if (profundidad == largo_kmer_) {
+        if (kmers.size() == MAX_KMERS_TABLA) {
+            throw std::invalid_argument("El texto tiene más de " + std::to_string(MAX_KMERS_TABLA) + " "
+                                        + std::to_string(largo_kmer_) + "-mers distintos");
+        }
+        kmers.emplace_back(clave, static_cast<uint64_t>(inicio) | (static_cast<uint64_t>(fin) << 32));
+        return;
+    }
 
-    int i = static_cast<int>(patron.size()) - 1;
-    char c = patron[i];
+    rep(c, 256) {
+        uint16_t codigo = codigos_kmer_[c];
+        if (codigo == SIN_CODIGO_KMER) continue;
 
-    if (!tabla_inicio_caracter.count(c)) return 0;
+        unsigned char caracter = static_cast<unsigned char>(c);
+        size_t nuevo_inicio = tabla_inicio_caracter_[caracter] + rangoBWT(rango, caracter, inicio);
+        size_t nuevo_fin = tabla_inicio_caracter_[caracter] + rangoBWT(rango, caracter, fin);
+        if (nuevo_inicio >= nuevo_fin) continue;
 
-    int inicio = tabla_inicio_caracter[c];
-    int fin = inicio + tabla_ocurrencias[c].back();
+        llenarTablaKmer(rango, nuevo_inicio, nuevo_fin, profundidad + 1,
+                        clave + codigo * peso, peso * simbolos_kmer_, kmers);
+    }
+}
 
-    while (i > 0 && inicio < fin) {
-        i--;
-        c = patron[i];
-        if (!tabla_inicio_caracter.count(c)) return 0;
+/**
+ * @brief Marca las filas cuyo sufijo comienza en un múltiplo del paso y guarda
+ *        su posición (SA muestreado) y, por cada múltiplo, su fila (ISA muestreado).
+ * 
+ * Las filas se reparten en tramos de palabras de 64 filas: cada tramo
+ * cuenta sus filas muestreadas, una suma acumulada da dónde escribe cada
+ * uno en muestras_sufijos_ y una segunda pasada las escribe.
+ */
+void FMIndex::construirMuestras(const TransformadaBWT& transformada, PoolTrabajo* pool) {
+    TRAZAR_FASE("muestras");
+    size_t cantidad_filas = longitud_texto_ + 1;
+    size_t cantidad_palabras = cantidad_filas / 64 + 1;
+    VectorAlineado<uint64_t> marcas(cantidad_palabras, 0);
+    std::vector<uint32_t> muestras_inverso(longitud_texto_ / paso_muestreo_ + 1, 0);
+
+    size_t tramos = cantidadTramos(cantidad_filas, pool);
+    auto filasDe = [&](size_t palabra_inicio, size_t palabra_fin) {
+        return std::make_pair(std::min(palabra_inicio * 64, cantidad_filas), std::min(palabra_fin * 64, cantidad_filas));
+    };
+
+    std::vector<size_t> muestras_por_tramo(tramos + 1, 0);
+    paraCadaTramo(cantidad_palabras, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        auto filas = filasDe(inicio, fin);
+        for (size_t fila = filas.first; fila < filas.second; ++fila) {
+            if (transformada.sufijoDeFila(fila) % paso_muestreo_ == 0) muestras_por_tramo[tramo + 1]++;
+        }
+    });
+    rep(tramo, tramos) muestras_por_tramo[tramo + 1] += muestras_por_tramo[tramo];
+
+    std::vector<uint32_t> muestras_sufijos(muestras_por_tramo.back());
+    paraCadaTramo(cantidad_palabras, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        size_t siguiente = muestras_por_tramo[tramo];
+        auto filas = filasDe(inicio, fin);
+        for (size_t fila = filas.first; fila < filas.second; ++fila) {
+            size_t posicion = transformada.sufijoDeFila(fila);
+            if (posicion % paso_muestreo_ != 0) continue;
+
+            marcas[fila / 64] |= 1ULL << (fila % 64);
+            muestras_sufijos[siguiente++] = static_cast<uint32_t>(posicion);
+            muestras_inverso[posicion / paso_muestreo_] = static_cast<uint32_t>(fila);
+        }
+    });
 
-        int nuevo_inicio = tabla_inicio_caracter[c] + (inicio > 0 ? tabla_ocurrencias[c][inicio - 1] : 0);
-        int nuevo_fin = tabla_inicio_caracter[c] + tabla_ocurrencias[c][fin - 1];
+    filas_muestreadas_ = BitVector(std::move(marcas), cantidad_filas);
+    muestras_sufijos_ = ArregloPlano<uint32_t>(muestras_sufijos);
+    muestras_inverso_ = ArregloPlano<uint32_t>(muestras_inverso);
+}
 
-        inicio = nuevo_inicio;
-        fin = nuevo_fin;
+/**
+ * @brief El texto se mapea solo mientras se ordenan los sufijos; las
+ *        estructuras compactas se construyen después, sobre la BWT mapeada.
+ */
+std::unique_ptr<FMIndex> FMIndex::construirExterno(const std::string& ruta_texto, const OpcionesFMIndex& opciones,
+                                                   const OpcionesConstruccionExterna& externa) {
+    if (opciones.paso_muestreo == 0) {
+        throw std::invalid_argument("El paso de muestreo del FM-Index debe ser mayor que 0");
     }
+    std::ifstream archivo_texto(ruta_texto, std::ios::binary | std::ios::ate);
+    if (!archivo_texto) throw std::runtime_error("No se pudo abrir el texto a indexar: " + ruta_texto);
+    if (archivo_texto.tellg() == 0) return std::make_unique<FMIndex>(std::string(), opciones);
+    archivo_texto.close();
+
+    ArchivoTemporal archivo_bwt(externa.directorio_temporal, "bwt");
+    TransformadaExterna transformada;
+    {
+        std::unique_ptr<ArchivoTemporal> plegado;
+        std::string ruta_ordenada = ruta_texto;
+        if (opciones.ignorar_mayusculas) {
+            TRAZAR_FASE("plegado_caso");
+            plegado = std::make_unique<ArchivoTemporal>(externa.directorio_temporal, "plegado");
+            std::ifstream entrada(ruta_texto, std::ios::binary);
+            std::ofstream salida(plegado->getRuta(), std::ios::binary | std::ios::trunc);
+            std::string bloque(1 << 20, '\0');
+            while (entrada.read(&bloque[0], static_cast<std::streamsize>(bloque.size())) || entrada.gcount() > 0) {
+                std::string leido = plegarCaso(bloque.substr(0, static_cast<size_t>(entrada.gcount())));
+                salida.write(leido.data(), static_cast<std::streamsize>(leido.size()));
+            }
+            if (!salida) throw std::runtime_error("No se pudo escribir el texto plegado en " + plegado->getRuta());
+            ruta_ordenada = plegado->getRuta();
+        }
 
-    unsigned int coincidencias = (inicio < fin) ? (fin - inicio) : 0;
-
-    /*
-    // Si se desea considerar también coincidencias con diferentes combinaciones
-    // de mayúsculas y minúsculas (por ejemplo, "Casa", "CASA", "cAsA", etc.),
-    // descomenta esta sección.
+        TRAZAR_FASE("ordenamiento_externo");
+        ArchivoMapeado texto(ruta_ordenada);
+        transformada = construirTransformadaExterna(std::string_view(texto.getDatos(), texto.getTamanio()),
+                                                    opciones.paso_muestreo, archivo_bwt.getRuta(), externa.memoria_bytes);
+    }
 
-    auto variaciones = generarVariacionesCapitalizacion(patron);
-    for (const auto& variante : variaciones) {
-        if (variante.empty()) continue;
+    std::unique_ptr<FMIndex> indice(new FMIndex());
+    indice->longitud_texto_ = transformada.longitud;
+    indice->fila_centinela_ = transformada.fila_centinela;
+    indice->paso_muestreo_ = opciones.paso_muestreo;
+    indice->tipo_rango_ = opciones.tipo_rango;
+    indice->ignorar_mayusculas_ = opciones.ignorar_mayusculas;
+    indice->filas_muestreadas_ = BitVector(std::move(transformada.marcas), transformada.longitud + 1);
+    indice->muestras_sufijos_ = ArregloPlano<uint32_t>(transformada.muestras_sufijos);
+    indice->muestras_inverso_ = ArregloPlano<uint32_t>(transformada.muestras_inverso);
+
+    {
+        std::unique_ptr<PoolTrabajo> pool_propio;
+        PoolTrabajo* pool = poolParaHilos(opciones.hilos_construccion, pool_propio);
+        ArchivoMapeado bwt_mapeada(archivo_bwt.getRuta());
+        std::string_view bwt(bwt_mapeada.getDatos(), bwt_mapeada.getTamanio());
+
+        indice->tabla_inicio_caracter_ = ArregloPlano<uint64_t>(construirTablaInicioCaracter(bwt, pool));
+        if (indice->tipo_rango_ == TipoRango::Wavelet) indice->wavelet_ = WaveletMatrix(bwt);
+        else indice->tabla_ocurrencias_ = TablaOcurrencias(bwt, pool);
+    }
 
-        int j = static_cast<int>(variante.size()) - 1;
-        char ch = variante[j];
+    if (opciones.largo_kmer > 0) indice->construirTablaKmer(opciones.largo_kmer);
+    return indice;
+}
 
-        if (!tabla_inicio_caracter.count(ch)) continue;
+/**
+ * @brief Guarda el índice en disco: cabecera, tabla C, backend de rango y muestras.
+ */
+void FMIndex::guardar(const std::string& ruta) const {
+    EscritorBinario escritor(ruta);
+    escritor.escribir(MAGICO_ARCHIVO_FM_INDEX);
+    escritor.escribir(VERSION_ARCHIVO_FM_INDEX);
+    escritor.escribir(MARCA_ENDIANNESS);
+    escritor.escribir(static_cast<uint32_t>(tipo_rango_));
+    escritor.escribir(paso_muestreo_);
+    escritor.escribir(largo_kmer_);
+    escritor.escribir(static_cast<uint32_t>(ignorar_mayusculas_));
+    escritor.escribir(static_cast<uint64_t>(longitud_texto_));
+    escritor.escribir(static_cast<uint64_t>(fila_centinela_));
+    escritor.escribirArreglo(tabla_inicio_caracter_);
+    conRango([&escritor](const auto& backend) { backend.serializar(escritor); return 0; });
+    filas_muestreadas_.serializar(escritor);
+    escritor.escribirArreglo(muestras_sufijos_);
+    escritor.escribirArreglo(muestras_inverso_);
+    escritor.escribirArreglo(codigos_kmer_);
+    escritor.escribirArreglo(tabla_kmer_);
+    escritor.cerrar();
+}
 
-        int ini = tabla_inicio_caracter[ch];
-        int fin2 = ini + tabla_ocurrencias[ch].back();
+/**
+ * @brief Carga un índice mapeando el archivo; los arreglos apuntan a las páginas mapeadas.
+ */
+std::unique_ptr<FMIndex> FMIndex::cargar(const std::string& ruta) {
+    auto archivo = std::make_shared<ArchivoMapeado>(ruta);
+    LectorMapeado lector(*archivo);
 
-        while (j > 0 && ini < fin2) {
-            j--;
-            ch = variante[j];
-            if (!tabla_inicio_caracter.count(ch)) {
-                ini = fin2 = 0;
-                break;
-            }
+    if (lector.leer<uint64_t>() != MAGICO_ARCHIVO_FM_INDEX) {
+        throw std::runtime_error("El archivo no es un índice FM: " + ruta);
+    }
+    uint32_t version = lector.leer<uint32_t>();
+    if (version != VERSION_ARCHIVO_FM_INDEX) {
+        throw std::runtime_error("Versión de índice FM no soportada (" + std::to_string(version) + "): " + ruta);
+    }
+    if (lector.leer<uint32_t>() != MARCA_ENDIANNESS) {
+        throw std::runtime_error("El índice FM fue generado con otro orden de bytes: " + ruta);
+    }
+    uint32_t tipo_rango = lector.leer<uint32_t>();
+    if (tipo_rango != static_cast<uint32_t>(TipoRango::Tabla) && tipo_rango != static_cast<uint32_t>(TipoRango::Wavelet)) {
+        throw std::runtime_error("Archivo de índice corrupto: backend de rango desconocido en " + ruta);
+    }
+    uint32_t paso_muestreo = lector.leer<uint32_t>();
+    uint32_t largo_kmer = lector.leer<uint32_t>();
+    uint32_t ignorar_mayusculas = lector.leer<uint32_t>();
+    uint64_t longitud = lector.leer<uint64_t>();
+    uint64_t fila_centinela = lector.leer<uint64_t>();
+    if (paso_muestreo == 0 || ignorar_mayusculas > 1 || fila_centinela > longitud) {
+        throw std::runtime_error("Archivo de índice corrupto: cabecera inconsistente en " + ruta);
+    }
 
-            int nuevo_ini = tabla_inicio_caracter[ch] + (ini > 0 ? tabla_ocurrencias[ch][ini - 1] : 0);
-            int nuevo_fin = tabla_inicio_caracter[ch] + tabla_ocurrencias[ch][fin2 - 1];
+    std::unique_ptr<FMIndex> indice(new FMIndex());
+    indice->tipo_rango_ = static_cast<TipoRango>(tipo_rango);
+    indice->paso_muestreo_ = paso_muestreo;
+    indice->largo_kmer_ = largo_kmer;
+    indice->ignorar_mayusculas_ = (ignorar_mayusculas == 1);
+    indice->longitud_texto_ = static_cast<size_t>(longitud);
+    indice->fila_centinela_ = static_cast<size_t>(fila_centinela);
+    lector.mapearArreglo(indice->tabla_inicio_caracter_);
+
+    size_t longitud_rango;
+    if (indice->tipo_rango_ == TipoRango::Wavelet) {
+        indice->wavelet_.mapear(lector);
+        longitud_rango = indice->wavelet_.size();
+    } else {
+        indice->tabla_ocurrencias_.mapear(lector);
+        longitud_rango = indice->tabla_ocurrencias_.size();
+    }
 
-            ini = nuevo_ini;
-            fin2 = nuevo_fin;
-        }
+    indice->filas_muestreadas_.mapear(lector);
+    lector.mapearArreglo(indice->muestras_sufijos_);
+    lector.mapearArreglo(indice->muestras_inverso_);
+    lector.mapearArreglo(indice->codigos_kmer_);
+    lector.mapearArreglo(indice->tabla_kmer_);
+
+    if (indice->tabla_inicio_caracter_.size() != 257 || longitud_rango != longitud
+        || indice->tabla_inicio_caracter_.back() != longitud + 1
+        || indice->filas_muestreadas_.size() != longitud + 1
+        || indice->muestras_sufijos_.size() != indice->filas_muestreadas_.contarUnos()
+        || indice->muestras_inverso_.size() != longitud / paso_muestreo + 1) {
+        throw std::runtime_error("Archivo de índice corrupto: dimensiones inconsistentes en " + ruta);
+    }
 
-        if (ini < fin2) {
-            coincidencias += (fin2 - ini);
+    // Tabla de k-mers: σ se recupera de los códigos y las ranuras son una potencia de 2
+    bool tabla_kmer_valida = (largo_kmer == 0)
+        ? indice->codigos_kmer_.empty() && indice->tabla_kmer_.empty()
+        : indice->codigos_kmer_.size() == 256 && indice->tabla_kmer_.size() >= 4;
+    if (largo_kmer > 0 && tabla_kmer_valida) {
+        for (uint16_t codigo : indice->codigos_kmer_) {
+            if (codigo != SIN_CODIGO_KMER) indice->simbolos_kmer_++;
         }
+        size_t ranuras = indice->tabla_kmer_.size() / 2;
+        while ((size_t(1) << indice->bits_ranuras_kmer_) < ranuras) indice->bits_ranuras_kmer_++;
+        tabla_kmer_valida = indice->tabla_kmer_.size() == 2 * (size_t(1) << indice->bits_ranuras_kmer_)
+                            && ranuras <= 2 * MAX_KMERS_TABLA && indice->bits_ranuras_kmer_ < 64;
     }
-    */
-
-    /*
-    if (total_coincidencias > 0) {
-        std::cout << AMARILLO << "Coincidencias exactas: " << coincidencias.coincidencias_exactas << RESET_COLOR << std::endl;
-        std::cout << CIAN << "Coincidencias con mayusculas/minusculas: " << coincidencias.coincidencias_capitalizacion << RESET_COLOR << std::endl;
-        std::cout << ROJO << "Total coincidencias: " << total_coincidencias << RESET_COLOR << std::endl;
+    if (!tabla_kmer_valida) {
+        throw std::runtime_error("Archivo de índice corrupto: tabla de k-mers inconsistente en " + ruta);
     }
-    */
 
-    return coincidencias;
+    indice->archivo_ = std::move(archivo);
+    return indice;
+}
+
+/**
+ * @brief Método estático alternativo que permite buscar sin construir la clase.
+ * 
+ * Esta función realiza todo el proceso (construcción de BWT, tablas, etc.)
+ * desde cero en cada llamada. Es útil para búsquedas puntuales cuando no se
+ * necesita reutilizar estructuras ni mantener estado.
+ * 
+ * Se mantiene junto al constructor y al método no estático para dar flexibilidad:
+ * - El método estático es ideal para búsquedas únicas o pruebas rápidas.
+ * - La versión con constructor es más eficiente para múltiples búsquedas
+ *   sobre el mismo texto, ya que evita reprocesar todo cada vez.
+ */
+unsigned int FMIndex::buscar(const std::string& texto, const std::string& patron) {
+    if (patron.empty()) return 0;
+
+    FMIndex indice(texto);
+    return indice.buscar(patron);
 }
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "../include/definiciones.hpp"
+#include "../include/fm_index_bidireccional.hpp"
+#include "../include/traza.hpp"
+
+#include <map>
+#include <stdexcept>
+
+/**
+ * @brief Búsqueda de un esquema: orden de las partes y cotas de errores acumulados al terminar cada una.
+ */
+struct EsquemaBusqueda {
+    std::vector<size_t> orden;
+    std::vector<uint32_t> minimo;
+    std::vector<uint32_t> maximo;
+};
+
+/**
+ * @brief Esquema de búsqueda para k errores sobre k + 1 partes (o 1, 2 y 3 partes para k = 0, 1, 2).
+ * 
+ * Para k = 1 y k = 2 se usan los esquemas de Kucherov, Salikhov y Tsur; para
+ * k mayor, el de palomar: alguna de las k + 1 partes no tiene errores y
+ * desde ella se extiende hacia la derecha y luego hacia la izquierda.
+ */
+static std::vector<EsquemaBusqueda> esquemaPara(uint32_t k) {
+    if (k == 0) return {{{0}, {0}, {0}}};
+    if (k == 1) return {{{0, 1}, {0, 0}, {0, 1}}, {{1, 0}, {0, 0}, {0, 1}}};
+    if (k == 2) {
+        return {{{0, 1, 2}, {0, 0, 0}, {0, 2, 2}},
+                {{2, 1, 0}, {0, 0, 0}, {0, 1, 2}},
+                {{1, 0, 2}, {0, 0, 1}, {0, 1, 2}}};
+    }
+
+    size_t partes = k + 1;
+    std::vector<EsquemaBusqueda> esquema;
+    rep(inicial, partes) {
+        EsquemaBusqueda busqueda;
+        for (size_t parte = inicial; parte < partes; ++parte) busqueda.orden.push_back(parte);
+        for (size_t parte = inicial; parte-- > 0;) busqueda.orden.push_back(parte);
+        busqueda.minimo.assign(partes, 0);
+        busqueda.maximo.assign(partes, k);
+        busqueda.maximo[0] = 0;
+        esquema.push_back(busqueda);
+    }
+    return esquema;
+}
+
+struct FMIndexBidireccional::EstadoBusqueda {
+    const std::string& patron;
+    TipoError tipo;
+    std::vector<PasoBusqueda> plan;
+    const std::vector<uint32_t>& minimo;
+    const std::vector<uint32_t>& maximo;
+    std::map<std::pair<size_t, size_t>, std::pair<Intervalo, uint32_t>>& encontrados;
+};
+
+FMIndexBidireccional::FMIndexBidireccional(const std::string& texto, uint32_t paso_muestreo)
+    : longitud_texto_(texto.size()), paso_muestreo_(paso_muestreo) {
+    if (paso_muestreo_ == 0) {
+        throw std::invalid_argument("El paso de muestreo del FM-Index debe ser mayor que 0");
+    }
+
+    // Las transformadas se construyen una a la vez para no tener los dos arreglos de sufijos en memoria
+    {
+        TransformadaBWT transformada;
+        {
+            TRAZAR_FASE("lado_directo");
+            transformada = construirTransformadaBWT(texto);
+            tabla_inicio_caracter_ = ArregloPlano<uint64_t>(construirTablaInicioCaracter(transformada.bwt));
+            directo_.rango = TablaOcurrencias(transformada.bwt);
+            directo_.fila_centinela = transformada.fila_centinela;
+        }
+        {
+            TRAZAR_FASE("muestras");
+            size_t cantidad_filas = longitud_texto_ + 1;
+            VectorAlineado<uint64_t> marcas(cantidad_filas / 64 + 1, 0);
+            std::vector<uint32_t> muestras_sufijos;
+            for (size_t fila = 0; fila < cantidad_filas; ++fila) {
+                size_t posicion = transformada.sufijoDeFila(fila);
+                if (posicion % paso_muestreo_ != 0) continue;
+
+                marcas[fila / 64] |= 1ULL << (fila % 64);
+                muestras_sufijos.push_back(static_cast<uint32_t>(posicion));
+            }
+            filas_muestreadas_ = BitVector(std::move(marcas), cantidad_filas);
+            muestras_sufijos_ = ArregloPlano<uint32_t>(muestras_sufijos);
+        }
+    }
+    {
+        TRAZAR_FASE("lado_inverso");
+        TransformadaBWT transformada = construirTransformadaBWT(std::string(texto.rbegin(), texto.rend()));
+        inverso_.rango = TablaOcurrencias(transformada.bwt);
+        inverso_.fila_centinela = transformada.fila_centinela;
+    }
+
+    rep(c, 256) {
+        if (tabla_inicio_caracter_[c] < tabla_inicio_caracter_[c + 1]) simbolos_.push_back(static_cast<unsigned char>(c));
+    }
+}
+
+/**
+ * @brief El lado que corresponde a la dirección avanza con el paso backward;
+ *        el otro se desplaza en los caracteres menores que c del intervalo.
+ */
+FMIndexBidireccional::Intervalo FMIndexBidireccional::extender(const Intervalo& intervalo, unsigned char c, bool hacia_derecha) const {
+    const LadoBWT& lado = hacia_derecha ? inverso_ : directo_;
+    size_t inicio = hacia_derecha ? intervalo.inverso : intervalo.directo;
+    size_t otro = hacia_derecha ? intervalo.directo : intervalo.inverso;
+    size_t fin = inicio + intervalo.tamano;
+
+    size_t antes = lado.rangoFilas(c, inicio);
+    size_t tamano = lado.rangoFilas(c, fin) - antes;
+    if (tamano == 0) return {0, 0, 0};
+
+    size_t nuevo_inicio = tabla_inicio_caracter_[c] + antes;
+    size_t nuevo_otro = otro + lado.menoresFilas(c, fin) - lado.menoresFilas(c, inicio);
+    return hacia_derecha ? Intervalo{nuevo_otro, nuevo_inicio, tamano} : Intervalo{nuevo_inicio, nuevo_otro, tamano};
+}
+
+/**
+ * @brief Los caracteres se visitan en orden, así que el desplazamiento del otro
+ *        lado es la suma de los tamaños de los anteriores (más el centinela).
+ *        Con pocas filas se leen directamente de la BWT.
+ */
+template<typename Visitar>
+void FMIndexBidireccional::extenderTodos(const Intervalo& intervalo, bool hacia_derecha, Visitar visitar) const {
+    const LadoBWT& lado = hacia_derecha ? inverso_ : directo_;
+    size_t inicio = hacia_derecha ? intervalo.inverso : intervalo.directo;
+    size_t otro = hacia_derecha ? intervalo.directo : intervalo.inverso;
+    size_t fin = inicio + intervalo.tamano;
+
+    auto visitarExtension = [&](unsigned char c, size_t menores, size_t tamano) {
+        size_t nuevo_inicio = tabla_inicio_caracter_[c] + lado.rangoFilas(c, inicio);
+        size_t nuevo_otro = otro + menores;
+        visitar(c, hacia_derecha ? Intervalo{nuevo_otro, nuevo_inicio, tamano} : Intervalo{nuevo_inicio, nuevo_otro, tamano});
+    };
+
+    size_t menores = (inicio <= lado.fila_centinela && lado.fila_centinela < fin) ? 1 : 0;
+
+    if (intervalo.tamano <= UMBRAL_ESCANEO_BIDIRECCIONAL) {
+        unsigned char caracteres[UMBRAL_ESCANEO_BIDIRECCIONAL];
+        size_t cantidad = 0;
+        for (size_t fila = inicio; fila < fin; ++fila) {
+            if (fila != lado.fila_centinela) caracteres[cantidad++] = lado.caracterDeFila(fila);
+        }
+        std::sort(caracteres, caracteres + cantidad);
+
+        for (size_t i = 0; i < cantidad;) {
+            size_t j = i;
+            while (j < cantidad && caracteres[j] == caracteres[i]) j++;
+            visitarExtension(caracteres[i], menores, j - i);
+            menores += j - i;
+            i = j;
+        }
+        return;
+    }
+
+    for (unsigned char c : simbolos_) {
+        size_t tamano = lado.rangoFilas(c, fin) - lado.rangoFilas(c, inicio);
+        if (tamano == 0) continue;
+        visitarExtension(c, menores, tamano);
+        menores += tamano;
+    }
+}
+
+/**
+ * @brief En cada paso el carácter del patrón se alinea con cada extensión
+ *        posible (coincidencia o sustitución); con ediciones además puede
+ *        borrarse o puede insertarse un carácter del texto en el hueco entre
+ *        el bloque ya alineado y el carácter actual. Las inserciones solo
+ *        ocurren entre caracteres del patrón: las del comienzo se agregan al
+ *        localizar y las del final no cambian la posición de inicio.
+ */
+void FMIndexBidireccional::avanzar(EstadoBusqueda& estado, size_t paso, const Intervalo& intervalo,
+                                   uint32_t errores, bool tras_insercion) const {
+    if (paso == estado.plan.size()) {
+        auto clave = std::make_pair(intervalo.directo, intervalo.tamano);
+        auto encontrado = estado.encontrados.find(clave);
+        if (encontrado == estado.encontrados.end()) estado.encontrados.emplace(clave, std::make_pair(intervalo, errores));
+        else encontrado->second.second = std::min(encontrado->second.second, errores);
+        return;
+    }
+
+    const PasoBusqueda& actual = estado.plan[paso];
+    uint32_t maximo = estado.maximo[actual.parte];
+    unsigned char esperado = static_cast<unsigned char>(estado.patron[actual.posicion]);
+    bool ediciones = estado.tipo == TipoError::Ediciones;
+
+    auto siguiente = [&](const Intervalo& nuevo, uint32_t nuevos_errores) {
+        if (actual.fin_de_parte && nuevos_errores < estado.minimo[actual.parte]) return;
+        avanzar(estado, paso + 1, nuevo, nuevos_errores, false);
+    };
+
+    // Sin margen de errores en esta parte: solo la coincidencia exacta
+    if (errores >= maximo) {
+        Intervalo nuevo = extender(intervalo, esperado, actual.hacia_derecha);
+        if (nuevo.tamano > 0) siguiente(nuevo, errores);
+        return;
+    }
+
+    extenderTodos(intervalo, actual.hacia_derecha, [&](unsigned char c, const Intervalo& nuevo) {
+        siguiente(nuevo, errores + (c == esperado ? 0 : 1));
+        if (ediciones && paso > 0) avanzar(estado, paso, nuevo, errores + 1, true);
+    });
+
+    // Un borrado tras una inserción en el mismo hueco equivale a una sustitución
+    if (ediciones && !tras_insercion) siguiente(intervalo, errores + 1);
+}
+
+std::vector<std::pair<FMIndexBidireccional::Intervalo, uint32_t>>
+FMIndexBidireccional::intervalosAproximados(const std::string& patron, uint32_t maximo_errores, TipoError tipo) const {
+    if (maximo_errores >= patron.size()) {
+        throw std::invalid_argument("La cantidad de errores debe ser menor que el largo del patrón");
+    }
+
+    std::vector<EsquemaBusqueda> esquema = esquemaPara(maximo_errores);
+    size_t partes = esquema[0].orden.size();
+
+    // Límites de las partes: la parte j es [limites[j], limites[j + 1])
+    std::vector<size_t> limites(partes + 1);
+    rep(j, partes + 1) limites[j] = j * patron.size() / partes;
+
+    std::map<std::pair<size_t, size_t>, std::pair<Intervalo, uint32_t>> encontrados;
+    for (const auto& busqueda : esquema) {
+        EstadoBusqueda estado{patron, tipo, {}, busqueda.minimo, busqueda.maximo, encontrados};
+
+        // La primera parte se recorre hacia la derecha; las siguientes, hacia el lado en que están
+        size_t primera = busqueda.orden[0];
+        rep(j, partes) {
+            size_t parte = busqueda.orden[j];
+            bool hacia_derecha = (j == 0) || parte > primera;
+            size_t desde = limites[parte], hasta = limites[parte + 1];
+            for (size_t i = 0; i < hasta - desde; ++i) {
+                size_t posicion = hacia_derecha ? desde + i : hasta - 1 - i;
+                estado.plan.push_back({posicion, hacia_derecha, static_cast<size_t>(j), i + 1 == hasta - desde});
+            }
+        }
+
+        avanzar(estado, 0, Intervalo{0, 0, longitud_texto_ + 1}, 0, false);
+    }
+
+    std::vector<std::pair<Intervalo, uint32_t>> intervalos;
+    intervalos.reserve(encontrados.size());
+    for (const auto& encontrado : encontrados) intervalos.push_back(encontrado.second);
+    return intervalos;
+}
+
+unsigned int FMIndexBidireccional::buscar(const std::string& patron) const {
+    if (patron.empty()) return 0;
+
+    Intervalo intervalo{0, 0, longitud_texto_ + 1};
+    for (size_t i = patron.size(); i-- > 0;) {
+        intervalo = extender(intervalo, static_cast<unsigned char>(patron[i]), false);
+        if (intervalo.tamano == 0) return 0;
+    }
+    return static_cast<unsigned int>(intervalo.tamano);
+}
+
+/**
+ * @brief Con sustituciones todas las cadenas encontradas tienen el largo del
+ *        patrón, así que sus intervalos son disjuntos y basta sumarlos.
+ */
+size_t FMIndexBidireccional::buscarAproximado(const std::string& patron, uint32_t maximo_errores, TipoError tipo) const {
+    if (tipo == TipoError::Ediciones) return localizarAproximado(patron, maximo_errores, tipo).size();
+
+    size_t ocurrencias = 0;
+    for (const auto& encontrado : intervalosAproximados(patron, maximo_errores, tipo)) ocurrencias += encontrado.first.tamano;
+    return ocurrencias;
+}
+
+/**
+ * @brief Con ediciones, una ocurrencia que comienza en p con e errores implica
+ *        ocurrencias en p - 1, ..., p - (k - e) insertando caracteres del
+ *        texto antes del patrón.
+ */
+std::vector<size_t> FMIndexBidireccional::localizarAproximado(const std::string& patron, uint32_t maximo_errores, TipoError tipo) const {
+    std::map<size_t, uint32_t> menor_error;
+    for (const auto& encontrado : intervalosAproximados(patron, maximo_errores, tipo)) {
+        const Intervalo& intervalo = encontrado.first;
+        for (size_t fila = intervalo.directo; fila < intervalo.directo + intervalo.tamano; ++fila) {
+            size_t posicion = posicionDeFila(fila);
+            auto actual = menor_error.find(posicion);
+            if (actual == menor_error.end()) menor_error.emplace(posicion, encontrado.second);
+            else actual->second = std::min(actual->second, encontrado.second);
+        }
+    }
+
+    std::vector<size_t> posiciones;
+    for (const auto& [posicion, errores] : menor_error) {
+        size_t holgura = (tipo == TipoError::Ediciones) ? std::min<size_t>(maximo_errores - errores, posicion) : 0;
+        for (size_t d = 0; d <= holgura; ++d) posiciones.push_back(posicion - d);
+    }
+    std::sort(posiciones.begin(), posiciones.end());
+    posiciones.erase(std::unique(posiciones.begin(), posiciones.end()), posiciones.end());
+    return posiciones;
+}
+
+/**
+ * @brief Cada paso LF retrocede una posición en el texto; al llegar a una fila
+ *        muestreada se suma la cantidad de pasos a su posición guardada.
+ */
+size_t FMIndexBidireccional::posicionDeFila(size_t fila) const {
+    size_t pasos = 0;
+    while (!filas_muestreadas_.acceder(fila)) {
+        unsigned char c = directo_.caracterDeFila(fila);
+        fila = tabla_inicio_caracter_[c] + directo_.rangoFilas(c, fila);
+        pasos++;
+    }
+    return muestras_sufijos_[filas_muestreadas_.rango1(fila)] + pasos;
+}
+
+size_t FMIndexBidireccional::getMemoriaBytes() const {
+    return tabla_inicio_caracter_.getMemoriaBytes() + directo_.rango.getMemoriaBytes() + inverso_.rango.getMemoriaBytes()
+         + filas_muestreadas_.getMemoriaBytes() + muestras_sufijos_.getMemoriaBytes() + simbolos_.size();
+}
@@ -0,0 +1,236 @@
+#include "../include/definiciones.hpp"
+#include "../include/fm_index_incremental.hpp"
+#include "../include/traza.hpp"
+#include "../include/knuth_morris_pratt.hpp"
+
+#include <stdexcept>
+
+FMIndexIncremental::FMIndexIncremental(const OpcionesIncremental& opciones)
+    : opciones_(opciones), tramos_(std::make_shared<const Tramos>()) {
+    if (opciones_.capacidad_delta == 0) throw std::invalid_argument("La capacidad del delta debe ser mayor que 0");
+    if (opciones_.factor_fusion < 2) throw std::invalid_argument("El factor de fusión debe ser al menos 2");
+
+    delta_.reserve(opciones_.capacidad_delta);
+    if (opciones_.en_segundo_plano) hilo_ = std::thread(&FMIndexIncremental::trabajar, this);
+}
+
+FMIndexIncremental::FMIndexIncremental(const std::string& texto, const OpcionesIncremental& opciones)
+    : FMIndexIncremental(opciones) {
+    {
+        TRAZAR_FASE("agregar");
+        agregar(texto);
+    }
+    TRAZAR_FASE("esperar_fusiones");
+    esperarFusiones();
+}
+
+FMIndexIncremental::~FMIndexIncremental() {
+    {
+        std::lock_guard<std::mutex> lock(candado_);
+        detener_ = true;
+    }
+    hay_trabajo_.notify_all();
+    if (hilo_.joinable()) hilo_.join();
+}
+
+// ========== Ingesta ==========
+
+/**
+ * @brief El bloque se copia al delta por partes; cada vez que se llena se sella.
+ */
+void FMIndexIncremental::agregar(std::string_view bloque) {
+    bool sellado = false;
+    {
+        std::lock_guard<std::mutex> lock(candado_);
+        if (error_) std::rethrow_exception(error_);
+
+        while (!bloque.empty()) {
+            size_t cabe = std::min(bloque.size(), opciones_.capacidad_delta - delta_.size());
+            size_t inicio = delta_.size();
+            delta_.append(bloque.data(), cabe);
+            if (opciones_.opciones_indice.ignorar_mayusculas) {
+                for (size_t i = inicio; i < delta_.size(); ++i) {
+                    delta_[i] = static_cast<char>(plegarCaracter(static_cast<unsigned char>(delta_[i])));
+                }
+            }
+            longitud_texto_ += cabe;
+            bloque.remove_prefix(cabe);
+
+            if (delta_.size() == opciones_.capacidad_delta) {
+                sellarDelta();
+                sellado = true;
+            }
+        }
+    }
+    if (!sellado) return;
+
+    if (opciones_.en_segundo_plano) hay_trabajo_.notify_one();
+    else while (avanzarMantenimiento()) {}
+}
+
+void FMIndexIncremental::sellarDelta() {
+    auto tramos = std::make_shared<Tramos>(*tramos_);
+    Tramo sellado;
+    sellado.longitud = delta_.size();
+    sellado.texto = std::make_shared<const std::string>(std::move(delta_));
+    tramos->push_back(std::move(sellado));
+    tramos_ = std::move(tramos);
+
+    delta_ = std::string();
+    delta_.reserve(opciones_.capacidad_delta);
+    pendiente_ = true;
+}
+
+// ========== Mantenimiento ==========
+
+/**
+ * @brief Solo este método reemplaza tramos que no son el último, y agregar()
+ *        solo añade al final, así que las posiciones de los tramos que se
+ *        procesan no cambian entre la instantánea y el reemplazo.
+ */
+bool FMIndexIncremental::avanzarMantenimiento() {
+    std::shared_ptr<const Tramos> instantanea;
+    {
+        std::lock_guard<std::mutex> lock(candado_);
+        instantanea = tramos_;
+    }
+    const Tramos& tramos = *instantanea;
+
+    // Los segmentos preceden a los tramos sellados: el primero sin índice es el más antiguo
+    size_t segmentos = 0;
+    while (segmentos < tramos.size() && tramos[segmentos].indice) segmentos++;
+
+    size_t primero = 0, cantidad = 0;
+    std::string texto;
+    if (segmentos < tramos.size()) {
+        // Todos los tramos sellados pendientes forman un único segmento
+        primero = segmentos;
+        cantidad = tramos.size() - segmentos;
+        for (size_t t = primero; t < tramos.size(); ++t) texto += *tramos[t].texto;
+    } else if (segmentos >= 2 && tramos[segmentos - 2].longitud < opciones_.factor_fusion * tramos[segmentos - 1].longitud) {
+        primero = segmentos - 2;
+        cantidad = 2;
+        texto = tramos[primero].indice->extraer(0, tramos[primero].longitud)
+              + tramos[primero + 1].indice->extraer(0, tramos[primero + 1].longitud);
+    } else {
+        return false;
+    }
+
+    Tramo nuevo;
+    nuevo.longitud = texto.size();
+    nuevo.indice = std::make_shared<const FMIndex>(texto, opciones_.opciones_indice);
+    bytes_reconstruidos_ += texto.size();
+
+    std::lock_guard<std::mutex> lock(candado_);
+    auto actualizados = std::make_shared<Tramos>(*tramos_);
+    actualizados->erase(actualizados->begin() + static_cast<std::ptrdiff_t>(primero),
+                        actualizados->begin() + static_cast<std::ptrdiff_t>(primero + cantidad));
+    actualizados->insert(actualizados->begin() + static_cast<std::ptrdiff_t>(primero), std::move(nuevo));
+    tramos_ = std::move(actualizados);
+    return true;
+}
+
+void FMIndexIncremental::trabajar() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(candado_);
+            hay_trabajo_.wait(lock, [this]() { return detener_ || pendiente_; });
+            if (detener_) return;
+            pendiente_ = false;
+            ocupado_ = true;
+        }
+
+        std::exception_ptr error;
+        try {
+            while (avanzarMantenimiento()) {}
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(candado_);
+            if (error && !error_) error_ = error;
+            ocupado_ = false;
+        }
+        sin_trabajo_.notify_all();
+    }
+}
+
+void FMIndexIncremental::esperarFusiones() {
+    if (!opciones_.en_segundo_plano) return;
+
+    std::unique_lock<std::mutex> lock(candado_);
+    sin_trabajo_.wait(lock, [this]() { return (!pendiente_ && !ocupado_) || error_; });
+    if (error_) std::rethrow_exception(error_);
+}
+
+// ========== Consultas ==========
+
+std::string FMIndexIncremental::extraerTramo(const Tramo& tramo, size_t inicio, size_t largo) {
+    if (tramo.indice) return tramo.indice->extraer(inicio, largo);
+    return tramo.texto->substr(inicio, largo);
+}
+
+size_t FMIndexIncremental::contarEnTramo(const Tramo& tramo, const std::string& patron) {
+    if (tramo.indice) return tramo.indice->buscar(patron);
+    return KnuthMorrisPratt::buscarEnSegmento(*tramo.texto, patron);
+}
+
+/**
+ * @brief El delta se recorre con el candado tomado (es pequeño); el resto se
+ *        consulta sobre la instantánea, sin bloquear a agregar().
+ */
+unsigned int FMIndexIncremental::buscar(const std::string& patron_original) const {
+    if (patron_original.empty()) return 0;
+    const std::string patron = opciones_.opciones_indice.ignorar_mayusculas ? plegarCaso(patron_original) : patron_original;
+    size_t solape = patron.size() - 1;
+
+    std::shared_ptr<const Tramos> instantanea;
+    std::string inicio_delta;
+    size_t ocurrencias = 0;
+    {
+        std::lock_guard<std::mutex> lock(candado_);
+        instantanea = tramos_;
+        ocurrencias += KnuthMorrisPratt::buscarEnSegmento(delta_, patron);
+        inicio_delta = delta_.substr(0, solape);
+    }
+    const Tramos& tramos = *instantanea;
+
+    rep(t, tramos.size()) {
+        const Tramo& tramo = tramos[t];
+        ocurrencias += contarEnTramo(tramo, patron);
+        if (solape == 0) continue;
+
+        // Ocurrencias que comienzan en los últimos m - 1 bytes del tramo y terminan después
+        size_t largo_cola = std::min(solape, tramo.longitud);
+        std::string ventana = extraerTramo(tramo, tramo.longitud - largo_cola, largo_cola);
+        for (size_t siguiente = t + 1; siguiente < tramos.size() && ventana.size() < largo_cola + solape; ++siguiente) {
+            ventana += extraerTramo(tramos[siguiente], 0, largo_cola + solape - ventana.size());
+        }
+        if (ventana.size() < largo_cola + solape) ventana += inicio_delta.substr(0, largo_cola + solape - ventana.size());
+
+        for (size_t inicio = 0; inicio < largo_cola && inicio + patron.size() <= ventana.size(); ++inicio) {
+            if (ventana.compare(inicio, patron.size(), patron) == 0) ocurrencias++;
+        }
+    }
+    return static_cast<unsigned int>(ocurrencias);
+}
+
+size_t FMIndexIncremental::getLongitudTexto() const {
+    std::lock_guard<std::mutex> lock(candado_);
+    return longitud_texto_;
+}
+
+size_t FMIndexIncremental::getCantidadSegmentos() const {
+    std::lock_guard<std::mutex> lock(candado_);
+    size_t segmentos = 0;
+    for (const auto& tramo : *tramos_) segmentos += tramo.indice ? 1 : 0;
+    return segmentos;
+}
+
+size_t FMIndexIncremental::getMemoriaBytes() const {
+    std::lock_guard<std::mutex> lock(candado_);
+    size_t total = delta_.capacity();
+    for (const auto& tramo : *tramos_) total += tramo.indice ? tramo.indice->getMemoriaBytes() : tramo.texto->size();
+    return total;
+}
@@ -0,0 +1,214 @@
+#include "../include/definiciones.hpp"
+#include "../include/fm_index_rl.hpp"
+#include "../include/traza.hpp"
+
+FMIndexRL::FMIndexRL(const std::string& texto, bool ignorar_mayusculas)
+    : FMIndexRL(construirTransformadaBWT(ignorar_mayusculas ? plegarCaso(texto) : texto), ignorar_mayusculas) {}
+
+/**
+ * @brief Recorre las filas de la BWT agrupándolas en runs y deriva de cada
+ *        borde de run las muestras de SA y de phi; el arreglo de sufijos
+ *        completo y el inverso solo viven durante la construcción.
+ */
+FMIndexRL::FMIndexRL(const TransformadaBWT& transformada, bool ignorar_mayusculas)
+    : longitud_texto_(transformada.longitud()), ignorar_mayusculas_(ignorar_mayusculas) {
+    size_t cantidad_filas = longitud_texto_ + 1;
+    tabla_inicio_caracter_ = ArregloPlano<uint64_t>(construirTablaInicioCaracter(transformada.bwt));
+
+    auto codigoDeFila = [&](size_t fila) -> uint32_t {
+        return transformada.esCentinela(fila) ? 0 : static_cast<uint32_t>(transformada.caracterDeFila(fila)) + 1;
+    };
+
+    // Runs: fila de inicio, código y posición de texto de la última fila
+    std::vector<uint64_t> inicios_runs;
+    std::vector<uint32_t> codigos_runs;
+    std::vector<uint64_t> muestras_fin_run;
+    {
+        TRAZAR_FASE("runs");
+        for (size_t fila = 0; fila < cantidad_filas; ++fila) {
+            uint32_t codigo = codigoDeFila(fila);
+            if (fila > 0 && codigo == codigos_runs.back()) continue;
+
+            if (fila > 0) muestras_fin_run.push_back(transformada.sufijoDeFila(fila - 1));
+            inicios_runs.push_back(fila);
+            codigos_runs.push_back(codigo);
+        }
+        muestras_fin_run.push_back(transformada.sufijoDeFila(cantidad_filas - 1));
+        inicios_runs.push_back(cantidad_filas);
+    }
+    size_t cantidad_runs = codigos_runs.size();
+
+    // Runs agrupados por código y largos acumulados de cada grupo
+    std::vector<uint64_t> desplazamiento_codigo(258, 0);
+    std::vector<uint64_t> runs_por_codigo(cantidad_runs);
+    std::vector<uint64_t> largos_acumulados(cantidad_runs + 257, 0);
+    {
+        TRAZAR_FASE("runs_por_codigo");
+        for (uint32_t codigo : codigos_runs) desplazamiento_codigo[codigo + 1]++;
+        for (size_t codigo = 1; codigo < desplazamiento_codigo.size(); ++codigo) {
+            desplazamiento_codigo[codigo] += desplazamiento_codigo[codigo - 1];
+        }
+
+        std::vector<uint64_t> siguiente(desplazamiento_codigo.begin(), desplazamiento_codigo.end() - 1);
+        rep(run, cantidad_runs) {
+            runs_por_codigo[siguiente[codigos_runs[run]]++] = run;
+        }
+
+        rep(codigo, 257) {
+            size_t base = desplazamiento_codigo[codigo] + codigo;
+            size_t cantidad = desplazamiento_codigo[codigo + 1] - desplazamiento_codigo[codigo];
+            rep(k, cantidad) {
+                size_t run = runs_por_codigo[desplazamiento_codigo[codigo] + k];
+                largos_acumulados[base + k + 1] = largos_acumulados[base + k] + inicios_runs[run + 1] - inicios_runs[run];
+            }
+        }
+    }
+
+    // phi(SA[p] - 1) para cada inicio de run p: SA de la fila anterior a la de SA[p] - 1
+    std::vector<std::pair<uint64_t, uint64_t>> pares_phi;
+    {
+        TRAZAR_FASE("muestras_phi");
+        std::vector<uint32_t> inverso(cantidad_filas);
+        rep(fila, cantidad_filas) {
+            inverso[transformada.sufijoDeFila(fila)] = static_cast<uint32_t>(fila);
+        }
+
+        pares_phi.reserve(cantidad_runs);
+        rep(run, cantidad_runs) {
+            size_t posicion = transformada.sufijoDeFila(inicios_runs[run]);
+            if (posicion == 0) continue;
+
+            size_t fila_anterior = inverso[posicion - 1] - 1;  // posicion - 1 < n: su fila no es la 0
+            pares_phi.emplace_back(posicion - 1, transformada.sufijoDeFila(fila_anterior));
+        }
+        std::sort(pares_phi.begin(), pares_phi.end());
+    }
+
+    std::vector<uint64_t> claves_phi(pares_phi.size());
+    std::vector<uint64_t> valores_phi(pares_phi.size());
+    rep(i, pares_phi.size()) {
+        claves_phi[i] = pares_phi[i].first;
+        valores_phi[i] = pares_phi[i].second;
+    }
+
+    inicios_runs_ = ArregloPlano<uint64_t>(inicios_runs);
+    codigos_runs_ = ArregloPlano<uint16_t>(std::vector<uint16_t>(codigos_runs.begin(), codigos_runs.end()));
+    cabezas_runs_ = WaveletMatrix(codigos_runs);
+    desplazamiento_codigo_ = ArregloPlano<uint64_t>(desplazamiento_codigo);
+    runs_por_codigo_ = ArregloPlano<uint64_t>(runs_por_codigo);
+    largos_acumulados_ = ArregloPlano<uint64_t>(largos_acumulados);
+    muestras_fin_run_ = ArregloPlano<uint64_t>(muestras_fin_run);
+    claves_phi_ = ArregloPlano<uint64_t>(claves_phi);
+    valores_phi_ = ArregloPlano<uint64_t>(valores_phi);
+}
+
+/**
+ * @brief Búsqueda binaria del último run que comienza en o antes de la fila.
+ */
+size_t FMIndexRL::runDeFila(size_t fila) const {
+    auto siguiente = std::upper_bound(inicios_runs_.begin(), inicios_runs_.end(), static_cast<uint64_t>(fila));
+    return static_cast<size_t>(siguiente - inicios_runs_.begin()) - 1;
+}
+
+/**
+ * @brief Largos de los runs del código anteriores al run de la fila i - 1,
+ *        más la parte de ese run si también es del código.
+ */
+size_t FMIndexRL::rango(uint32_t codigo, size_t i) const {
+    if (i == 0) return 0;
+
+    size_t run = runDeFila(i - 1);
+    size_t cuenta = largoAcumulado(codigo, cabezas_runs_.rangoCodigo(codigo, run));
+    if (codigos_runs_[run] == codigo) cuenta += i - static_cast<size_t>(inicios_runs_[run]);
+    return cuenta;
+}
+
+/**
+ * @brief phi(x) = phi(z) - (z - x), con z la menor clave mayor o igual a x:
+ *        entre x y z ninguna fila es inicio de run.
+ */
+size_t FMIndexRL::phi(size_t posicion) const {
+    auto clave = std::lower_bound(claves_phi_.begin(), claves_phi_.end(), static_cast<uint64_t>(posicion));
+    size_t indice = static_cast<size_t>(clave - claves_phi_.begin());
+    return static_cast<size_t>(valores_phi_[indice] - (claves_phi_[indice] - posicion));
+}
+
+/**
+ * @brief Búsqueda backward con rango por runs.
+ */
+unsigned int FMIndexRL::buscar(const std::string& patron) const {
+    if (patron.empty()) return 0;
+
+    size_t inicio = 0;
+    size_t fin = longitud_texto_ + 1;
+    for (size_t j = patron.size(); j-- > 0;) {
+        unsigned char caracter = caracterPatron(patron[j]);
+        uint32_t codigo = static_cast<uint32_t>(caracter) + 1;
+        inicio = tabla_inicio_caracter_[caracter] + rango(codigo, inicio);
+        fin = tabla_inicio_caracter_[caracter] + rango(codigo, fin);
+        if (inicio >= fin) return 0;
+    }
+    return static_cast<unsigned int>(fin - inicio);
+}
+
+/**
+ * @brief Búsqueda backward que mantiene SA de la última fila del intervalo
+ *        y luego recorre el intervalo hacia arriba con phi.
+ */
+std::vector<size_t> FMIndexRL::localizar(const std::string& patron) const {
+    std::vector<size_t> posiciones;
+    if (patron.empty()) return posiciones;
+
+    size_t inicio = 0;
+    size_t fin = longitud_texto_ + 1;
+    size_t posicion_fin = muestras_fin_run_[muestras_fin_run_.size() - 1];  // La fila n cierra el último run
+
+    for (size_t j = patron.size(); j-- > 0;) {
+        unsigned char caracter = caracterPatron(patron[j]);
+        uint32_t codigo = static_cast<uint32_t>(caracter) + 1;
+
+        size_t run = runDeFila(fin - 1);
+        if (codigos_runs_[run] == codigo) {
+            posicion_fin--;
+        } else {
+            // La última aparición del carácter antes de fin cierra un run muestreado
+            size_t runs_previos = cabezas_runs_.rangoCodigo(codigo, run);
+            if (runs_previos == 0) return posiciones;
+
+            size_t run_caracter = static_cast<size_t>(runs_por_codigo_[indiceRunDeCodigo(codigo, runs_previos - 1)]);
+            if (inicios_runs_[run_caracter + 1] <= inicio) return posiciones;
+            posicion_fin = static_cast<size_t>(muestras_fin_run_[run_caracter]) - 1;
+        }
+
+        inicio = tabla_inicio_caracter_[caracter] + rango(codigo, inicio);
+        fin = tabla_inicio_caracter_[caracter] + rango(codigo, fin);
+    }
+
+    posiciones.reserve(fin - inicio);
+    posiciones.push_back(posicion_fin);
+    for (size_t fila = fin - 1; fila > inicio; --fila) {
+        posiciones.push_back(phi(posiciones.back()));
+    }
+    std::sort(posiciones.begin(), posiciones.end());
+    return posiciones;
+}
+
+size_t FMIndexRL::getMemoriaBytes() const {
+    return tabla_inicio_caracter_.getMemoriaBytes() + inicios_runs_.getMemoriaBytes()
+         + codigos_runs_.getMemoriaBytes() + cabezas_runs_.getMemoriaBytes()
+         + desplazamiento_codigo_.getMemoriaBytes() + runs_por_codigo_.getMemoriaBytes()
+         + largos_acumulados_.getMemoriaBytes() + muestras_fin_run_.getMemoriaBytes()
+         + claves_phi_.getMemoriaBytes() + valores_phi_.getMemoriaBytes();
+}
+
+/**
+ * @brief Elige la variante por la proporción de runs de la BWT.
+ */
+std::unique_ptr<BaseStructure> crearIndiceFM(const std::string& texto, double umbral_runs, const OpcionesFMIndex& opciones) {
+    TransformadaBWT transformada = construirTransformadaFM(texto, opciones);
+    double proporcion_runs = texto.empty() ? 1.0
+                           : static_cast<double>(contarRunsBWT(transformada)) / static_cast<double>(texto.size());
+
+    if (proporcion_runs < umbral_runs) return std::make_unique<FMIndexRL>(transformada, opciones.ignorar_mayusculas);
+    return std::make_unique<FMIndex>(transformada, opciones);
+}
@@ -0,0 +1,82 @@
+#include "../include/definiciones.hpp"
+#include "../include/indice_documentos.hpp"
+#include "../include/traza.hpp"
+
+#include <stdexcept>
+
+IndiceDocumentos::IndiceDocumentos(const std::vector<std::string>& documentos, const OpcionesFMIndex& opciones)
+    : cantidad_documentos_(documentos.size()) {
+    if (documentos.empty()) throw std::invalid_argument("La colección debe tener al menos un documento");
+
+    // Cada documento seguido del separador; fin_documento[d] es la posición de su separador
+    std::string coleccion;
+    std::vector<size_t> fin_documento;
+    fin_documento.reserve(documentos.size());
+    for (const auto& documento : documentos) {
+        if (documento.find(SEPARADOR_DOCUMENTOS) != std::string::npos) {
+            throw std::invalid_argument("El documento " + std::to_string(fin_documento.size()) + " contiene el separador de documentos");
+        }
+        coleccion += documento;
+        fin_documento.push_back(coleccion.size());
+        coleccion.push_back(SEPARADOR_DOCUMENTOS);
+    }
+
+    TransformadaBWT transformada = construirTransformadaFM(coleccion, opciones);
+
+    // El sufijo de cada fila pertenece al primer documento cuyo separador está en o después de él
+    std::vector<uint32_t> documento_de_fila(transformada.longitud() + 1);
+    {
+        TRAZAR_FASE("documento_de_fila");
+        rep(fila, documento_de_fila.size()) {
+            size_t posicion = transformada.sufijoDeFila(fila);
+            auto documento = std::lower_bound(fin_documento.begin(), fin_documento.end(), posicion);
+            if (documento == fin_documento.end()) documento--;  // Sufijo vacío de la fila 0
+            documento_de_fila[fila] = static_cast<uint32_t>(documento - fin_documento.begin());
+        }
+    }
+
+    indice_ = std::make_unique<FMIndex>(transformada, opciones);
+    documentos_ = WaveletMatrix(documento_de_fila);
+}
+
+std::pair<size_t, size_t> IndiceDocumentos::intervalo(const std::string& patron) const {
+    if (patron.find(SEPARADOR_DOCUMENTOS) != std::string::npos) return {0, 0};
+    return indice_->intervaloFilas(patron);
+}
+
+unsigned int IndiceDocumentos::buscar(const std::string& patron) const {
+    auto filas = intervalo(patron);
+    return static_cast<unsigned int>(filas.second - filas.first);
+}
+
+std::vector<OcurrenciasDocumento> IndiceDocumentos::contarPorDocumento(const std::string& patron) const {
+    auto filas = intervalo(patron);
+
+    std::vector<OcurrenciasDocumento> conteos;
+    for (const auto& frecuencia : documentos_.frecuenciasEnRango(filas.first, filas.second)) {
+        conteos.push_back({frecuencia.first, frecuencia.second});
+    }
+    return conteos;
+}
+
+std::vector<size_t> IndiceDocumentos::listarDocumentos(const std::string& patron) const {
+    auto filas = intervalo(patron);
+
+    std::vector<size_t> listado;
+    for (const auto& frecuencia : documentos_.frecuenciasEnRango(filas.first, filas.second)) listado.push_back(frecuencia.first);
+    return listado;
+}
+
+std::vector<OcurrenciasDocumento> IndiceDocumentos::documentosMasFrecuentes(const std::string& patron, size_t k) const {
+    auto filas = intervalo(patron);
+
+    std::vector<OcurrenciasDocumento> frecuentes;
+    for (const auto& frecuencia : documentos_.masFrecuentesEnRango(filas.first, filas.second, k)) {
+        frecuentes.push_back({frecuencia.first, frecuencia.second});
+    }
+    return frecuentes;
+}
+
+size_t IndiceDocumentos::getMemoriaBytes() const {
+    return indice_->getMemoriaBytes() + documentos_.getMemoriaBytes();
+}
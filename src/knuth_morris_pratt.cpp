@@ -1,29 +1,25 @@
 #include "../include/definiciones.hpp"
 #include "../include/knuth_morris_pratt.hpp"
+#include "../include/contadores.hpp"
 
 unsigned int KnuthMorrisPratt::buscar(const std::string& texto, const std::string& patron) {
-    vc tabla_de_saltos = calcularTablaDeSaltos(patron);
-
-    size_t posicion_patron = 0;
-    unsigned int ocurrencias = 0;
+    return PatronKnuthMorrisPratt(patron).buscar(texto);
+}
 
-    // Leer carácter por carácter
-    for (char caracter : texto) {
-        while (posicion_patron > 0 && caracter != patron[posicion_patron]) {
-            posicion_patron = tabla_de_saltos[posicion_patron - 1];
-        }
+unsigned int KnuthMorrisPratt::buscarSinMayusculas(const std::string& texto, const std::string& patron) {
+    return PatronKnuthMorrisPratt(patron, true).buscar(texto);
+}
 
-        if (caracter == patron[posicion_patron]) {
-            posicion_patron++;
-        }
+unsigned int KnuthMorrisPratt::buscarEnSegmento(std::string_view segmento, const std::string& patron) {
+    return PatronKnuthMorrisPratt(patron).buscar(segmento);
+}
 
-        if (posicion_patron == patron.size()) {
-            ocurrencias++;
-            posicion_patron = tabla_de_saltos[posicion_patron - 1];
-        }
-    }
+unsigned int KnuthMorrisPratt::buscarAutomata(const std::string& texto, const std::string& patron) {
+    return PatronKnuthMorrisPratt(patron, false, true).buscar(texto);
+}
 
-    return ocurrencias;   // Retorna la cantidad de ocurrencias encontradas
+unsigned int KnuthMorrisPratt::buscarAutomataEnSegmento(std::string_view segmento, const std::string& patron) {
+    return PatronKnuthMorrisPratt(patron, false, true).buscar(segmento);
 }
 
 vc KnuthMorrisPratt::calcularTablaDeSaltos(const std::string& patron) {
@@ -44,3 +40,105 @@ vc KnuthMorrisPratt::calcularTablaDeSaltos(const std::string& patron) {
     
     return tabla_de_saltos;
 }
+
+PatronKnuthMorrisPratt::PatronKnuthMorrisPratt(const std::string& patron, bool ignorar_mayusculas,
+                                               bool usar_automata, size_t presupuesto_automata)
+    : patron_(ignorar_mayusculas ? plegarCaso(patron) : patron), ignorar_mayusculas_(ignorar_mayusculas),
+      tabla_de_saltos_(KnuthMorrisPratt::calcularTablaDeSaltos(patron_)) {
+    if (!usar_automata || patron_.empty()) return;
+
+    // Una clase por byte distinto del patrón, más la clase 0 para los ausentes
+    std::array<bool, 256> presente{};
+    for (char caracter : patron_) presente[static_cast<unsigned char>(caracter)] = true;
+    size_t cantidad_clases = 1;
+    for (bool esta : presente) cantidad_clases += esta;
+
+    size_t bytes_automata = (patron_.size() + 1) * cantidad_clases * sizeof(uint32_t) + sizeof(clases_);
+    if (bytes_automata <= presupuesto_automata) construirAutomata(cantidad_clases);
+}
+
+void PatronKnuthMorrisPratt::construirAutomata(size_t cantidad_clases) {
+    size_t largo = patron_.size();
+
+    std::array<uint16_t, 256> clase_de_byte{};
+    uint16_t siguiente_clase = 1;
+    for (char caracter : patron_) {
+        unsigned char byte = static_cast<unsigned char>(caracter);
+        if (clase_de_byte[byte] == 0) clase_de_byte[byte] = siguiente_clase++;
+    }
+
+    // El texto se pliega al clasificarlo, de modo que la búsqueda no pliega nada
+    rep(byte, 256) {
+        unsigned char plegado = ignorar_mayusculas_ ? plegarCaracter(static_cast<unsigned char>(byte)) : static_cast<unsigned char>(byte);
+        clases_[byte] = clase_de_byte[plegado];
+    }
+
+    std::vector<uint16_t> clase_patron(largo);
+    rep(q, largo) clase_patron[q] = clase_de_byte[static_cast<unsigned char>(patron_[q])];
+
+    // delta(q, c) = q + 1 si patron[q] es de la clase c; si no, delta(falla(q), c).
+    // La falla de q es tabla_de_saltos_[q - 1] < q, cuya fila ya está completa.
+    automata_.assign((largo + 1) * cantidad_clases, 0);
+    rep(q, largo + 1) {
+        uint32_t* fila = &automata_[q * cantidad_clases];
+        if (q > 0) {
+            const uint32_t* fila_falla = &automata_[tabla_de_saltos_[q - 1] * cantidad_clases];
+            std::copy(fila_falla, fila_falla + cantidad_clases, fila);
+        }
+        if (static_cast<size_t>(q) < largo) fila[clase_patron[q]] = static_cast<uint32_t>((q + 1) * cantidad_clases);
+    }
+    estado_final_ = static_cast<uint32_t>(largo * cantidad_clases);
+}
+
+size_t PatronKnuthMorrisPratt::getMemoriaAutomataBytes() const {
+    return automata_.empty() ? 0 : automata_.size() * sizeof(uint32_t) + sizeof(clases_);
+}
+
+unsigned int PatronKnuthMorrisPratt::buscar(std::string_view texto) const {
+    if (usaAutomata()) return buscarAutomata(texto);
+    return ignorar_mayusculas_ ? buscarCon(texto, PlegadoMinusculas()) : buscarCon(texto, SinPlegado());
+}
+
+unsigned int PatronKnuthMorrisPratt::buscarAutomata(std::string_view texto) const {
+    const uint32_t* automata = automata_.data();
+    uint32_t estado = 0;
+    unsigned int ocurrencias = 0;
+
+    for (char caracter : texto) {
+        estado = automata[estado + clases_[static_cast<unsigned char>(caracter)]];
+        ocurrencias += (estado == estado_final_);
+    }
+
+    return ocurrencias;
+}
+
+template<typename Plegado>
+unsigned int PatronKnuthMorrisPratt::buscarCon(std::string_view texto, Plegado plegar) const {
+    const std::string& patron = patron_;
+    const vc& tabla_de_saltos = tabla_de_saltos_;
+    if (patron.empty()) return 0;
+
+    size_t posicion_patron = 0;
+    unsigned int ocurrencias = 0;
+
+    // Leer carácter por carácter
+    for (char original : texto) {
+        char caracter = static_cast<char>(plegar(static_cast<unsigned char>(original)));
+        while (posicion_patron > 0 && caracter != patron[posicion_patron]) {
+            posicion_patron = tabla_de_saltos[posicion_patron - 1];
+            CONTAR_MOTOR(enlaces_falla_kmp, 1);
+        }
+
+        if (caracter == patron[posicion_patron]) {
+            posicion_patron++;
+        }
+
+        if (posicion_patron == patron.size()) {
+            ocurrencias++;
+            posicion_patron = tabla_de_saltos[posicion_patron - 1];
+            CONTAR_MOTOR(enlaces_falla_kmp, 1);
+        }
+    }
+
+    return ocurrencias;   // Retorna la cantidad de ocurrencias encontradas
+}
@@ -3,12 +3,20 @@
 #include "../include/class_base.hpp"
 #include "../include/boyer_moore.hpp"
 #include "../include/fm_index.hpp"
+#include "../include/fm_index_rl.hpp"
+#include "../include/fm_index_bidireccional.hpp"
+#include "../include/fm_index_incremental.hpp"
 #include "../include/knuth_morris_pratt.hpp"
 #include "../include/robin_karp.hpp"
+#include "../include/two_way.hpp"
+#include "../include/myers.hpp"
+#include "../include/busqueda_paralela.hpp"
+#include "../include/busqueda_flujo.hpp"
 #include "../include/suffix_trees.hpp"
 #include "../include/suffix_arrays.hpp"
 #include "../include/json.hpp"
 #include "../include/medidor.hpp"
+#include "../include/benchmarks.hpp"
 
 #include <set>
 #include <functional>
@@ -16,13 +24,17 @@
 #include <sstream>
 #include <fstream>
 #include <filesystem>
+#include <thread>
 
 namespace fs = std::filesystem;
 
 using json = nlohmann::json;
 
 #define NOMBRE_CARPETA_TESTS fs::path("test/textos")
+#define NOMBRE_CARPETA_INDICES fs::path("test/indices")
 #define ITERACIONES 40
+#define LARGO_KMER_BENCHMARK 6     // Solo los 6-mers que aparecen: a lo más n entradas
+#define SUFIJO_SIN_MAYUSCULAS "SinMayusculas"
 
 /**
  * @brief Función encargada de obtener todos los archivos .bin de una determinada carpeta
@@ -55,20 +67,279 @@ std::vector<fs::path> archivosEnCarpeta() {
     return nombres_archivos;
 }
 
-int main() {
+/**
+ * @brief Asegura que exista el FM-Index persistido de un archivo de texto.
+ * 
+ * Si el índice no existe, es más antiguo que el texto o no puede cargarse
+ * (por ejemplo, fue guardado con otra versión del formato), se construye y
+ * se guarda en NOMBRE_CARPETA_INDICES. Las iteraciones del benchmark luego
+ * solo lo cargan mediante mmap.
+ * 
+ * @param archivo_texto Ruta del archivo de texto.
+ * @return Ruta del archivo de índice.
+ */
+fs::path prepararIndicePersistido(const fs::path& archivo_texto) {
+    fs::create_directories(NOMBRE_CARPETA_INDICES);
+    fs::path ruta_indice = NOMBRE_CARPETA_INDICES / (archivo_texto.stem().string() + ".fmi");
+
+    bool reconstruir = !fs::exists(ruta_indice) || fs::last_write_time(ruta_indice) < fs::last_write_time(archivo_texto);
+    if (!reconstruir) {
+        try {
+            FMIndex::cargar(ruta_indice.string());
+        } catch (const std::exception&) {
+            reconstruir = true;
+        }
+    }
+
+    if (reconstruir) {
+        FMIndex(leerArchivo(archivo_texto.string())).guardar(ruta_indice.string());
+    }
+    return ruta_indice;
+}
+
+/**
+ * @brief Ejecuta un modo de microbenchmark si se pidió por línea de comandos.
+ * 
+ * Modos disponibles:
+ * - `bitvector [max_bits]`: rango y selección de BitVector (por defecto hasta 1e10 bits).
+ * - `lote [longitud_texto]`: buscar contra buscarLote de FMIndex (por defecto 1e7 caracteres).
+ * - `cache [longitud_texto] [exponente_zipf]`: FMIndex con y sin CacheConsultas ante
+ *   consultas Zipf (por defecto 1e7 caracteres y exponente 1).
+ * - `concurrente [longitud_texto] [max_hilos]`: consultas por segundo con 1 a max_hilos
+ *   hilos sobre un mismo índice (por defecto 1e7 caracteres y todos los núcleos).
+ * - `escaneo [longitud_texto] [max_hilos]`: algoritmos en línea secuenciales contra
+ *   contarParalelo (por defecto 2e9 caracteres y todos los núcleos).
+ * - `construccion [longitud_texto] [max_hilos]`: fases de la construcción del FM-Index con 1 a
+ *   max_hilos hilos (por defecto 1e7 caracteres y todos los núcleos).
+ * - `externa [longitud_texto] [memoria_mb]`: FMIndex::construirExterno con un presupuesto de
+ *   memoria_mb MiB contra la construcción en memoria (por defecto 1e7 caracteres y 64 MiB).
+ * - `flujo <patron> [archivo|-] [kmp|shiftand|robinkarp]`: cuenta el patrón leyendo el
+ *   archivo (o la entrada estándar) por bloques, en memoria constante.
+ * - `lineas [cantidad_lineas]`: buscar() contra el patrón preprocesado en líneas cortas
+ *   (por defecto 1e6 líneas).
+ * - `peorcaso [longitud_texto]`: algoritmos en línea con patrones periódicos sobre un
+ *   texto de solo 'a' (por defecto 1e6 caracteres).
+ * - `aproximada [max_ediciones]`: búsqueda aproximada de Myers con k = 0 .. max_ediciones
+ *   contra la exacta sobre los textos de prueba (por defecto k hasta 3).
+ * - `kmer [largo_patron]`: FMIndex con tablas de k-mers de largo 0 a 8 sobre los textos de
+ *   prueba (por defecto patrones de 12 caracteres).
+ * - `bidireccional [longitud_texto] [max_errores]`: búsqueda aproximada con FMIndexBidireccional
+ *   contra recorrer el texto (por defecto 1e7 caracteres y k hasta 2).
+ * - `incremental [longitud_total] [tamano_bloque]`: ingesta por bloques en FMIndexIncremental
+ *   contra reconstruir el FMIndex completo (por defecto 2e7 caracteres en bloques de 1e5).
+ * - `documentos <patron> [k]`: un único índice sobre todos los textos de prueba con conteo
+ *   por documento, listado y los k documentos más frecuentes (por defecto k = 3).
+ * 
+ * @return true si se ejecutó un modo y el programa debe terminar.
+ */
+bool ejecutarModoBenchmark(int argc, char* argv[]) {
+    if (argc < 2) return false;
+    std::string modo = argv[1];
+
+    if (modo == "bitvector") {
+        uint64_t max_bits = (argc >= 3) ? static_cast<uint64_t>(std::stod(argv[2])) : 10000000000ULL;
+        ejecutarBenchmarkBitVector(max_bits);
+        return true;
+    }
+
+    if (modo == "lote") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 10000000;
+        ejecutarBenchmarkLote(longitud_texto);
+        return true;
+    }
+
+    if (modo == "cache") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 10000000;
+        double exponente_zipf = (argc >= 4) ? std::stod(argv[3]) : 1.0;
+        ejecutarBenchmarkCache(longitud_texto, exponente_zipf);
+        return true;
+    }
+
+    if (modo == "concurrente") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 10000000;
+        size_t max_hilos = (argc >= 4) ? static_cast<size_t>(std::stoul(argv[3]))
+                                       : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        ejecutarBenchmarkConcurrente(longitud_texto, max_hilos);
+        return true;
+    }
+
+    if (modo == "escaneo") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 2000000000;
+        size_t max_hilos = (argc >= 4) ? static_cast<size_t>(std::stoul(argv[3]))
+                                       : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        ejecutarBenchmarkEscaneo(longitud_texto, max_hilos);
+        return true;
+    }
+
+    if (modo == "construccion") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 10000000;
+        size_t max_hilos = (argc >= 4) ? static_cast<size_t>(std::stoul(argv[3]))
+                                       : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        ejecutarBenchmarkConstruccion(longitud_texto, max_hilos);
+        return true;
+    }
+
+    if (modo == "externa") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 10000000;
+        size_t memoria_mb = (argc >= 4) ? static_cast<size_t>(std::stoul(argv[3])) : 64;
+        ejecutarBenchmarkExterna(longitud_texto, memoria_mb);
+        return true;
+    }
+
+    if (modo == "lineas") {
+        size_t cantidad_lineas = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 1000000;
+        ejecutarBenchmarkLineas(cantidad_lineas);
+        return true;
+    }
+
+    if (modo == "peorcaso") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 1000000;
+        ejecutarBenchmarkPeorCaso(longitud_texto);
+        return true;
+    }
+
+    if (modo == "aproximada") {
+        unsigned int maximo_ediciones = (argc >= 3) ? static_cast<unsigned int>(std::stoul(argv[2])) : 3;
+        std::vector<std::string> rutas;
+        for (const auto& nombre_archivo : archivosEnCarpeta()) rutas.push_back((NOMBRE_CARPETA_TESTS / nombre_archivo).string());
+        ejecutarBenchmarkAproximada(rutas, maximo_ediciones);
+        return true;
+    }
+
+    if (modo == "kmer") {
+        size_t largo_patron = (argc >= 3) ? static_cast<size_t>(std::stoul(argv[2])) : 12;
+        std::vector<std::string> rutas;
+        for (const auto& nombre_archivo : archivosEnCarpeta()) rutas.push_back((NOMBRE_CARPETA_TESTS / nombre_archivo).string());
+        ejecutarBenchmarkKmer(rutas, largo_patron);
+        return true;
+    }
+
+    if (modo == "bidireccional") {
+        size_t longitud_texto = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 10000000;
+        uint32_t maximo_errores = (argc >= 4) ? static_cast<uint32_t>(std::stoul(argv[3])) : 2;
+        ejecutarBenchmarkBidireccional(longitud_texto, maximo_errores);
+        return true;
+    }
+
+    if (modo == "incremental") {
+        size_t longitud_total = (argc >= 3) ? static_cast<size_t>(std::stod(argv[2])) : 20000000;
+        size_t tamano_bloque = (argc >= 4) ? static_cast<size_t>(std::stod(argv[3])) : 100000;
+        ejecutarBenchmarkIncremental(longitud_total, tamano_bloque);
+        return true;
+    }
+
+    if (modo == "documentos") {
+        if (argc < 3) throw std::invalid_argument("Uso: documentos <patron> [k]");
+        size_t k = (argc >= 4) ? static_cast<size_t>(std::stoul(argv[3])) : 3;
+        std::vector<std::string> rutas;
+        for (const auto& nombre_archivo : archivosEnCarpeta()) rutas.push_back((NOMBRE_CARPETA_TESTS / nombre_archivo).string());
+        ejecutarBenchmarkDocumentos(rutas, argv[2], k);
+        return true;
+    }
+
+    if (modo == "flujo") {
+        if (argc < 3) throw std::invalid_argument("Uso: flujo <patron> [archivo|-] [kmp|shiftand|robinkarp]");
+        std::string patron = argv[2];
+        std::string ruta = (argc >= 4) ? argv[3] : "-";
+        std::string algoritmo = (argc >= 5) ? argv[4] : "kmp";
+
+        std::unique_ptr<BuscadorFlujo> buscador;
+        if (algoritmo == "kmp") buscador = std::make_unique<BuscadorFlujoKMP>(patron);
+        else if (algoritmo == "shiftand") buscador = std::make_unique<BuscadorFlujoShiftAnd>(patron);
+        else if (algoritmo == "robinkarp") buscador = std::make_unique<BuscadorFlujoRobinKarp>(patron);
+        else throw std::invalid_argument("Algoritmo de flujo desconocido: " + algoritmo);
+
+        auto t_inicio = iniciarTimer();
+        uint64_t ocurrencias = 0;
+        if (ruta == "-") {
+            ocurrencias = contarEnFlujo(std::cin, *buscador);
+        } else {
+            std::ifstream archivo(ruta, std::ios::in | std::ios::binary);
+            if (!archivo.is_open()) throw std::ios_base::failure("No se pudo abrir el archivo: " + ruta);
+            ocurrencias = contarEnFlujo(archivo, *buscador);
+        }
+        auto t_fin = detenerTimer();
+
+        double segundos = calcularDuracion(t_inicio, t_fin).count() / 1e3;
+        imprimir(VERDE << ocurrencias << " ocurrencias en " << buscador->getBytesProcesados() << " bytes ("
+                 << static_cast<double>(buscador->getBytesProcesados()) / 1e9 / segundos << " GB/s)" RESET_COLOR);
+        return true;
+    }
+
+    throw std::invalid_argument("Modo de benchmark desconocido: " + modo);
+}
+
+/**
+ * @brief Indica si el motor busca sin distinguir mayúsculas (su nombre termina en SUFIJO_SIN_MAYUSCULAS).
+ * 
+ * Sus conteos no se comparan con los de los motores exactos, sino con el
+ * conteo exacto sobre el texto y el patrón plegados.
+ */
+bool esSinMayusculas(const std::string& nombre) {
+    const std::string sufijo = SUFIJO_SIN_MAYUSCULAS;
+    return nombre.size() >= sufijo.size() && nombre.compare(nombre.size() - sufijo.size(), sufijo.size(), sufijo) == 0;
+}
+
+/**
+ * @brief Conteo en que coinciden todos los motores, o 0 si alguno difiere.
+ */
+unsigned int conteoConsensuado(const std::set<unsigned int>& ocurrencias) {
+    return (ocurrencias.size() == 1) ? *ocurrencias.begin() : 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (ejecutarModoBenchmark(argc, argv)) return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Error en el benchmark: " << e.what() << std::endl;
+        return 1;
+    }
+
     std::string texto, patron;
     solicitarPatron(patron);
 
+    // Patrones preprocesados una vez y reutilizados en todos los archivos e iteraciones
+    const PatronBoyerMoore patron_boyer_moore(patron);
+    const PatronKnuthMorrisPratt patron_knuth_morris_pratt(patron);
+    const PatronRobinKarp patron_robin_karp(patron);
+
     // Archivos en que se buscara el patron
     std::vector<fs::path> nombres_archivos = archivosEnCarpeta();
 
     // Vector de algoritmos de búsqueda de patrones a probar
-    std::vector<std::pair<std::string, unsigned int(*)(const std::string&, const std::string&)>> algoritmos = {
+    std::vector<std::pair<std::string, std::function<unsigned int(const std::string&, const std::string&)>>> algoritmos = {
         {"BoyerMoore", BoyerMoore::buscar},
         {"KnuthMorrisPratt", KnuthMorrisPratt::buscar},
+        {"KnuthMorrisPrattAutomata", KnuthMorrisPratt::buscarAutomata},
         {"RobinKarp", RobinKarp::buscar},
+        {"TwoWay", TwoWay::buscar},
+        {"Myers", [](const std::string& texto, const std::string& patron) { return Myers::buscar(texto, patron, 0); }},
+        {"BoyerMooreSinMayusculas", BoyerMoore::buscarSinMayusculas},
+        {"KnuthMorrisPrattSinMayusculas", KnuthMorrisPratt::buscarSinMayusculas},
+        {"RobinKarpSinMayusculas", RobinKarp::buscarSinMayusculas},
+        {"BoyerMooreParalelo", [](const std::string& texto, const std::string& patron) {
+            return static_cast<unsigned int>(contarParalelo(BoyerMoore::buscarEnSegmento, texto, patron));
+        }},
+        {"KnuthMorrisPrattParalelo", [](const std::string& texto, const std::string& patron) {
+            return static_cast<unsigned int>(contarParalelo(KnuthMorrisPratt::buscarEnSegmento, texto, patron));
+        }},
+        {"RobinKarpParalelo", [](const std::string& texto, const std::string& patron) {
+            return static_cast<unsigned int>(contarParalelo(RobinKarp::buscarEnSegmento, texto, patron));
+        }},
+        {"BoyerMooreCompilado", [&patron_boyer_moore](const std::string& texto, const std::string&) {
+            return patron_boyer_moore.buscar(texto);
+        }},
+        {"KnuthMorrisPrattCompilado", [&patron_knuth_morris_pratt](const std::string& texto, const std::string&) {
+            return patron_knuth_morris_pratt.buscar(texto);
+        }},
+        {"RobinKarpCompilado", [&patron_robin_karp](const std::string& texto, const std::string&) {
+            return patron_robin_karp.buscar(texto);
+        }},
     };
 
+    // Índice persistido del archivo actual, usado por "FMIndexMapeado"
+    fs::path ruta_indice_actual;
+
     std::vector<
         std::pair<
             std::string,
@@ -76,25 +347,45 @@ int main() {
         >
     > estructuras = {
         {"FMIndex",      [](const std::string& texto) { return std::make_unique<FMIndex>(texto); }},
+        {"FMIndexWavelet", [](const std::string& texto) {
+            OpcionesFMIndex opciones;
+            opciones.tipo_rango = TipoRango::Wavelet;
+            return std::make_unique<FMIndex>(texto, opciones);
+        }},
+        {"FMIndexKmer",  [](const std::string& texto) {
+            OpcionesFMIndex opciones;
+            opciones.largo_kmer = LARGO_KMER_BENCHMARK;
+            return std::make_unique<FMIndex>(texto, opciones);
+        }},
+        {"FMIndexSinMayusculas", [](const std::string& texto) {
+            OpcionesFMIndex opciones;
+            opciones.ignorar_mayusculas = true;
+            return std::make_unique<FMIndex>(texto, opciones);
+        }},
+        {"FMIndexRL",    [](const std::string& texto) { return std::make_unique<FMIndexRL>(texto); }},
+        {"FMIndexBidireccional", [](const std::string& texto) { return std::make_unique<FMIndexBidireccional>(texto); }},
+        {"FMIndexIncremental", [](const std::string& texto) { return std::make_unique<FMIndexIncremental>(texto); }},
+        {"FMIndexMapeado", [&ruta_indice_actual](const std::string&) { return FMIndex::cargar(ruta_indice_actual.string()); }},
         {"SuffixArrays", [](const std::string& texto) { return std::make_unique<SuffixArrays>(texto); }},
+        {"SuffixArraysSinMayusculas", [](const std::string& texto) { return std::make_unique<SuffixArrays>(texto, true); }},
         {"SuffixTrees",  [](const std::string& texto) { return std::make_unique<SuffixTrees>(texto); }},
     };
 
     for (const auto& nombre_archivo : nombres_archivos) {
+        try {
+            ruta_indice_actual = prepararIndicePersistido(NOMBRE_CARPETA_TESTS / nombre_archivo);
+        } catch (const std::exception &e) {
+            std::cerr << "Error al preparar el indice persistido: " << e.what() << std::endl;
+            ruta_indice_actual.clear();     // Sin índice propio, "FMIndexMapeado" no se mide en este archivo
+        }
+
         int contador = 0;
         while(contador < ITERACIONES){
             try{
                 fs::path archivo_archivo_completo = NOMBRE_CARPETA_TESTS / nombre_archivo;
 
                 // Carga del texto del archivo
-                std::ifstream archivo(archivo_archivo_completo, std::ios::in);
-                if (!archivo.is_open()) {
-                    throw std::ios_base::failure("No se pudo abrir el archivo: " + archivo_archivo_completo.string());
-                }
-    
-                std::stringstream buffer;
-                buffer << archivo.rdbuf();
-                texto = buffer.str();
+                texto = leerArchivo(archivo_archivo_completo.string());
             
                 if (texto.empty()) {
                     imprimir(AMARILLO "No hay contenido en el archivo: " RESET_COLOR << archivo_archivo_completo.string());
@@ -102,21 +393,24 @@ int main() {
                     continue;
                 }
     
-                // TEST
-                std::vector<unsigned int> ocurrencias_totales;
+                // TEST: los motores exactos deben coincidir entre sí y los sin mayúsculas con
+                // el conteo exacto sobre el texto y el patrón plegados
+                std::set<unsigned int> ocurrencias_exactas;
+                std::set<unsigned int> ocurrencias_sin_mayusculas = {
+                    KnuthMorrisPratt::buscar(plegarCaso(texto), plegarCaso(patron))
+                };
     
                 for (const auto& alg : algoritmos) {
                     unsigned int ocurrencias = medirAlgoritmo(alg.first, alg.second, texto, patron);
-                    ocurrencias_totales.push_back(ocurrencias);
+                    (esSinMayusculas(alg.first) ? ocurrencias_sin_mayusculas : ocurrencias_exactas).insert(ocurrencias);
                 }
     
                 for (const auto& est : estructuras) {
+                    if (est.first == "FMIndexMapeado" && ruta_indice_actual.empty()) continue;
                     unsigned int ocurrencias = medirEstructura(est.first, est.second, texto, patron);
-                    ocurrencias_totales.push_back(ocurrencias);
+                    (esSinMayusculas(est.first) ? ocurrencias_sin_mayusculas : ocurrencias_exactas).insert(ocurrencias);
                 }
     
-                std::set<unsigned int> ocurrencias_unicas(ocurrencias_totales.begin(), ocurrencias_totales.end());
-    
                 size_t memoria_maxima_kb = obtenerMemoriaMaximaKb();
                 
                 std::string nombre_final_json = nombre_archivo.stem().string() + "_" + std::to_string(contador);
@@ -124,7 +418,8 @@ int main() {
                 guardarResultadosFinales(
                     nombre_final_json,
                     patron,
-                    (ocurrencias_unicas.size() == 1) ? *ocurrencias_unicas.begin() : 0,
+                    conteoConsensuado(ocurrencias_exactas),
+                    conteoConsensuado(ocurrencias_sin_mayusculas),
                     memoria_maxima_kb
                 ); 
             }
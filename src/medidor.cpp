@@ -20,15 +20,19 @@ namespace fs = std::filesystem;
 using json = nlohmann::json;
 
 #define NOMBRE_CARPETA_JSON fs::path("test/json")
+#define NOMBRE_CARPETA_TRAZAS fs::path("test/trazas")   // Aparte: analisis.py lee todos los .json de test/json
 
+// Resultados compartidos por todos los hilos, protegidos por mtx
 static json resultados_array = json::array();
-static json resultado_actual;
-static std::string medicion_nombre;
-static std::string medicion_tipo;
-static std::string medicion_patron;
-
 static std::mutex mtx;
 static size_t memoria_acumulada_kb = 0;
+static json eventos_traza = json::array();
+
+// Medición en curso: cada hilo arma la suya hasta guardarResultado
+static thread_local json resultado_actual;
+static thread_local std::string medicion_nombre;
+static thread_local std::string medicion_tipo;
+static thread_local std::string medicion_patron;
 
 static void acumularMemoria(size_t mem_usada) {
     memoria_acumulada_kb += mem_usada;
@@ -70,7 +74,6 @@ size_t obtenerMemoriaMaximaKb() {
 }
 
 void iniciarMedicion(const std::string& nombre, const std::string& tipo, const std::string& patron) {
-    std::lock_guard<std::mutex> lock(mtx);
     medicion_nombre = nombre;
     medicion_tipo = tipo;
     medicion_patron = patron;
@@ -102,12 +105,64 @@ void registrarBusqueda(size_t mem_inicio, size_t mem_fin, std::chrono::duration<
     acumularMemoria(usada);
 }
 
+void registrarMemoriaEstructura(size_t bytes) {
+    resultado_actual["memoria_estructura_bytes"] = bytes;
+}
+
+void registrarFasesConstruccion(const RegistroTraza& traza) {
+    json fases = json::object();
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& evento : traza.getEventos()) {
+        double duracion_ns = static_cast<double>(evento.fin_ns - evento.inicio_ns);
+
+        json chrome;
+        chrome["name"] = evento.nombre;
+        chrome["cat"] = "construccion";
+        chrome["ph"] = "X";
+        chrome["ts"] = static_cast<double>(evento.inicio_ns) / 1000.0;
+        chrome["dur"] = duracion_ns / 1000.0;
+        chrome["pid"] = 0;
+        chrome["tid"] = evento.hilo;
+        eventos_traza.push_back(std::move(chrome));
+
+        if (evento.profundidad == 0) continue;
+        double previo = fases.contains(evento.nombre) ? fases[evento.nombre].get<double>() : 0.0;
+        fases[evento.nombre] = previo + duracion_ns / 1e6;
+    }
+    resultado_actual["fases_construccion_mili"] = fases;
+}
+
+void registrarContadoresMotor() {
+#ifdef CONTADORES_MOTORES
+    const ContadoresMotor& contadores = contadores_motor;
+    json registro;
+    registro["comparaciones_boyer_moore"] = contadores.comparaciones_boyer_moore;
+    registro["desplazamientos_boyer_moore"] = contadores.desplazamientos_boyer_moore;
+    registro["caracteres_desplazados_boyer_moore"] = contadores.caracteres_desplazados_boyer_moore;
+    registro["enlaces_falla_kmp"] = contadores.enlaces_falla_kmp;
+    registro["coincidencias_hash_robin_karp"] = contadores.coincidencias_hash_robin_karp;
+    registro["falsos_positivos_robin_karp"] = contadores.falsos_positivos_robin_karp;
+    registro["llamadas_rango_fm_index"] = contadores.llamadas_rango_fm_index;
+    registro["nodos_visitados_suffix_trees"] = contadores.nodos_visitados_suffix_trees;
+    resultado_actual["contadores_motor"] = registro;
+#endif
+}
+
 void guardarResultado() {
     std::lock_guard<std::mutex> lock(mtx);
-    resultados_array.push_back(resultado_actual);
+    resultados_array.push_back(std::move(resultado_actual));
     resultado_actual = json::object();
 }
 
+json extraerResultados() {
+    std::lock_guard<std::mutex> lock(mtx);
+    json resultados = std::move(resultados_array);
+    resultados_array = json::array();
+    eventos_traza = json::array();
+    memoria_acumulada_kb = 0;
+    return resultados;
+}
+
 void validarCarpetaGuardado() {
     if (!std::filesystem::exists(NOMBRE_CARPETA_JSON)) {
         if(!std::filesystem::create_directory(NOMBRE_CARPETA_JSON)){
@@ -120,11 +175,13 @@ void validarCarpetaGuardado() {
     }
 }
 
-void guardarResultadosFinales(const std::string& nombre_archivo, const std::string& patron, unsigned int ocurrencias, size_t /*memoria_maxima_kb*/) {
+void guardarResultadosFinales(const std::string& nombre_archivo, const std::string& patron, unsigned int ocurrencias,
+                              unsigned int ocurrencias_sin_mayusculas, size_t /*memoria_maxima_kb*/) {
     std::lock_guard<std::mutex> lock(mtx);
 
     std::string clave = "patron: " + patron
                       + ", ocurrencias: " + std::to_string(ocurrencias)
+                      + ", ocurrencias_sin_mayusculas: " + std::to_string(ocurrencias_sin_mayusculas)
                       + ", memoria_total_usada_kb: " + std::to_string(memoria_acumulada_kb);
 
     json salida;
@@ -145,17 +202,32 @@ void guardarResultadosFinales(const std::string& nombre_archivo, const std::stri
     out << std::setw(4) << salida << std::endl;
     out.close();
 
+    if (!eventos_traza.empty()) {
+        fs::create_directories(NOMBRE_CARPETA_TRAZAS);
+        fs::path archivo_traza = NOMBRE_CARPETA_TRAZAS / (nombre_archivo + ".json");
+        std::ofstream out_traza(archivo_traza);
+        if (!out_traza) {
+            throw std::runtime_error("Error abriendo archivo " + archivo_traza.string() + " para escritura\n");
+        }
+        json traza;
+        traza["traceEvents"] = eventos_traza;
+        traza["displayTimeUnit"] = "ms";
+        out_traza << traza << std::endl;
+        eventos_traza = json::array();
+    }
+
     resultados_array.clear();
     memoria_acumulada_kb = 0;
 }
 
 // Función para medir algoritmo
-unsigned int medirAlgoritmo(const std::string& nombre, unsigned int(*func)(const std::string&, const std::string&), 
+unsigned int medirAlgoritmo(const std::string& nombre, const std::function<unsigned int(const std::string&, const std::string&)>& func, 
                             const std::string& texto, const std::string& patron) {
     try {
         iniciarMedicion(nombre, "Algoritmo", patron);
 
         size_t mem_inicio = getMemoryUsage();
+        reiniciarContadoresMotor();
         auto t_inicio = iniciarTimer();
 
         unsigned int ocurrencias = func(texto, patron);
@@ -165,6 +237,7 @@ unsigned int medirAlgoritmo(const std::string& nombre, unsigned int(*func)(const
 
         registrarConstruccion(0, 0, std::chrono::duration<double, std::milli>(0)); // sin construcción
         registrarBusqueda(mem_inicio, mem_fin, calcularDuracion(t_inicio, t_fin), ocurrencias);
+        registrarContadoresMotor();
         guardarResultado();
 
         return ocurrencias;
@@ -172,6 +245,7 @@ unsigned int medirAlgoritmo(const std::string& nombre, unsigned int(*func)(const
         iniciarMedicion(nombre, "Algoritmo", patron);
         registrarConstruccion(0, 0, std::chrono::duration<double, std::milli>(0));
         registrarBusqueda(0, 0, std::chrono::duration<double, std::milli>(0), 0);
+        registrarMemoriaEstructura(0);
         guardarResultado();
         return 0;
     }
@@ -184,13 +258,19 @@ unsigned int medirEstructura(const std::string& nombre, std::function<std::uniqu
         iniciarMedicion(nombre, "Estructura", patron);
 
         size_t mem_inicio_const = getMemoryUsage();
+        RegistroTraza traza;
         auto t_inicio_const = iniciarTimer();
 
-        auto estructura = constructor(texto);
+        std::unique_ptr<BaseStructure> estructura;
+        {
+            TRAZAR_FASE(nombre.c_str());
+            estructura = constructor(texto);
+        }
 
         auto t_fin_const = detenerTimer();
         size_t mem_fin_const = getMemoryUsage();
 
+        reiniciarContadoresMotor();
         auto t_inicio_busq = iniciarTimer();
         unsigned int ocurrencias = estructura->buscar(patron);
         auto t_fin_busq = detenerTimer();
@@ -198,6 +278,9 @@ unsigned int medirEstructura(const std::string& nombre, std::function<std::uniqu
 
         registrarConstruccion(mem_inicio_const, mem_fin_const, calcularDuracion(t_inicio_const, t_fin_const));
         registrarBusqueda(mem_fin_const, mem_fin_busq, calcularDuracion(t_inicio_busq, t_fin_busq), ocurrencias);
+        registrarMemoriaEstructura(estructura->getMemoriaBytes());
+        registrarFasesConstruccion(traza);
+        registrarContadoresMotor();
         guardarResultado();
 
         return ocurrencias;
@@ -205,6 +288,7 @@ unsigned int medirEstructura(const std::string& nombre, std::function<std::uniqu
         iniciarMedicion(nombre, "Estructura", patron);
         registrarConstruccion(0, 0, std::chrono::duration<double, std::milli>(0));
         registrarBusqueda(0, 0, std::chrono::duration<double, std::milli>(0), 0);
+        registrarMemoriaEstructura(0);
         guardarResultado();
         return 0;
     }
@@ -0,0 +1,118 @@
+#include "../include/definiciones.hpp"
+#include "../include/myers.hpp"
+
+#include <stdexcept>
+
+const size_t BITS_BLOQUE_MYERS = 64;
+
+unsigned int Myers::buscar(const std::string& texto, const std::string& patron, unsigned int maximo_ediciones) {
+    if (patron.empty()) return 0;
+    return PatronMyers(patron, maximo_ediciones).buscar(texto);
+}
+
+std::vector<OcurrenciaAproximada> Myers::localizar(const std::string& texto, const std::string& patron, unsigned int maximo_ediciones) {
+    if (patron.empty()) return {};
+    return PatronMyers(patron, maximo_ediciones).localizar(texto);
+}
+
+PatronMyers::PatronMyers(const std::string& patron, unsigned int maximo_ediciones)
+    : patron_(patron), maximo_ediciones_(maximo_ediciones) {
+    if (patron_.empty()) throw std::invalid_argument("El patrón de búsqueda no puede estar vacío");
+
+    cantidad_bloques_ = (patron_.size() + BITS_BLOQUE_MYERS - 1) / BITS_BLOQUE_MYERS;
+    bit_final_ = 1ULL << ((patron_.size() - 1) % BITS_BLOQUE_MYERS);
+
+    coincidencias_.assign(256 * cantidad_bloques_, 0);
+    rep(i, patron_.size()) {
+        size_t byte = static_cast<unsigned char>(patron_[i]);
+        coincidencias_[byte * cantidad_bloques_ + i / BITS_BLOQUE_MYERS] |= 1ULL << (i % BITS_BLOQUE_MYERS);
+    }
+}
+
+/**
+ * @brief Cada bloque guarda los vectores de diferencias verticales positivas
+ *        (Pv) y negativas (Mv) de sus 64 filas. La diferencia horizontal de
+ *        la última fila de un bloque (+1, 0 o -1) entra al bloque siguiente
+ *        como la de su fila 0; la primera fila de la matriz vale 0 en todas
+ *        las columnas porque la ocurrencia puede comenzar en cualquier parte.
+ * 
+ *        Los bits sobre el último carácter del patrón en el último bloque no
+ *        influyen en los de abajo (sumas y desplazamientos solo propagan hacia
+ *        los bits altos), por lo que no es necesario enmascararlos.
+ */
+template<typename Reportar>
+void PatronMyers::recorrer(std::string_view texto, Reportar reportar) const {
+    const uint64_t BIT_ALTO = 1ULL << (BITS_BLOQUE_MYERS - 1);
+    size_t bloques = cantidad_bloques_;
+    long long distancia = static_cast<long long>(patron_.size());
+    long long maximo = static_cast<long long>(maximo_ediciones_);
+
+    if (bloques == 1) {
+        // Un bloque: los vectores viven en registros y la fila 0 no recibe acarreo
+        uint64_t pv = ~0ULL, mv = 0;
+        rep(j, texto.size()) {
+            uint64_t eq = coincidencias_[static_cast<unsigned char>(texto[j])];
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+
+            distancia += static_cast<long long>((ph & bit_final_) != 0) - static_cast<long long>((mh & bit_final_) != 0);
+
+            ph <<= 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+            if (distancia <= maximo) reportar(static_cast<size_t>(j), static_cast<unsigned int>(distancia));
+        }
+        return;
+    }
+
+    std::vector<uint64_t> positivos(bloques, ~0ULL), negativos(bloques, 0);
+
+    rep(j, texto.size()) {
+        const uint64_t* coincidencias = &coincidencias_[static_cast<unsigned char>(texto[j]) * bloques];
+
+        // Diferencia horizontal que entra al bloque: +1 (positiva), -1 (negativa) o 0
+        uint64_t entrada_positiva = 0, entrada_negativa = 0;
+
+        rep(b, bloques) {
+            uint64_t pv = positivos[b], mv = negativos[b];
+            uint64_t eq = coincidencias[b];
+
+            uint64_t xv = eq | mv;
+            eq |= entrada_negativa;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+
+            uint64_t bit_salida = (static_cast<size_t>(b) + 1 == bloques) ? bit_final_ : BIT_ALTO;
+            uint64_t salida_positiva = (ph & bit_salida) != 0;
+            uint64_t salida_negativa = (mh & bit_salida) != 0;
+
+            ph = (ph << 1) | entrada_positiva;
+            mh = (mh << 1) | entrada_negativa;
+
+            positivos[b] = mh | ~(xv | ph);
+            negativos[b] = ph & xv;
+            entrada_positiva = salida_positiva;
+            entrada_negativa = salida_negativa;
+        }
+
+        distancia += static_cast<long long>(entrada_positiva) - static_cast<long long>(entrada_negativa);
+        if (distancia <= maximo) reportar(static_cast<size_t>(j), static_cast<unsigned int>(distancia));
+    }
+}
+
+unsigned int PatronMyers::buscar(std::string_view texto) const {
+    unsigned int ocurrencias = 0;
+    recorrer(texto, [&ocurrencias](size_t, unsigned int) { ocurrencias++; });
+    return ocurrencias;
+}
+
+std::vector<OcurrenciaAproximada> PatronMyers::localizar(std::string_view texto) const {
+    std::vector<OcurrenciaAproximada> ocurrencias;
+    recorrer(texto, [&ocurrencias](size_t fin, unsigned int distancia) { ocurrencias.push_back({fin, distancia}); });
+    return ocurrencias;
+}
@@ -0,0 +1,80 @@
+#include "../include/definiciones.hpp"
+#include "../include/patron_comodin.hpp"
+#include "../include/plegado_caso.hpp"
+
+#include <stdexcept>
+
+/**
+ * @brief Recorre la expresión una vez: cada literal, ? o clase completa
+ *        aporta una posición al patrón.
+ */
+PatronComodin::PatronComodin(const std::string& expresion) : expresion_(expresion) {
+    if (expresion.empty()) throw std::invalid_argument("El patrón de búsqueda no puede estar vacío");
+
+    size_t i = 0;
+    auto siguienteByte = [&]() {
+        if (expresion[i] == '\\') {
+            if (++i == expresion.size()) throw std::invalid_argument("El patrón termina en \\: " + expresion);
+        }
+        return static_cast<unsigned char>(expresion[i++]);
+    };
+
+    while (i < expresion.size()) {
+        std::bitset<256> aceptados;
+
+        if (expresion[i] == '?') {
+            aceptados.set();
+            i++;
+        } else if (expresion[i] == '[') {
+            size_t apertura = i++;
+            bool negada = i < expresion.size() && expresion[i] == '^';
+            if (negada) i++;
+
+            while (i < expresion.size() && expresion[i] != ']') {
+                unsigned char desde = siguienteByte();
+                unsigned char hasta = desde;
+                if (i + 1 < expresion.size() && expresion[i] == '-' && expresion[i + 1] != ']') {
+                    i++;
+                    hasta = siguienteByte();
+                    if (hasta < desde) throw std::invalid_argument("Rango invertido en la clase del patrón: " + expresion);
+                }
+                for (unsigned int c = desde; c <= hasta; ++c) aceptados.set(c);
+            }
+            if (i == expresion.size()) {
+                throw std::invalid_argument("Corchete sin cerrar en la posición " + std::to_string(apertura) + " del patrón: " + expresion);
+            }
+            i++;
+
+            if (negada) aceptados.flip();
+            if (aceptados.none()) throw std::invalid_argument("Clase vacía en el patrón: " + expresion);
+        } else {
+            aceptados.set(siguienteByte());
+        }
+
+        agregarPosicion(aceptados);
+    }
+}
+
+void PatronComodin::agregarPosicion(const std::bitset<256>& aceptados) {
+    std::string caracteres;
+    rep(c, 256) {
+        if (aceptados[c]) caracteres.push_back(static_cast<char>(c));
+    }
+    aceptados_.push_back(aceptados);
+    caracteres_.push_back(caracteres);
+}
+
+PatronComodin PatronComodin::plegado() const {
+    PatronComodin copia(*this);
+    copia.aceptados_.clear();
+    copia.caracteres_.clear();
+
+    for (const auto& aceptados : aceptados_) {
+        std::bitset<256> plegados;
+        rep(c, 256) {
+            if (aceptados[c]) plegados.set(plegarCaracter(static_cast<unsigned char>(c)));
+        }
+        copia.agregarPosicion(plegados);
+    }
+    return copia;
+}
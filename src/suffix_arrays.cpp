@@ -1,25 +1,245 @@
 #include "../include/definiciones.hpp"
 #include "../include/suffix_arrays.hpp"
+#include "../include/traza.hpp"
 
-SuffixArrays::SuffixArrays(const std::string& texto) {
-    // String aux
-    for (auto it = texto.begin(); it != texto.end(); ++it) {
-        this->sufijos.emplace_back(it, texto.end());
+SuffixArrays::SuffixArrays(const std::string& texto_original, bool plegar_mayusculas)
+    : texto(plegar_mayusculas ? plegarCaso(texto_original) : texto_original), ignorar_mayusculas(plegar_mayusculas) {
+    const std::string& texto_base = this->texto;
+    int longitud = static_cast<int>(texto_base.size());
+
+    // Ordenamos las posiciones de los sufijos
+    {
+        TRAZAR_FASE("arreglo_sufijos");
+        this->sufijos.resize(longitud);
+        rep(i, longitud) this->sufijos[i] = i;
+
+        std::sort(this->sufijos.begin(), this->sufijos.end(),
+            [&](int a, int b) {
+                int comparacion_longitud = longitud - std::max(a, b);
+                int resultado = texto_base.compare(a, comparacion_longitud, texto_base, b, comparacion_longitud);
+                // Si uno es prefijo del otro, el más corto va primero
+                return resultado != 0 ? resultado < 0 : a > b;
+            });
+    }
+
+    // Tabla LCP con el algoritmo de Kasai
+    {
+        TRAZAR_FASE("lcp");
+        this->lcp.assign(longitud + 1, -1);
+        vc rango(longitud);
+        rep(i, longitud) rango[this->sufijos[i]] = i;
+
+        int comun = 0;
+        rep(i, longitud) {
+            if (rango[i] == 0) {
+                comun = 0;
+                continue;
+            }
+            int anterior = this->sufijos[rango[i] - 1];
+            while (i + comun < longitud && anterior + comun < longitud && texto_base[i + comun] == texto_base[anterior + comun]) comun++;
+            this->lcp[rango[i]] = comun;
+            if (comun > 0) comun--;
+        }
+    }
+
+    // Tabla de hijos (up, down y nextlIndex) con las dos pilas de Abouelhoda et al.
+    TRAZAR_FASE("tabla_hijos");
+    this->siguiente.assign(longitud + 1, -1);
+    this->abajo.assign(longitud + 1, -1);
+    if (longitud == 0) return;
+
+    vc pila = {0};
+    int ultimo = -1;
+    for (int i = 1; i <= longitud; i++) {
+        while (this->lcp[i] < this->lcp[pila.back()]) {
+            ultimo = pila.back();
+            pila.pop_back();
+            if (this->lcp[i] <= this->lcp[pila.back()] && this->lcp[pila.back()] != this->lcp[ultimo]) {
+                this->abajo[pila.back()] = ultimo;
+            }
+        }
+        // up[i] queda en la celda de nextlIndex[i-1], que no está definido
+        if (ultimo != -1) {
+            this->siguiente[i - 1] = ultimo;
+            ultimo = -1;
+        }
+        pila.push_back(i);
+    }
+
+    pila = {0};
+    for (int i = 1; i <= longitud; i++) {
+        while (this->lcp[i] < this->lcp[pila.back()]) pila.pop_back();
+        if (this->lcp[i] == this->lcp[pila.back()]) {
+            this->siguiente[pila.back()] = i;
+            pila.pop_back();
+        }
+        pila.push_back(i);
+    }
+}
+
+int SuffixArrays::obtenerArriba(int k) const {
+    return this->lcp[k - 1] > this->lcp[k] ? this->siguiente[k - 1] : -1;
+}
+
+int SuffixArrays::obtenerSiguienteL(int k) const {
+    return this->lcp[k] > this->lcp[k + 1] ? -1 : this->siguiente[k];
+}
+
+int SuffixArrays::obtenerPrimerIndiceL(int i, int j) const {
+    int arriba = obtenerArriba(j + 1);
+    return (i < arriba && arriba <= j) ? arriba : this->abajo[i];
+}
+
+bool SuffixArrays::obtenerHijo(char caracter, int profundidad, int& i, int& j) const {
+    int longitud = static_cast<int>(this->texto.size());
+    unsigned char buscado = static_cast<unsigned char>(caracter);
+
+    // Recorre los hijos en orden lexicográfico: [i..k-1], [k..siguiente-1], ..., [k..j]
+    int inicio = i;
+    int limite = obtenerPrimerIndiceL(i, j);
+    while (true) {
+        int fin = (limite == -1) ? j : limite - 1;
+        int posicion = this->sufijos[inicio] + profundidad;
+
+        if (posicion < longitud) {
+            unsigned char actual = static_cast<unsigned char>(this->texto[posicion]);
+            if (actual == buscado) {
+                i = inicio;
+                j = fin;
+                return true;
+            }
+            if (actual > buscado) return false;
+        }
+
+        if (limite == -1) return false;
+        inicio = limite;
+        int proximo = obtenerSiguienteL(limite);
+        limite = (proximo != -1 && proximo <= j) ? proximo : -1;
+    }
+}
+
+std::string SuffixArrays::patronBuscado(const std::string& patron) const {
+    return this->ignorar_mayusculas ? plegarCaso(patron) : patron;
+}
+
+unsigned int SuffixArrays::buscar(const std::string& patron_original) const {
+    const std::string patron = patronBuscado(patron_original);
+    int longitud = static_cast<int>(this->sufijos.size());
+    int longitud_patron = static_cast<int>(patron.size());
+    if (longitud == 0) return 0;
+    if (longitud_patron == 0) return longitud;
+
+    int i = 0, j = longitud - 1;
+    int comparados = 0;
+
+    while (true) {
+        // Un solo sufijo: basta comparar lo que resta del patrón
+        if (i == j) {
+            return this->texto.compare(this->sufijos[i] + comparados, longitud_patron - comparados,
+                                       patron, comparados, longitud_patron - comparados) == 0 ? 1 : 0;
+        }
+
+        int profundidad = this->lcp[obtenerPrimerIndiceL(i, j)];
+        int hasta = std::min(profundidad, longitud_patron);
+
+        // Todos los sufijos del intervalo comparten los primeros 'profundidad' caracteres
+        if (this->texto.compare(this->sufijos[i] + comparados, hasta - comparados,
+                                patron, comparados, hasta - comparados) != 0) return 0;
+        comparados = hasta;
+
+        if (comparados == longitud_patron) return static_cast<unsigned int>(j - i + 1);
+        if (!obtenerHijo(patron[comparados], profundidad, i, j)) return 0;
     }
+}
+
+unsigned int SuffixArrays::buscarBinaria(const std::string& patron_original) const {
+    const std::string patron = patronBuscado(patron_original);
+    size_t longitud_patron = patron.size();
 
-    // Ordenamos el arreglo de sufijos
-    std::sort(this->sufijos.begin(), this->sufijos.end());
+    // Compara el prefijo del sufijo con el patrón
+    auto menorQuePatron = [&](int sufijo, const std::string& p) {
+        return this->texto.compare(sufijo, longitud_patron, p) < 0;
+    };
+    auto patronMenorQue = [&](const std::string& p, int sufijo) {
+        return this->texto.compare(sufijo, longitud_patron, p) > 0;
+    };
+
+    auto inicio = std::lower_bound(this->sufijos.begin(), this->sufijos.end(), patron, menorQuePatron);
+    auto fin = std::upper_bound(inicio, this->sufijos.end(), patron, patronMenorQue);
+
+    return static_cast<unsigned int>(fin - inicio);
+}
+
+size_t SuffixArrays::getMemoriaBytes() const {
+    return (this->sufijos.size() + this->lcp.size() + this->siguiente.size() + this->abajo.size()) * sizeof(int)
+         + this->texto.size();
+}
+
+bool SuffixArrays::coincideComodin(const PatronComodin& patron, int sufijo, int desde, int hasta) const {
+    for (int k = desde; k < hasta; ++k) {
+        if (!patron.acepta(static_cast<size_t>(k), static_cast<unsigned char>(this->texto[sufijo + k]))) return false;
+    }
+    return true;
 }
 
-unsigned int SuffixArrays::buscar(const std::string& patron) const {
-    // Aciertos
-    unsigned int aciertos = 0;
-           
-    // Empezar a encontrar el rango de los elementos, devuelve puntero que apunta al sufijo
-    auto it = std::lower_bound(this->sufijos.begin(), this->sufijos.end(), patron);
-    
-    // it es un iterador, entonces *it es el string (*i) y substr es para encontrar el substring que parte con patron
-    while(it != this->sufijos.end() && it->compare(0, patron.size(), patron) == 0) aciertos++, it++;
-    
-    return aciertos;
+ResultadoComodin SuffixArrays::buscarComodin(const PatronComodin& patron, size_t maximo_intervalos) const {
+    ResultadoComodin resultado;
+    if (this->sufijos.empty()) return resultado;
+
+    const PatronComodin buscado = this->ignorar_mayusculas ? patron.plegado() : patron;
+    expandirComodin(buscado, 0, static_cast<int>(this->sufijos.size()) - 1, 0, maximo_intervalos, resultado);
+    return resultado;
+}
+
+/**
+ * @brief Los hijos de [i..j] se recorren igual que en obtenerHijo(), pero sin
+ *        detenerse en el primero: se sigue a cada uno cuyo carácter en la
+ *        posición profundidad acepta el patrón.
+ */
+void SuffixArrays::expandirComodin(const PatronComodin& patron, int i, int j, int comparados,
+                                   size_t maximo_intervalos, ResultadoComodin& resultado) const {
+    int longitud = static_cast<int>(this->texto.size());
+    int longitud_patron = static_cast<int>(patron.size());
+
+    // Un solo sufijo: basta verificar lo que resta del patrón
+    if (i == j) {
+        int sufijo = this->sufijos[i];
+        if (sufijo + longitud_patron <= longitud && coincideComodin(patron, sufijo, comparados, longitud_patron)) {
+            resultado.ocurrencias++;
+        }
+        return;
+    }
+
+    int profundidad = this->lcp[obtenerPrimerIndiceL(i, j)];
+    int hasta = std::min(profundidad, longitud_patron);
+
+    // Todos los sufijos del intervalo comparten los primeros 'profundidad' caracteres
+    if (!coincideComodin(patron, this->sufijos[i], comparados, hasta)) return;
+    if (hasta == longitud_patron) {
+        resultado.ocurrencias += static_cast<size_t>(j - i + 1);
+        return;
+    }
+
+    int inicio = i;
+    int limite = obtenerPrimerIndiceL(i, j);
+    while (true) {
+        int fin = (limite == -1) ? j : limite - 1;
+        int posicion = this->sufijos[inicio] + profundidad;
+
+        if (posicion < longitud && patron.acepta(static_cast<size_t>(profundidad), static_cast<unsigned char>(this->texto[posicion]))) {
+            if (resultado.intervalos_explorados == maximo_intervalos) {
+                resultado.truncado = true;
+                return;
+            }
+            resultado.intervalos_explorados++;
+
+            expandirComodin(patron, inicio, fin, profundidad + 1, maximo_intervalos, resultado);
+            if (resultado.truncado) return;
+        }
+
+        if (limite == -1) return;
+        inicio = limite;
+        int proximo = obtenerSiguienteL(limite);
+        limite = (proximo != -1 && proximo <= j) ? proximo : -1;
+    }
 }
@@ -1,5 +1,7 @@
 #include "../include/definiciones.hpp"
 #include "../include/suffix_trees.hpp"
+#include "../include/contadores.hpp"
+#include "../include/traza.hpp"
 
 SuffixTrees::Node::Node() {
     ind = std::make_unique<std::list<int>>();
@@ -18,21 +20,59 @@ void SuffixTrees::Node::insertSuffix(const std::string& texto, size_t posicion_t
 }
 
 const std::list<int>* SuffixTrees::Node::search(const std::string& patron, size_t posicion) const {
+    CONTAR_MOTOR(nodos_visitados_suffix_trees, 1);
     if (patron.size() == posicion) return ind.get();
     
     unsigned char c = patron.at(posicion);
     return children[c] ? children[c]->search(patron, posicion + 1) : nullptr;
 }
 
+void SuffixTrees::Node::searchComodin(const PatronComodin& patron, size_t posicion, size_t maximo_intervalos,
+                                      ResultadoComodin& resultado) const {
+    CONTAR_MOTOR(nodos_visitados_suffix_trees, 1);
+    if (patron.size() == posicion) {
+        resultado.ocurrencias += ind->size();
+        return;
+    }
+
+    for (char caracter : patron.caracteres(posicion)) {
+        const auto& hijo = children[static_cast<unsigned char>(caracter)];
+        if (!hijo) continue;
+
+        if (resultado.intervalos_explorados == maximo_intervalos) {
+            resultado.truncado = true;
+            return;
+        }
+        resultado.intervalos_explorados++;
+
+        hijo->searchComodin(patron, posicion + 1, maximo_intervalos, resultado);
+        if (resultado.truncado) return;
+    }
+}
+
+size_t SuffixTrees::Node::getMemoriaBytes() const {
+    // Cada nodo de std::list guarda el índice y los punteros al anterior y al siguiente
+    size_t bytes = sizeof(Node) + children.capacity() * sizeof(std::unique_ptr<Node>)
+                 + sizeof(std::list<int>) + ind->size() * (sizeof(int) + 2 * sizeof(void*));
+    for (const auto& child : children) {
+        if (child) bytes += child->getMemoriaBytes();
+    }
+    return bytes;
+}
+
 SuffixTrees::Node::~Node() {
     for (auto& child : children) {
         child.reset();
     }
 }
 
-SuffixTrees::SuffixTrees(const std::string& texto) {
-    if (texto.empty()) return ;
+SuffixTrees::SuffixTrees(const std::string& texto_original, bool plegar_mayusculas)
+    : ignorar_mayusculas(plegar_mayusculas) {
+    if (texto_original.empty()) return ;
+
+    const std::string texto = plegar_mayusculas ? plegarCaso(texto_original) : texto_original;
 
+    TRAZAR_FASE("insertar_sufijos");
     this->root = std::make_unique<Node>();
     for (size_t i = 0; i < texto.size(); ++i) {
         this->root->insertSuffix(texto, i, i);
@@ -44,6 +84,20 @@ SuffixTrees::~SuffixTrees() {
 }
 
 unsigned int SuffixTrees::buscar(const std::string& patron) const {
-    const std::list<int>* ans = this->root->search(patron, 0);
+    const std::list<int>* ans = this->ignorar_mayusculas ? this->root->search(plegarCaso(patron), 0)
+                                                         : this->root->search(patron, 0);
     return ans ? static_cast<unsigned int>(ans->size()) : 0;
-}
\ No newline at end of file
+}
+
+size_t SuffixTrees::getMemoriaBytes() const {
+    return this->root ? this->root->getMemoriaBytes() : 0;
+}
+
+ResultadoComodin SuffixTrees::buscarComodin(const PatronComodin& patron, size_t maximo_intervalos) const {
+    ResultadoComodin resultado;
+    if (!this->root) return resultado;
+
+    if (this->ignorar_mayusculas) this->root->searchComodin(patron.plegado(), 0, maximo_intervalos, resultado);
+    else this->root->searchComodin(patron, 0, maximo_intervalos, resultado);
+    return resultado;
+}
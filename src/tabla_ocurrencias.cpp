@@ -0,0 +1,133 @@
+#include "../include/definiciones.hpp"
+#include "../include/tabla_ocurrencias.hpp"
+#include "../include/traza.hpp"
+
+TablaOcurrencias::TablaOcurrencias(std::string_view bwt, PoolTrabajo* pool) {
+    TRAZAR_FASE("tabla_ocurrencias");
+    if (bwt.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("La BWT excede el tamaño máximo de la tabla de ocurrencias");
+    }
+
+    // Una fila de conteos al inicio de cada bloque, incluida la posición n
+    size_t cantidad_filas = bwt.size() / INTERVALO_OCURRENCIAS + 1;
+    size_t tramos = cantidadTramos(bwt.size(), pool);
+
+    // Cada tramo de filas [inicio, fin) cuenta los caracteres de sus bloques
+    auto caracteresDe = [&](size_t fila_inicio, size_t fila_fin) {
+        return std::make_pair(std::min(fila_inicio * INTERVALO_OCURRENCIAS, bwt.size()),
+                              std::min(fila_fin * INTERVALO_OCURRENCIAS, bwt.size()));
+    };
+    std::vector<std::vector<uint32_t>> conteos_por_tramo(tramos, std::vector<uint32_t>(256, 0));
+    paraCadaTramo(cantidad_filas, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        auto caracteres = caracteresDe(inicio, fin);
+        for (size_t i = caracteres.first; i < caracteres.second; ++i) conteos_por_tramo[tramo][static_cast<unsigned char>(bwt[i])]++;
+    });
+
+    // Asignar un código compacto a cada carácter presente
+    std::vector<uint16_t> codigos(256, SIN_CODIGO);
+    uint16_t siguiente_codigo = 0;
+    rep(c, 256) {
+        bool presente = false;
+        for (const auto& conteos : conteos_por_tramo) presente = presente || conteos[c] > 0;
+        if (presente) codigos[c] = siguiente_codigo++;
+    }
+    cantidad_simbolos_ = siguiente_codigo;
+
+    // Conteos con que empieza cada tramo: suma de los tramos anteriores
+    std::vector<std::vector<uint32_t>> iniciales(tramos, std::vector<uint32_t>(cantidad_simbolos_, 0));
+    for (size_t tramo = 1; tramo < tramos; ++tramo) {
+        rep(c, 256) {
+            if (codigos[c] == SIN_CODIGO) continue;
+            iniciales[tramo][codigos[c]] = iniciales[tramo - 1][codigos[c]] + conteos_por_tramo[tramo - 1][c];
+        }
+    }
+
+    VectorAlineado<uint32_t> muestras(cantidad_filas * cantidad_simbolos_, 0);
+    paraCadaTramo(cantidad_filas, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        std::vector<uint32_t>& conteos = iniciales[tramo];
+        auto caracteres = caracteresDe(inicio, fin);
+        for (size_t i = caracteres.first; i <= caracteres.second; ++i) {
+            if (i % INTERVALO_OCURRENCIAS == 0 && i / INTERVALO_OCURRENCIAS < fin) {
+                std::copy(conteos.begin(), conteos.end(), muestras.begin() + (i / INTERVALO_OCURRENCIAS) * cantidad_simbolos_);
+            }
+            if (i < caracteres.second) conteos[codigos[static_cast<unsigned char>(bwt[i])]]++;
+        }
+    });
+
+    bwt_ = ArregloPlano<unsigned char>(VectorAlineado<unsigned char>(bwt.begin(), bwt.end()));
+    codigos_ = ArregloPlano<uint16_t>(std::move(codigos));
+    muestras_ = ArregloPlano<uint32_t>(std::move(muestras));
+}
+
+size_t TablaOcurrencias::rango(unsigned char caracter, size_t i) const {
+    uint16_t codigo = codigos_[caracter];
+    if (codigo == SIN_CODIGO) return 0;
+
+    size_t bloque = i / INTERVALO_OCURRENCIAS;
+    size_t conteo = muestras_[bloque * cantidad_simbolos_ + codigo];
+
+    // Contar el tramo entre la fila muestreada y la posición pedida
+    const unsigned char* tramo = bwt_.data() + bloque * INTERVALO_OCURRENCIAS;
+    size_t largo_tramo = i - bloque * INTERVALO_OCURRENCIAS;
+    for (size_t k = 0; k < largo_tramo; ++k) {
+        conteo += (tramo[k] == caracter);
+    }
+    return conteo;
+}
+
+size_t TablaOcurrencias::rangoMenores(unsigned char caracter, size_t i) const {
+    // Cantidad de símbolos presentes menores que el carácter
+    uint32_t limite = cantidad_simbolos_;
+    for (unsigned int byte = caracter; byte < 256; ++byte) {
+        if (codigos_[byte] != SIN_CODIGO) {
+            limite = codigos_[byte];
+            break;
+        }
+    }
+
+    size_t bloque = i / INTERVALO_OCURRENCIAS;
+    const uint32_t* fila = muestras_.data() + bloque * cantidad_simbolos_;
+    size_t conteo = 0;
+    for (uint32_t codigo = 0; codigo < limite; ++codigo) conteo += fila[codigo];
+
+    const unsigned char* tramo = bwt_.data() + bloque * INTERVALO_OCURRENCIAS;
+    size_t largo_tramo = i - bloque * INTERVALO_OCURRENCIAS;
+    for (size_t k = 0; k < largo_tramo; ++k) {
+        conteo += (tramo[k] < caracter);
+    }
+    return conteo;
+}
+
+size_t TablaOcurrencias::getMemoriaBytes() const {
+    return bwt_.getMemoriaBytes() + codigos_.getMemoriaBytes() + muestras_.getMemoriaBytes();
+}
+
+void TablaOcurrencias::serializar(EscritorBinario& escritor) const {
+    escritor.escribir(static_cast<uint64_t>(cantidad_simbolos_));
+    escritor.escribirArreglo(bwt_);
+    escritor.escribirArreglo(codigos_);
+    escritor.escribirArreglo(muestras_);
+}
+
+void TablaOcurrencias::mapear(LectorMapeado& lector) {
+    uint64_t cantidad_simbolos = lector.leer<uint64_t>();
+    lector.mapearArreglo(bwt_);
+    lector.mapearArreglo(codigos_);
+    lector.mapearArreglo(muestras_);
+
+    // Validar que las dimensiones sean coherentes antes de aceptar consultas
+    size_t filas_esperadas = bwt_.size() / INTERVALO_OCURRENCIAS + 1;
+    bool tabla_valida = cantidad_simbolos <= 256 && bwt_.size() < std::numeric_limits<uint32_t>::max()
+                        && codigos_.size() == 256 && muestras_.size() == filas_esperadas * cantidad_simbolos;
+
+    // rango indexa las filas con el código y rangoMenores supone códigos 0, 1, ... en orden de carácter
+    uint64_t codigos_asignados = 0;
+    for (size_t c = 0; tabla_valida && c < 256; ++c) {
+        if (codigos_[c] == SIN_CODIGO) continue;
+        tabla_valida = codigos_[c] == codigos_asignados++;
+    }
+    if (!tabla_valida || codigos_asignados != cantidad_simbolos) {
+        throw std::runtime_error("Archivo de índice corrupto: tabla de ocurrencias inconsistente");
+    }
+    cantidad_simbolos_ = static_cast<uint32_t>(cantidad_simbolos);
+}
@@ -0,0 +1,325 @@
+#include "../include/definiciones.hpp"
+#include "../include/transformada_bwt.hpp"
+#include "../include/traza.hpp"
+
+#include <array>
+#include <stdexcept>
+
+// ========== Ordenamiento en paralelo ==========
+
+/**
+ * @brief Cantidad de elementos de a entre los primeros k de la mezcla de a y b (a primero en empates).
+ */
+static size_t corangoMezcla(size_t k, const uint64_t* a, size_t largo_a, const uint64_t* b, size_t largo_b) {
+    size_t bajo = k > largo_b ? k - largo_b : 0;
+    size_t alto = std::min(k, largo_a);
+    while (bajo < alto) {
+        size_t i = bajo + (alto - bajo) / 2;
+        if (a[i] <= b[k - i - 1]) bajo = i + 1;     // a[i] sale antes que b[k - i - 1]: faltan elementos de a
+        else alto = i;
+    }
+    return bajo;
+}
+
+/**
+ * @brief Ordena cada tramo con std::sort y mezcla las corridas de a pares;
+ *        cada mezcla se divide entre varias tareas cortando ambas corridas
+ *        en el mismo punto de la salida (corango).
+ */
+static void ordenarParalelo(uint64_t* datos, size_t n, PoolTrabajo* pool) {
+    size_t tramos = cantidadTramos(n, pool);
+    if (tramos == 1) {
+        std::sort(datos, datos + n);
+        return;
+    }
+
+    paraCadaTramo(n, tramos, pool, [&](size_t, size_t inicio, size_t fin) { std::sort(datos + inicio, datos + fin); });
+
+    // Corridas ordenadas [limites[r], limites[r + 1])
+    std::vector<size_t> limites;
+    for (size_t k = 0; k <= tramos; ++k) limites.push_back(k * n / tramos);
+
+    std::vector<uint64_t> auxiliar(n);
+    uint64_t* origen = datos;
+    uint64_t* destino = auxiliar.data();
+    while (limites.size() > 2) {
+        std::vector<size_t> mezclados;
+        std::vector<std::function<void()>> tareas;
+        for (size_t r = 0; r + 1 < limites.size(); r += 2) {
+            size_t inicio = limites[r];
+            mezclados.push_back(inicio);
+            if (r + 2 == limites.size()) {
+                size_t fin = limites[r + 1];
+                tareas.emplace_back([=]() { std::copy(origen + inicio, origen + fin, destino + inicio); });
+                continue;
+            }
+
+            size_t medio = limites[r + 1];
+            size_t fin = limites[r + 2];
+            size_t piezas = std::max<size_t>(tramos * (fin - inicio) / n, 1);
+            for (size_t pieza = 0; pieza < piezas; ++pieza) {
+                size_t desde = pieza * (fin - inicio) / piezas;
+                size_t hasta = (pieza + 1) * (fin - inicio) / piezas;
+                tareas.emplace_back([=]() {
+                    const uint64_t* a = origen + inicio;
+                    const uint64_t* b = origen + medio;
+                    size_t desde_a = corangoMezcla(desde, a, medio - inicio, b, fin - medio);
+                    size_t hasta_a = corangoMezcla(hasta, a, medio - inicio, b, fin - medio);
+                    std::merge(a + desde_a, a + hasta_a, b + (desde - desde_a), b + (hasta - hasta_a), destino + inicio + desde);
+                });
+            }
+        }
+        mezclados.push_back(n);
+        pool->ejecutar(std::move(tareas));
+
+        limites = std::move(mezclados);
+        std::swap(origen, destino);
+    }
+
+    if (origen != datos) {
+        paraCadaTramo(n, tramos, pool, [&](size_t, size_t inicio, size_t fin) {
+            std::copy(origen + inicio, origen + fin, datos + inicio);
+        });
+    }
+}
+
+// ========== Arreglo de sufijos ==========
+
+/**
+ * @brief Sufijos contiguos del arreglo que comparten sus primeros h caracteres y aún no se ordenan entre sí.
+ */
+struct GrupoSufijos {
+    uint32_t inicio;    // Primera posición del grupo en el arreglo de sufijos
+    uint32_t largo;     // Cantidad de sufijos (al menos 2)
+};
+
+/**
+ * @brief Clave de ordenamiento de un sufijo: criterio en los 32 bits altos y sufijo en los bajos.
+ */
+static inline uint64_t claveSufijo(uint64_t criterio, int sufijo) {
+    return (criterio << 32) | static_cast<uint32_t>(sufijo);
+}
+
+/**
+ * @brief Ordena cada grupo por criterio(sufijo) y lo divide en subgrupos de criterio igual.
+ * 
+ * Escribe el arreglo de sufijos en las posiciones de los grupos y, como
+ * rango de cada sufijo, la primera posición de su subgrupo. Los criterios
+ * se leen todos antes de escribir cualquier rango, así que criterio puede
+ * leer el arreglo de rangos.
+ * 
+ * @return Subgrupos de más de un sufijo, en orden de posición.
+ */
+template<typename Criterio>
+static std::vector<GrupoSufijos> ordenarGrupos(const std::vector<GrupoSufijos>& grupos, Criterio criterio,
+                                               vc& arreglo_sufijos, vc& rango, PoolTrabajo* pool) {
+    // Las claves de cada grupo quedan contiguas: el grupo g ocupa [desplazamiento[g], desplazamiento[g + 1])
+    std::vector<size_t> desplazamiento(grupos.size() + 1, 0);
+    rep(g, grupos.size()) desplazamiento[g + 1] = desplazamiento[g] + grupos[g].largo;
+    size_t total = desplazamiento.back();
+    size_t tramos = cantidadTramos(total, pool);
+
+    auto grupoDe = [&](size_t posicion) {
+        return static_cast<size_t>(std::upper_bound(desplazamiento.begin(), desplazamiento.end(), posicion) - desplazamiento.begin()) - 1;
+    };
+
+    std::vector<uint64_t> claves(total);
+    paraCadaTramo(total, tramos, pool, [&](size_t, size_t inicio, size_t fin) {
+        size_t g = grupoDe(inicio);
+        for (size_t q = inicio; q < fin; ++q) {
+            while (q >= desplazamiento[g + 1]) g++;
+            int sufijo = arreglo_sufijos[grupos[g].inicio + (q - desplazamiento[g])];
+            claves[q] = claveSufijo(criterio(sufijo), sufijo);
+        }
+    });
+
+    // Los grupos chicos se reparten en lotes contiguos; los grandes se ordenan de a uno con todos los hilos
+    size_t umbral = std::max<size_t>(total / tramos, 1);
+    std::vector<size_t> grandes;
+    std::vector<std::pair<size_t, size_t>> lotes;
+    size_t primero_lote = 0, acumulado = 0;
+    rep(g, grupos.size()) {
+        if (tramos > 1 && grupos[g].largo >= umbral) grandes.push_back(g);
+        else acumulado += grupos[g].largo;
+        if (acumulado >= umbral || g + 1 == static_cast<int>(grupos.size())) {
+            lotes.emplace_back(primero_lote, g + 1);
+            primero_lote = g + 1;
+            acumulado = 0;
+        }
+    }
+    paraCadaTramo(lotes.size(), lotes.size(), pool, [&](size_t, size_t inicio, size_t fin) {
+        for (size_t lote = inicio; lote < fin; ++lote) {
+            for (size_t g = lotes[lote].first; g < lotes[lote].second; ++g) {
+                if (tramos > 1 && grupos[g].largo >= umbral) continue;
+                std::sort(claves.begin() + desplazamiento[g], claves.begin() + desplazamiento[g + 1]);
+            }
+        }
+    });
+    for (size_t g : grandes) ordenarParalelo(claves.data() + desplazamiento[g], grupos[g].largo, pool);
+
+    // Cada tramo escribe sus posiciones y emite los subgrupos que comienzan en él
+    std::vector<std::vector<GrupoSufijos>> subgrupos(tramos);
+    paraCadaTramo(total, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        size_t g = grupoDe(inicio);
+        size_t cabeza = 0;
+        for (size_t q = inicio; q < fin; ++q) {
+            while (q >= desplazamiento[g + 1]) g++;
+            const uint64_t* datos = claves.data();
+            const uint64_t* ultimo = datos + desplazamiento[g + 1];
+            uint64_t valor = claves[q] >> 32;
+
+            if (q == desplazamiento[g] || (claves[q - 1] >> 32) != valor) {
+                cabeza = q;
+                size_t fin_subgrupo = static_cast<size_t>(std::upper_bound(datos + q, ultimo, (valor << 32) | 0xFFFFFFFFULL) - datos);
+                if (fin_subgrupo - q > 1) {
+                    subgrupos[tramo].push_back({static_cast<uint32_t>(grupos[g].inicio + (q - desplazamiento[g])),
+                                                static_cast<uint32_t>(fin_subgrupo - q)});
+                }
+            } else if (q == inicio) {
+                // El subgrupo empezó en un tramo anterior
+                cabeza = static_cast<size_t>(std::lower_bound(datos + desplazamiento[g], datos + q, valor << 32) - datos);
+            }
+
+            int sufijo = static_cast<int>(claves[q] & 0xFFFFFFFFULL);
+            arreglo_sufijos[grupos[g].inicio + (q - desplazamiento[g])] = sufijo;
+            rango[sufijo] = static_cast<int>(grupos[g].inicio + (cabeza - desplazamiento[g]));
+        }
+    });
+
+    std::vector<GrupoSufijos> siguientes;
+    for (auto& parte : subgrupos) siguientes.insert(siguientes.end(), parte.begin(), parte.end());
+    return siguientes;
+}
+
+vc construirArregloSufijos(const std::string& texto, PoolTrabajo* pool) {
+    TRAZAR_FASE("arreglo_sufijos");
+    if (texto.size() >= static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::length_error("El texto excede el tamaño máximo del arreglo de sufijos");
+    }
+    size_t longitud = texto.size();
+    size_t tramos = cantidadTramos(longitud, pool);
+
+    // Código 1..σ de cada carácter presente; 0 es el fin del texto y ordena primero al sufijo más corto
+    std::vector<std::array<bool, 256>> presentes_por_tramo(tramos);
+    paraCadaTramo(longitud, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        presentes_por_tramo[tramo].fill(false);
+        for (size_t i = inicio; i < fin; ++i) presentes_por_tramo[tramo][static_cast<unsigned char>(texto[i])] = true;
+    });
+    std::array<uint32_t, 256> codigos{};
+    uint32_t sigma = 0;
+    rep(c, 256) {
+        bool presente = false;
+        for (const auto& presentes : presentes_por_tramo) presente = presente || presentes[c];
+        if (presente) codigos[c] = ++sigma;
+    }
+
+    // Los primeros k caracteres caben empaquetados en los 32 bits del criterio
+    uint32_t bits = 1;
+    while ((1u << bits) <= sigma) bits++;
+    size_t caracteres_iniciales = 32 / bits;
+
+    vc arreglo_sufijos(longitud);
+    vc rango(longitud);
+    paraCadaTramo(longitud, tramos, pool, [&](size_t, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) arreglo_sufijos[i] = static_cast<int>(i);
+    });
+
+    auto prefijoEmpaquetado = [&](int sufijo) {
+        uint64_t criterio = 0;
+        for (size_t j = 0; j < caracteres_iniciales; ++j) {
+            size_t posicion = static_cast<size_t>(sufijo) + j;
+            uint32_t codigo = posicion < longitud ? codigos[static_cast<unsigned char>(texto[posicion])] : 0;
+            criterio = (criterio << bits) | codigo;
+        }
+        return criterio;
+    };
+
+    std::vector<GrupoSufijos> grupos;
+    if (longitud > 1) grupos.push_back({0, static_cast<uint32_t>(longitud)});
+    grupos = ordenarGrupos(grupos, prefijoEmpaquetado, arreglo_sufijos, rango, pool);
+
+    // Ronda h: los grupos comparten h caracteres y se ordenan por el rango del sufijo h posiciones después
+    for (size_t h = caracteres_iniciales; !grupos.empty(); h *= 2) {
+        auto rangoSiguiente = [&](int sufijo) -> uint64_t {
+            size_t siguiente = static_cast<size_t>(sufijo) + h;
+            return siguiente < longitud ? static_cast<uint64_t>(rango[siguiente]) + 1 : 0;
+        };
+        grupos = ordenarGrupos(grupos, rangoSiguiente, arreglo_sufijos, rango, pool);
+    }
+    return arreglo_sufijos;
+}
+
+// ========== Transformada ==========
+
+TransformadaBWT transformadaDesdeArreglo(const std::string& texto, vc arreglo_sufijos, PoolTrabajo* pool) {
+    TRAZAR_FASE("bwt");
+    TransformadaBWT transformada;
+    transformada.arreglo_sufijos = std::move(arreglo_sufijos);
+    size_t longitud = texto.size();
+    if (longitud == 0) return transformada;
+
+    const vc& sufijos = transformada.arreglo_sufijos;
+    size_t tramos = cantidadTramos(longitud, pool);
+
+    // El sufijo 0 no tiene carácter anterior: en su fila va el centinela
+    std::vector<size_t> fila_por_tramo(tramos, 0);
+    paraCadaTramo(longitud, tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            if (sufijos[i] == 0) fila_por_tramo[tramo] = i + 1;
+        }
+    });
+    for (size_t fila : fila_por_tramo) transformada.fila_centinela = std::max(transformada.fila_centinela, fila);
+
+    // Fila 0: el sufijo "$", precedido por el último carácter del texto; las filas
+    // posteriores a la del centinela se desplazan una posición en la BWT
+    transformada.bwt.resize(longitud);
+    transformada.bwt[0] = texto.back();
+    paraCadaTramo(longitud, tramos, pool, [&](size_t, size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; ++i) {
+            size_t fila = i + 1;
+            if (fila == transformada.fila_centinela) continue;
+            transformada.bwt[fila > transformada.fila_centinela ? fila - 1 : fila] = texto[sufijos[i] - 1];
+        }
+    });
+    return transformada;
+}
+
+TransformadaBWT construirTransformadaBWT(const std::string& texto, PoolTrabajo* pool) {
+    if (texto.size() >= static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::length_error("El texto excede el tamaño máximo de la BWT");
+    }
+    return transformadaDesdeArreglo(texto, construirArregloSufijos(texto, pool), pool);
+}
+
+std::vector<uint64_t> construirTablaInicioCaracter(std::string_view bwt, PoolTrabajo* pool) {
+    TRAZAR_FASE("tabla_c");
+    size_t tramos = cantidadTramos(bwt.size(), pool);
+    std::vector<std::array<uint64_t, 256>> conteos_por_tramo(tramos);
+    paraCadaTramo(bwt.size(), tramos, pool, [&](size_t tramo, size_t inicio, size_t fin) {
+        conteos_por_tramo[tramo].fill(0);
+        for (size_t i = inicio; i < fin; ++i) conteos_por_tramo[tramo][static_cast<unsigned char>(bwt[i])]++;
+    });
+
+    std::vector<uint64_t> tabla_inicio_caracter(257, 0);
+    for (const auto& conteos : conteos_por_tramo) {
+        rep(c, 256) tabla_inicio_caracter[c + 1] += conteos[c];
+    }
+
+    // Suma acumulada: C[c] = 1 + cantidad de caracteres menores que c
+    tabla_inicio_caracter[0] = 1;
+    for (size_t c = 1; c < tabla_inicio_caracter.size(); ++c) {
+        tabla_inicio_caracter[c] += tabla_inicio_caracter[c - 1];
+    }
+    return tabla_inicio_caracter;
+}
+
+size_t contarRunsBWT(const TransformadaBWT& transformada) {
+    size_t cantidad_filas = transformada.longitud() + 1;
+    size_t runs = 1;
+    for (size_t fila = 1; fila < cantidad_filas; ++fila) {
+        bool cambia = transformada.esCentinela(fila) || transformada.esCentinela(fila - 1)
+                   || transformada.caracterDeFila(fila) != transformada.caracterDeFila(fila - 1);
+        if (cambia) runs++;
+    }
+    return runs;
+}
@@ -0,0 +1,49 @@
+#include "../include/definiciones.hpp"
+#include "../include/traza.hpp"
+
+#include <atomic>
+#include <chrono>
+
+static const std::chrono::steady_clock::time_point INICIO_TRAZA = std::chrono::steady_clock::now();
+
+static thread_local RegistroTraza* registro_activo = nullptr;
+
+/**
+ * @brief Número del hilo actual en los eventos, asignado al medir su primera fase.
+ */
+static uint32_t numeroHilo() {
+    static std::atomic<uint32_t> siguiente{0};
+    static thread_local uint32_t numero = siguiente++;
+    return numero;
+}
+
+uint64_t nanosegundosTraza() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - INICIO_TRAZA).count());
+}
+
+RegistroTraza::RegistroTraza() : anterior_(registro_activo) {
+    registro_activo = this;
+}
+
+RegistroTraza::~RegistroTraza() {
+    registro_activo = anterior_;
+}
+
+RegistroTraza* RegistroTraza::activo() {
+    return registro_activo;
+}
+
+FaseTraza::FaseTraza(const char* nombre) : registro_(registro_activo) {
+    if (!registro_) return;
+
+    evento_ = registro_->eventos_.size();
+    registro_->eventos_.push_back({nombre, nanosegundosTraza(), 0, registro_->abiertas_++, numeroHilo()});
+}
+
+FaseTraza::~FaseTraza() {
+    if (!registro_) return;
+
+    registro_->eventos_[evento_].fin_ns = nanosegundosTraza();
+    registro_->abiertas_--;
+}
@@ -0,0 +1,101 @@
+#include "../include/definiciones.hpp"
+#include "../include/two_way.hpp"
+
+#include <cstring>
+
+unsigned int TwoWay::buscar(const std::string& texto, const std::string& patron) {
+    return buscarVista(texto, patron);
+}
+
+unsigned int TwoWay::buscarEnSegmento(std::string_view segmento, const std::string& patron) {
+    return buscarVista(segmento, patron);
+}
+
+long long TwoWay::sufijoMaximo(std::string_view patron, bool inverso, size_t& periodo) {
+    long long largo = static_cast<long long>(patron.size());
+    long long sufijo = -1, j = 0, k = 1;
+    periodo = 1;
+
+    while (j + k < largo) {
+        unsigned char a = static_cast<unsigned char>(patron[j + k]);
+        unsigned char b = static_cast<unsigned char>(patron[sufijo + k]);
+        if (inverso) std::swap(a, b);
+
+        if (a < b) {
+            // El sufijo candidato es menor: todo lo leído pertenece al período
+            j += k;
+            k = 1;
+            periodo = static_cast<size_t>(j - sufijo);
+        } else if (a == b) {
+            if (static_cast<size_t>(k) != periodo) k++;
+            else {
+                j += static_cast<long long>(periodo);
+                k = 1;
+            }
+        } else {
+            // Sufijo mayor: comienza uno nuevo en j
+            sufijo = j;
+            j = sufijo + 1;
+            k = 1;
+            periodo = 1;
+        }
+    }
+    return sufijo;
+}
+
+unsigned int TwoWay::buscarVista(std::string_view texto, std::string_view patron) {
+    long long largo_patron = static_cast<long long>(patron.size());
+    long long largo_texto = static_cast<long long>(texto.size());
+    if (largo_patron == 0 || largo_texto < largo_patron) return 0;
+
+    // Factorización crítica: patron = patron[0..corte] patron[corte+1..m-1]
+    size_t periodo_directo, periodo_inverso;
+    long long sufijo_directo = sufijoMaximo(patron, false, periodo_directo);
+    long long sufijo_inverso = sufijoMaximo(patron, true, periodo_inverso);
+    long long corte = std::max(sufijo_directo, sufijo_inverso);
+    long long periodo = static_cast<long long>(sufijo_directo > sufijo_inverso ? periodo_directo : periodo_inverso);
+
+    auto coincide = [&](long long i, long long j) { return patron[i] == texto[i + j]; };
+    unsigned int ocurrencias = 0;
+    long long j = 0;
+
+    // u es sufijo de v^k si patron[0..corte] = patron[periodo..periodo+corte];
+    // el período no excede |v|, así que la comparación no sale del patrón
+    if (std::memcmp(patron.data(), patron.data() + periodo, static_cast<size_t>(corte + 1)) == 0) {
+        // Patrón periódico: 'memoria' es el prefijo ya verificado de la ventana actual
+        long long memoria = -1;
+        while (j <= largo_texto - largo_patron) {
+            long long i = std::max(corte, memoria) + 1;
+            while (i < largo_patron && coincide(i, j)) i++;
+
+            if (i >= largo_patron) {
+                i = corte;
+                while (i > memoria && coincide(i, j)) i--;
+                if (i <= memoria) ocurrencias++;
+                j += periodo;
+                memoria = largo_patron - periodo - 1;
+            } else {
+                j += i - corte;
+                memoria = -1;
+            }
+        }
+    } else {
+        // Patrón no periódico: dos ocurrencias distan al menos max(|u|, |v|) + 1
+        long long salto = std::max(corte + 1, largo_patron - corte - 1) + 1;
+        while (j <= largo_texto - largo_patron) {
+            long long i = corte + 1;
+            while (i < largo_patron && coincide(i, j)) i++;
+
+            if (i >= largo_patron) {
+                i = corte;
+                while (i >= 0 && coincide(i, j)) i--;
+                if (i < 0) ocurrencias++;
+                j += salto;
+            } else {
+                j += i - corte;
+            }
+        }
+    }
+
+    return ocurrencias;
+}
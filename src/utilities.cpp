@@ -65,18 +65,20 @@ void solicitarPatron(std::string& patron) {
     }
 }
 
-void input(std::string& texto, std::string& patron) {    
-    fs::path nombre_archivo = solicitarArchivo();
-    
+std::string leerArchivo(const std::string& ruta) {
     // Abrir el archivo para extraer el contenido
-    std::ifstream archivo(nombre_archivo, std::ios::in);
+    std::ifstream archivo(ruta, std::ios::in);
     if (!archivo.is_open()) {
-        throw std::ios_base::failure("No se pudo abrir el archivo: " + nombre_archivo.string());
+        throw std::ios_base::failure("No se pudo abrir el archivo: " + ruta);
     }
 
     std::stringstream buffer;
     buffer << archivo.rdbuf();
-    texto = buffer.str();
+    return buffer.str();
+}
 
+void input(std::string& texto, std::string& patron) {    
+    fs::path nombre_archivo = solicitarArchivo();
+    texto = leerArchivo(nombre_archivo.string());
     solicitarPatron(patron);
 }
@@ -0,0 +1,258 @@
+#include "../include/definiciones.hpp"
+#include "../include/wavelet_matrix.hpp"
+#include "../include/traza.hpp"
+
+#include <queue>
+
+WaveletMatrix::WaveletMatrix(std::string_view texto) {
+    TRAZAR_FASE("wavelet");
+    // Códigos compactos para los caracteres presentes
+    std::vector<uint16_t> codigos(256, SIN_CODIGO);
+    for (char caracter : texto) codigos[static_cast<unsigned char>(caracter)] = 0;
+
+    std::vector<unsigned char> caracteres;
+    for (size_t c = 0; c < codigos.size(); ++c) {
+        if (codigos[c] == SIN_CODIGO) continue;
+        codigos[c] = static_cast<uint16_t>(caracteres.size());
+        caracteres.push_back(static_cast<unsigned char>(c));
+    }
+
+    uint32_t maximo = caracteres.empty() ? 0 : static_cast<uint32_t>(caracteres.size() - 1);
+    longitud_ = texto.size();
+    cantidad_niveles_ = 1;
+    while ((maximo >> cantidad_niveles_) != 0) cantidad_niveles_++;
+
+    // El orden de un nivel es el orden estable del texto por los bits ya
+    // consumidos, leídos con el del nivel anterior como más significativo:
+    // cada nivel es un counting sort sobre los bytes originales.
+    std::vector<uint64_t> ceros(cantidad_niveles_, 0);
+    for (uint32_t nivel = 0; nivel < cantidad_niveles_; ++nivel) {
+        uint32_t desplazamiento = cantidad_niveles_ - 1 - nivel;
+        std::vector<uint32_t> grupo_de_byte(256, 0);
+        std::vector<uint8_t> bit_de_byte(256, 0);
+        for (size_t c = 0; c < codigos.size(); ++c) {
+            if (codigos[c] == SIN_CODIGO) continue;
+            uint32_t codigo = codigos[c];
+            rep(j, nivel) grupo_de_byte[c] |= ((codigo >> (cantidad_niveles_ - 1 - j)) & 1U) << j;
+            bit_de_byte[c] = static_cast<uint8_t>((codigo >> desplazamiento) & 1U);
+        }
+
+        std::vector<size_t> posicion_grupo(size_t(1) << nivel, 0);
+        for (char caracter : texto) posicion_grupo[grupo_de_byte[static_cast<unsigned char>(caracter)]]++;
+        size_t acumulado = 0;
+        for (size_t& posicion : posicion_grupo) {
+            size_t cantidad = posicion;
+            posicion = acumulado;
+            acumulado += cantidad;
+        }
+
+        VectorAlineado<uint64_t> palabras(longitud_ / 64 + 1, 0);
+        for (char caracter : texto) {
+            unsigned char byte = static_cast<unsigned char>(caracter);
+            size_t i = posicion_grupo[grupo_de_byte[byte]]++;
+            if (bit_de_byte[byte]) palabras[i / 64] |= 1ULL << (i % 64);
+            else ceros[nivel]++;
+        }
+        niveles_.emplace_back(std::move(palabras), longitud_);
+    }
+
+    ceros_ = ArregloPlano<uint64_t>(std::move(ceros));
+    codigos_ = ArregloPlano<uint16_t>(std::move(codigos));
+    caracteres_ = ArregloPlano<unsigned char>(std::move(caracteres));
+}
+
+WaveletMatrix::WaveletMatrix(const std::vector<uint32_t>& secuencia) {
+    TRAZAR_FASE("wavelet");
+    uint32_t maximo = secuencia.empty() ? 0 : *std::max_element(secuencia.begin(), secuencia.end());
+    construirNiveles(secuencia, maximo);
+}
+
+void WaveletMatrix::construirNiveles(std::vector<uint32_t> secuencia, uint32_t maximo) {
+    longitud_ = secuencia.size();
+    cantidad_niveles_ = 1;
+    while (cantidad_niveles_ < 32 && (maximo >> cantidad_niveles_) != 0) cantidad_niveles_++;
+
+    std::vector<uint64_t> ceros(cantidad_niveles_, 0);
+    std::vector<uint32_t> con_cero, con_uno;
+    con_cero.reserve(longitud_);
+    con_uno.reserve(longitud_);
+
+    for (uint32_t nivel = 0; nivel < cantidad_niveles_; ++nivel) {
+        uint32_t desplazamiento = cantidad_niveles_ - 1 - nivel;
+        VectorAlineado<uint64_t> palabras(longitud_ / 64 + 1, 0);
+
+        con_cero.clear();
+        con_uno.clear();
+        for (size_t i = 0; i < longitud_; ++i) {
+            if ((secuencia[i] >> desplazamiento) & 1U) {
+                palabras[i / 64] |= 1ULL << (i % 64);
+                con_uno.push_back(secuencia[i]);
+            } else {
+                con_cero.push_back(secuencia[i]);
+            }
+        }
+
+        ceros[nivel] = con_cero.size();
+        niveles_.emplace_back(std::move(palabras), longitud_);
+
+        // Reordenamiento estable: primero los ceros, luego los unos
+        std::copy(con_cero.begin(), con_cero.end(), secuencia.begin());
+        std::copy(con_uno.begin(), con_uno.end(), secuencia.begin() + con_cero.size());
+    }
+
+    ceros_ = ArregloPlano<uint64_t>(std::move(ceros));
+}
+
+size_t WaveletMatrix::rango(unsigned char caracter, size_t i) const {
+    uint16_t codigo = codigos_[caracter];
+    return codigo == SIN_CODIGO ? 0 : rangoCodigo(codigo, i);
+}
+
+unsigned char WaveletMatrix::acceder(size_t i) const {
+    return caracteres_[accederCodigo(i)];
+}
+
+size_t WaveletMatrix::rangoCodigo(uint32_t codigo, size_t i) const {
+    if (cantidad_niveles_ < 32 && (codigo >> cantidad_niveles_) != 0) return 0;
+
+    size_t inicio = 0, fin = i;
+    for (uint32_t nivel = 0; nivel < cantidad_niveles_; ++nivel) {
+        const BitVector& bits = niveles_[nivel];
+        if ((codigo >> (cantidad_niveles_ - 1 - nivel)) & 1U) {
+            inicio = ceros_[nivel] + bits.rango1(inicio);
+            fin = ceros_[nivel] + bits.rango1(fin);
+        } else {
+            inicio = bits.rango0(inicio);
+            fin = bits.rango0(fin);
+        }
+    }
+    return fin - inicio;
+}
+
+uint32_t WaveletMatrix::accederCodigo(size_t i) const {
+    uint32_t codigo = 0;
+    for (uint32_t nivel = 0; nivel < cantidad_niveles_; ++nivel) {
+        const BitVector& bits = niveles_[nivel];
+        codigo <<= 1;
+        if (bits.acceder(i)) {
+            codigo |= 1U;
+            i = ceros_[nivel] + bits.rango1(i);
+        } else {
+            i = bits.rango0(i);
+        }
+    }
+    return codigo;
+}
+
+std::vector<std::pair<uint32_t, size_t>> WaveletMatrix::frecuenciasEnRango(size_t inicio, size_t fin) const {
+    std::vector<std::pair<uint32_t, size_t>> frecuencias;
+    if (inicio < fin) recorrerRango(0, inicio, fin, 0, frecuencias);
+    return frecuencias;
+}
+
+void WaveletMatrix::recorrerRango(uint32_t nivel, size_t inicio, size_t fin, uint32_t codigo,
+                                  std::vector<std::pair<uint32_t, size_t>>& frecuencias) const {
+    if (nivel == cantidad_niveles_) {
+        frecuencias.emplace_back(codigo, fin - inicio);
+        return;
+    }
+
+    const BitVector& bits = niveles_[nivel];
+    size_t unos_antes = bits.rango1(inicio);
+    size_t unos_hasta = bits.rango1(fin);
+
+    // Los ceros van primero: así los códigos salen en orden creciente
+    size_t inicio_cero = inicio - unos_antes, fin_cero = fin - unos_hasta;
+    if (inicio_cero < fin_cero) recorrerRango(nivel + 1, inicio_cero, fin_cero, codigo << 1, frecuencias);
+    if (unos_antes < unos_hasta) {
+        recorrerRango(nivel + 1, ceros_[nivel] + unos_antes, ceros_[nivel] + unos_hasta, (codigo << 1) | 1U, frecuencias);
+    }
+}
+
+std::vector<std::pair<uint32_t, size_t>> WaveletMatrix::masFrecuentesEnRango(size_t inicio, size_t fin, size_t k) const {
+    struct Nodo {
+        size_t inicio;
+        size_t fin;
+        uint32_t nivel;
+        uint32_t codigo;
+
+        uint64_t menor;     // Menor código de las hojas del nodo
+
+        // Mayor rango primero; a igual tamaño, el menor código y luego el nodo más profundo
+        bool operator<(const Nodo& otro) const {
+            if (fin - inicio != otro.fin - otro.inicio) return fin - inicio < otro.fin - otro.inicio;
+            if (menor != otro.menor) return menor > otro.menor;
+            return nivel < otro.nivel;
+        }
+    };
+    auto crearNodo = [&](size_t desde, size_t hasta, uint32_t nivel, uint32_t codigo) {
+        return Nodo{desde, hasta, nivel, codigo, static_cast<uint64_t>(codigo) << (cantidad_niveles_ - nivel)};
+    };
+
+    std::vector<std::pair<uint32_t, size_t>> frecuentes;
+    if (inicio >= fin || k == 0) return frecuentes;
+
+    std::priority_queue<Nodo> pendientes;
+    pendientes.push(crearNodo(inicio, fin, 0, 0));
+    while (!pendientes.empty() && frecuentes.size() < k) {
+        Nodo nodo = pendientes.top();
+        pendientes.pop();
+
+        if (nodo.nivel == cantidad_niveles_) {
+            frecuentes.emplace_back(nodo.codigo, nodo.fin - nodo.inicio);
+            continue;
+        }
+
+        const BitVector& bits = niveles_[nodo.nivel];
+        size_t unos_antes = bits.rango1(nodo.inicio);
+        size_t unos_hasta = bits.rango1(nodo.fin);
+        size_t inicio_cero = nodo.inicio - unos_antes, fin_cero = nodo.fin - unos_hasta;
+
+        if (inicio_cero < fin_cero) pendientes.push(crearNodo(inicio_cero, fin_cero, nodo.nivel + 1, nodo.codigo << 1));
+        if (unos_antes < unos_hasta) {
+            pendientes.push(crearNodo(ceros_[nodo.nivel] + unos_antes, ceros_[nodo.nivel] + unos_hasta, nodo.nivel + 1, (nodo.codigo << 1) | 1U));
+        }
+    }
+    return frecuentes;
+}
+
+size_t WaveletMatrix::getMemoriaBytes() const {
+    size_t total = ceros_.getMemoriaBytes() + codigos_.getMemoriaBytes() + caracteres_.getMemoriaBytes();
+    for (const auto& nivel : niveles_) total += nivel.getMemoriaBytes();
+    return total;
+}
+
+void WaveletMatrix::serializar(EscritorBinario& escritor) const {
+    escritor.escribir(static_cast<uint64_t>(longitud_));
+    escritor.escribir(static_cast<uint64_t>(cantidad_niveles_));
+    escritor.escribirArreglo(ceros_);
+    escritor.escribirArreglo(codigos_);
+    escritor.escribirArreglo(caracteres_);
+    for (const auto& nivel : niveles_) nivel.serializar(escritor);
+}
+
+void WaveletMatrix::mapear(LectorMapeado& lector) {
+    uint64_t longitud = lector.leer<uint64_t>();
+    uint64_t cantidad_niveles = lector.leer<uint64_t>();
+    if (cantidad_niveles == 0 || cantidad_niveles > 32) {
+        throw std::runtime_error("Archivo de índice corrupto: cantidad de niveles inválida");
+    }
+
+    lector.mapearArreglo(ceros_);
+    lector.mapearArreglo(codigos_);
+    lector.mapearArreglo(caracteres_);
+
+    niveles_.assign(static_cast<size_t>(cantidad_niveles), BitVector());
+    for (auto& nivel : niveles_) {
+        nivel.mapear(lector);
+        if (nivel.size() != longitud) {
+            throw std::runtime_error("Archivo de índice corrupto: nivel de la wavelet matrix inconsistente");
+        }
+    }
+    if (ceros_.size() != cantidad_niveles) {
+        throw std::runtime_error("Archivo de índice corrupto: tabla de ceros inconsistente");
+    }
+
+    longitud_ = static_cast<size_t>(longitud);
+    cantidad_niveles_ = static_cast<uint32_t>(cantidad_niveles);
+}